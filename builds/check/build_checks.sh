@@ -1,7 +1,7 @@
 #!/bin/bash
 # Trevor SANDY
-# Last Update July 23, 2019
-# Copyright (c) 2018 - 2019 by Trevor SANDY
+# Last Update October 19, 2026
+# Copyright (c) 2018 - 2026 by Trevor SANDY
 # LPub3D Unix checks - for remote CI (Trevis, OBS)
 # NOTE: Source with variables as appropriate:
 #       $BUILD_OPT = compile
@@ -97,53 +97,60 @@ if [ -f "${LP3D_LOG_FILE}" ]; then
     rm -rf "${LP3D_LOG_FILE}"
 fi
 
-for LP3D_BUILD_CHECK in CHECK01 CHECK02 CHECK03 CHECK04 CHECK05 CHECK06 CHECK07; do
+for LP3D_BUILD_CHECK in CHECK01 CHECK02 CHECK03 CHECK04 CHECK05 CHECK06 CHECK07 CHECK08; do
     lp3d_check_start=$SECONDS
     case ${LP3D_BUILD_CHECK} in
     CHECK01)
         LP3D_CHECK_LBL="Native File Process"
-        LP3D_CHECK_HDR="- Check 1 of 7: ${LP3D_CHECK_LBL} Check..."
+        LP3D_CHECK_HDR="- Check 1 of 8: ${LP3D_CHECK_LBL} Check..."
         LP3D_CHECK_OPTIONS="--no-stdout-log --process-file --liblego --preferred-renderer native"
         LP3D_CHECK_STDLOG=
         ;;
     CHECK02)
         LP3D_CHECK_LBL="LDView File Process"
-        LP3D_CHECK_HDR="- Check 2 of 7: ${LP3D_CHECK_LBL} Check..."
+        LP3D_CHECK_HDR="- Check 2 of 8: ${LP3D_CHECK_LBL} Check..."
         LP3D_CHECK_OPTIONS="--no-stdout-log --process-file --clear-cache --liblego --preferred-renderer ldview"
         LP3D_CHECK_STDLOG="${LP3D_CHECK_STDLOG}/stdout-ldview"
         ;;
     CHECK03)
         LP3D_CHECK_LBL="LDView (Single Call) File Process"
-        LP3D_CHECK_HDR="- Check 3 of 7: ${LP3D_CHECK_LBL} Check..."
+        LP3D_CHECK_HDR="- Check 3 of 8: ${LP3D_CHECK_LBL} Check..."
         LP3D_CHECK_OPTIONS="--no-stdout-log --process-file --clear-cache --liblego --preferred-renderer ldview-sc"
         LP3D_CHECK_STDLOG="${LP3D_CHECK_STDLOG}/stdout-ldview"
         ;;
     CHECK04)
         LP3D_CHECK_LBL="LDGLite Export Range"
-        LP3D_CHECK_HDR="- Check 4 of 7: ${LP3D_CHECK_LBL} Check..."
+        LP3D_CHECK_HDR="- Check 4 of 8: ${LP3D_CHECK_LBL} Check..."
         LP3D_CHECK_OPTIONS="--no-stdout-log --process-export --range 1-3 --clear-cache --liblego --preferred-renderer ldglite"
         LP3D_CHECK_STDLOG="${LP3D_CHECK_STDLOG}/stderr-ldglite"
         ;;
     CHECK05)
         LP3D_CHECK_LBL="Native POV Generation"
-        LP3D_CHECK_HDR="- Check 5 of 7: ${LP3D_CHECK_LBL} Check..."
+        LP3D_CHECK_HDR="- Check 5 of 8: ${LP3D_CHECK_LBL} Check..."
         LP3D_CHECK_OPTIONS="--no-stdout-log --process-file --clear-cache --liblego --preferred-renderer povray"
         LP3D_CHECK_STDLOG="${LP3D_CHECK_STDLOG}/stderr-povray"
         ;;
     CHECK06)
         LP3D_CHECK_LBL="LDView TENTE Model"
-        LP3D_CHECK_HDR="- Check 6 of 7: ${LP3D_CHECK_LBL} Check..."
+        LP3D_CHECK_HDR="- Check 6 of 8: ${LP3D_CHECK_LBL} Check..."
         LP3D_CHECK_OPTIONS="--no-stdout-log --process-file --clear-cache --libtente --preferred-renderer ldview"
         LP3D_CHECK_FILE="$(realpath ${SOURCE_DIR})/builds/check/TENTE/astromovil.ldr"
         LP3D_CHECK_STDLOG="${LP3D_CHECK_STDLOG}/stdout-ldview"
         ;;
     CHECK07)
         LP3D_CHECK_LBL="LDView (Snapshot List) VEXIQ Model"
-        LP3D_CHECK_HDR="- Check 7 of 7: ${LP3D_CHECK_LBL} Check..."
+        LP3D_CHECK_HDR="- Check 7 of 8: ${LP3D_CHECK_LBL} Check..."
         LP3D_CHECK_OPTIONS="--no-stdout-log --process-file --clear-cache --libvexiq --preferred-renderer ldview-scsl"
         LP3D_CHECK_FILE="$(realpath ${SOURCE_DIR})/builds/check/VEXIQ/spider.mpd"
         LP3D_CHECK_STDLOG="${LP3D_CHECK_STDLOG}/stdout-ldview"
         ;;
+    CHECK08)
+        LP3D_CHECK_LBL="Page Build Benchmark"
+        LP3D_CHECK_HDR="- Check 8 of 8: ${LP3D_CHECK_LBL} Check..."
+        LP3D_CHECK_OPTIONS="--no-stdout-log --benchmark --benchmark-iterations 1 --benchmark-output $(realpath ${SOURCE_DIR})/builds/check/build_checks_benchmark.json --liblego"
+        LP3D_CHECK_FILE=
+        LP3D_CHECK_STDLOG=
+        ;;
       esac
 
     [ -n "$USE_XVFB" ] && xvfb-run --auto-servernum --server-num=1 --server-args="-screen 0 1024x768x24" \
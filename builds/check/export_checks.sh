@@ -0,0 +1,86 @@
+#!/bin/bash
+# Trevor SANDY
+# Last Update October 19, 2026
+# Copyright (c) 2026 by Trevor SANDY
+# LPub3D 3DViewer export golden-file checks
+# Exports the same model with a reference build and with the build under
+# test, then compares the Wavefront OBJ/MTL, COLLADA and POV-Ray files
+# byte for byte. Only the COLLADA <created> and <modified> time stamps
+# are left out of the comparison.
+# NOTE: Source with variables as appropriate:
+#       $REFERENCE_EXE = <LPub3D built from the commit before the exporter change>,
+#       $LPUB3D_EXE = <LPub3D built from this tree>,
+#       $SOURCE_DIR = <lpub3d source folder>
+#       $LP3D_EXPORT_CHECK_FILE = <model to export> (optional)
+# The POV-Ray check needs the -pov, --export-povray 3DViewer option in both
+# builds and is skipped when the reference build does not have it.
+
+if [[ -z "${REFERENCE_EXE}" || -z "${LPUB3D_EXE}" ]]; then
+    echo "ERROR - set REFERENCE_EXE and LPUB3D_EXE." && exit 1
+fi
+SOURCE_DIR=${SOURCE_DIR:-$(cd "$(dirname "$0")/../.." && pwd)}
+
+LP3D_CHECK_FILE="${LP3D_EXPORT_CHECK_FILE:-$(realpath ${SOURCE_DIR})/builds/check/build_checks.mpd}"
+LP3D_CHECK_DIR="$(mktemp -d)"
+LP3D_CHECK_BASE="$(basename "${LP3D_CHECK_FILE%.*}")"
+let LP3D_CHECK_PASS=0
+let LP3D_CHECK_FAIL=0
+
+LP3D_RUN=()
+if [[ "$(uname)" != "Darwin" && -z "${DISPLAY}" ]] && command -v xvfb-run > /dev/null; then
+    LP3D_RUN=(xvfb-run --auto-servernum "--server-args=-screen 0 1024x768x24")
+fi
+
+# Export args: 1 = <exe>, 2 = <output folder>, 3 = <option>, 4 = <extension>
+RunExport() {
+    mkdir -p "$2"
+    "${LP3D_RUN[@]}" "$1" "${LP3D_CHECK_FILE}" "$3" "$2/${LP3D_CHECK_BASE}.$4" &> "$2/${LP3D_CHECK_BASE}_$4.log"
+}
+
+# Compare args: 1 = <label>, 2.. = <file names>
+CompareExports() {
+    local label=$1 result=PASSED
+    shift
+    for file in "$@"; do
+        local ref="${LP3D_CHECK_DIR}/reference/${file}" new="${LP3D_CHECK_DIR}/new/${file}"
+        if [[ ! -s "${ref}" || ! -s "${new}" ]]; then
+            echo "  ${file}: missing or empty export" && result=FAILED && continue
+        fi
+        if ! cmp -s <(grep -v '<created>\|<modified>' "${ref}") <(grep -v '<created>\|<modified>' "${new}"); then
+            echo "  ${file}: differs from the reference export"
+            diff <(grep -v '<created>\|<modified>' "${ref}") <(grep -v '<created>\|<modified>' "${new}") | head -20
+            result=FAILED
+        else
+            echo "  ${file}: identical ($(wc -c < "${new}") bytes)"
+        fi
+    done
+    echo "- ${label} export check ${result}"
+    if [ "${result}" = "PASSED" ]; then
+        LP3D_CHECK_PASS=$((LP3D_CHECK_PASS + 1))
+    else
+        LP3D_CHECK_FAIL=$((LP3D_CHECK_FAIL + 1))
+    fi
+}
+
+echo && echo "------------Export Checks Start--------------" && echo
+echo "- Model: ${LP3D_CHECK_FILE}"
+echo "- Reference: ${REFERENCE_EXE}"
+echo "- Under test: ${LPUB3D_EXE}"
+echo
+
+for LP3D_EXPORT in obj dae pov; do
+    case ${LP3D_EXPORT} in
+    obj) LP3D_LBL="Wavefront"; LP3D_OPTION="--export-wavefront"; LP3D_FILES="${LP3D_CHECK_BASE}.obj ${LP3D_CHECK_BASE}.mtl" ;;
+    dae) LP3D_LBL="COLLADA";   LP3D_OPTION="--export-collada";   LP3D_FILES="${LP3D_CHECK_BASE}.dae" ;;
+    pov) LP3D_LBL="POV-Ray";   LP3D_OPTION="--export-povray";    LP3D_FILES="${LP3D_CHECK_BASE}.pov" ;;
+    esac
+    if [[ "${LP3D_EXPORT}" = "pov" ]] && ! "${REFERENCE_EXE}" --help 2>&1 | grep -q -- "--export-povray"; then
+        echo "- ${LP3D_LBL} export check SKIPPED, the reference build has no ${LP3D_OPTION} option" && continue
+    fi
+    RunExport "${REFERENCE_EXE}" "${LP3D_CHECK_DIR}/reference" "${LP3D_OPTION}" "${LP3D_EXPORT}"
+    RunExport "${LPUB3D_EXE}" "${LP3D_CHECK_DIR}/new" "${LP3D_OPTION}" "${LP3D_EXPORT}"
+    CompareExports "${LP3D_LBL}" ${LP3D_FILES}
+done
+
+echo && echo "----Export Check Completed: PASS (${LP3D_CHECK_PASS}), FAIL (${LP3D_CHECK_FAIL}), files in ${LP3D_CHECK_DIR}----" && echo
+[ "${LP3D_CHECK_FAIL}" -eq 0 ]
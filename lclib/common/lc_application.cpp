@@ -270,6 +270,8 @@ int lcApplication::Process3DViewerCommandLine()
 	  bool SaveWavefront = false;
 	  bool Save3DS = false;
 	  bool SaveCOLLADA = false;
+	  bool SaveGLTF = false;
+	  bool SavePOVRay = false;
 	  bool SaveHTML = false;
 	  bool SetCameraAngles = false;
 	  bool Orthographic = false;
@@ -290,6 +292,8 @@ int lcApplication::Process3DViewerCommandLine()
 	  QString SaveWavefrontName;
 	  QString Save3DSName;
 	  QString SaveCOLLADAName;
+	  QString SaveGLTFName;
+	  QString SavePOVRayName;
 	  QString SaveHTMLName;
 
 	  QStringList Arguments = Application::instance()->arguments();
@@ -435,6 +439,16 @@ int lcApplication::Process3DViewerCommandLine()
 			  SaveCOLLADA = true;
 			  ParseString(SaveCOLLADAName, false);
 		  }
+		  else if (Param == QLatin1String("-glb") || Param == QLatin1String("--export-gltf"))
+		  {
+			  SaveGLTF = true;
+			  ParseString(SaveGLTFName, false);
+		  }
+		  else if (Param == QLatin1String("-pov") || Param == QLatin1String("--export-povray"))
+		  {
+			  SavePOVRay = true;
+			  ParseString(SavePOVRayName, false);
+		  }
 		  else if (Param == QLatin1String("-html") || Param == QLatin1String("--export-html"))
 		  {
 			  SaveHTML = true;
@@ -614,6 +628,54 @@ int lcApplication::Process3DViewerCommandLine()
 			  mProject->ExportCOLLADA(FileName);
 		  }
 
+		  if (SaveGLTF)
+		  {
+			  QString FileName;
+
+			  if (!SaveGLTFName.isEmpty())
+				  FileName = SaveGLTFName;
+			  else
+				  FileName = ProjectName;
+
+			  QString Extension = QFileInfo(FileName).suffix().toLower();
+
+			  if (Extension.isEmpty())
+			  {
+				  FileName += ".glb";
+			  }
+			  else if (Extension != "glb")
+			  {
+				  FileName = FileName.left(FileName.length() - Extension.length() - 1);
+				  FileName += ".glb";
+			  }
+
+			  mProject->ExportGLTF(FileName);
+		  }
+
+		  if (SavePOVRay)
+		  {
+			  QString FileName;
+
+			  if (!SavePOVRayName.isEmpty())
+				  FileName = SavePOVRayName;
+			  else
+				  FileName = ProjectName;
+
+			  QString Extension = QFileInfo(FileName).suffix().toLower();
+
+			  if (Extension.isEmpty())
+			  {
+				  FileName += ".pov";
+			  }
+			  else if (Extension != "pov")
+			  {
+				  FileName = FileName.left(FileName.length() - Extension.length() - 1);
+				  FileName += ".pov";
+			  }
+
+			  mProject->ExportPOVRay(FileName);
+		  }
+
 		  if (SaveHTML)
 		  {
 			  lcHTMLExportOptions Options(mProject);
@@ -631,7 +693,7 @@ int lcApplication::Process3DViewerCommandLine()
 		  }
 	  }
 
-	  if (!SaveImage && !SaveWavefront && !Save3DS && !SaveCOLLADA && !SaveHTML)
+	  if (!SaveImage && !SaveWavefront && !Save3DS && !SaveCOLLADA && !SaveGLTF && !SavePOVRay && !SaveHTML)
 		return 0;
 
 	  return 1;
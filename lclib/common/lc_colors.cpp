@@ -9,6 +9,39 @@ int gNumUserColors;
 int gEdgeColor;
 int gDefaultColor;
 
+/*** LPub3D Mod - colour index table ***/
+// Colour codes below LC_COLOR_CODE_TABLE_SIZE, which covers the LDraw code
+// range, index gColorCodeTable directly; direct colours and other codes use
+// gColorCodeHash. Table entries hold the colour index plus one so a zero
+// entry means the code is not in gColorList.
+#define LC_COLOR_CODE_TABLE_SIZE 1024
+
+static int gColorCodeTable[LC_COLOR_CODE_TABLE_SIZE];
+static QHash<quint32, int> gColorCodeHash;
+
+static int lcFindColorIndex(quint32 ColorCode)
+{
+	if (ColorCode < LC_COLOR_CODE_TABLE_SIZE)
+		return gColorCodeTable[ColorCode] - 1;
+
+	return gColorCodeHash.value(ColorCode, -1);
+}
+
+static void lcAddColorIndex(quint32 ColorCode, int ColorIndex)
+{
+	if (ColorCode < LC_COLOR_CODE_TABLE_SIZE)
+		gColorCodeTable[ColorCode] = ColorIndex + 1;
+	else
+		gColorCodeHash.insert(ColorCode, ColorIndex);
+}
+
+static void lcClearColorIndices()
+{
+	memset(gColorCodeTable, 0, sizeof(gColorCodeTable));
+	gColorCodeHash.clear();
+}
+/*** LPub3D Mod end ***/
+
 lcVector4 gInterfaceColors[LC_NUM_INTERFACECOLORS] = // todo: make the colors configurable and include the grid and other hardcoded colors here as well.
 {
 	lcVector4(0.898f, 0.298f, 0.400f, 1.000f), // LC_COLOR_SELECTED
@@ -188,6 +221,9 @@ bool lcLoadColorFile(lcFile& File)
 	lcColor Color, MainColor, EdgeColor;
 
 	Colors.clear();
+/*** LPub3D Mod - colour index table ***/
+	lcClearColorIndices();
+/*** LPub3D Mod end ***/
 
 	for (int GroupIdx = 0; GroupIdx < LC_NUM_COLORGROUPS; GroupIdx++)
 		gColorGroups[GroupIdx].Colors.clear();
@@ -348,20 +384,15 @@ bool lcLoadColorFile(lcFile& File)
 			Color.Edge[2] = 33.0f / 255.0f;
 		}
 
-		bool Duplicate = false;
+/*** LPub3D Mod - colour index table ***/
+		const int ExistingColor = lcFindColorIndex(Color.Code);
 
-		for (lcColor& ExistingColor : Colors)
+		if (ExistingColor != -1)
 		{
-			if (ExistingColor.Code == Color.Code)
-			{
-				ExistingColor = Color;
-				Duplicate = true;
-				break;
-			}
-		}
-
-		if (Duplicate)
+			Colors[ExistingColor] = Color;
 			continue;
+		}
+/*** LPub3D Mod end ***/
 
 		if (Color.Code == 16)
 		{
@@ -376,6 +407,9 @@ bool lcLoadColorFile(lcFile& File)
 		}
 
 		Colors.push_back(Color);
+/*** LPub3D Mod - colour index table ***/
+		lcAddColorIndex(Color.Code, (int)Colors.size() - 1);
+/*** LPub3D Mod end ***/
 
 		if (GroupSpecial)
 			gColorGroups[LC_COLORGROUP_SPECIAL].Colors.push_back((int)Colors.size() - 1);
@@ -393,6 +427,10 @@ bool lcLoadColorFile(lcFile& File)
 
 	gEdgeColor = (int)Colors.size();
 	Colors.push_back(EdgeColor);
+/*** LPub3D Mod - colour index table ***/
+	lcAddColorIndex(MainColor.Code, gDefaultColor);
+	lcAddColorIndex(EdgeColor.Code, gEdgeColor);
+/*** LPub3D Mod end ***/
 
 	return Colors.size() > 2;
 }
@@ -510,22 +548,16 @@ bool lcLoadColorEntry(const char* ColorEntry)
 		Color.Edge[2] = 33.0f / 255.0f;
 	}
 
-	bool Duplicate = false;
+	const int ExistingColor = lcFindColorIndex(Color.Code);
 
-	for (lcColor& ExistingColor : Colors)
+	if (ExistingColor != -1)
 	{
-		if (ExistingColor.Code == Color.Code)
-		{
-			ExistingColor = Color;
-			Duplicate = true;
-			break;
-		}
-	}
-
-	if (Duplicate)
+		Colors[ExistingColor] = Color;
 		return true;
+	}
 
 	Colors.push_back(Color);
+	lcAddColorIndex(Color.Code, (int)Colors.size() - 1);
 
 	gColorGroups[LC_COLORGROUP_LPUB3D].Colors.push_back((int)Colors.size() - 1);
 
@@ -561,9 +593,12 @@ void lcLoadDefaultColors()
 
 int lcGetColorIndex(quint32 ColorCode)
 {
-	for (size_t ColorIdx = 0; ColorIdx < gColorList.size(); ColorIdx++)
-		if (gColorList[ColorIdx].Code == ColorCode)
-			return (int)ColorIdx;
+/*** LPub3D Mod - colour index table ***/
+	const int ExistingColor = lcFindColorIndex(ColorCode);
+
+	if (ExistingColor != -1)
+		return ExistingColor;
+/*** LPub3D Mod end ***/
 
 	lcColor Color;
 
@@ -594,5 +629,8 @@ int lcGetColorIndex(quint32 ColorCode)
 	}
 
 	gColorList.push_back(Color);
+/*** LPub3D Mod - colour index table ***/
+	lcAddColorIndex(ColorCode, (int)gColorList.size() - 1);
+/*** LPub3D Mod end ***/
 	return (int)gColorList.size() - 1;
 }
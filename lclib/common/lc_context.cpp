@@ -46,6 +46,19 @@ lcContext::lcContext()
 
 	mFramebufferObject = 0;
 
+/*** LPub3D Mod - pipelined readback ***/
+	for (lcRenderReadback& Readback : mRenderReadbacks)
+	{
+		Readback.BufferObject = 0;
+		Readback.BufferSize = 0;
+		Readback.Width = 0;
+		Readback.Height = 0;
+	}
+
+	mRenderReadbackFirst = 0;
+	mRenderReadbackCount = 0;
+/*** LPub3D Mod end ***/
+
 	mColor = lcVector4(0.0f, 0.0f, 0.0f, 0.0f);
 	mWorldMatrix = lcMatrix44Identity();
 	mViewMatrix = lcMatrix44Identity();
@@ -759,6 +772,138 @@ void lcContext::GetRenderFramebufferImage(const std::pair<lcFramebuffer, lcFrame
 	}
 }
 
+/*** LPub3D Mod - pipelined readback ***/
+/*
+ * Double-buffered readback of the render framebuffer. With pixel buffer
+ * objects glReadPixels only queues the copy into the next free buffer and
+ * returns, and the buffer is mapped when the image is taken, by which time
+ * the caller has usually drawn the next frame. Without them, including
+ * OpenGL ES, the pixels are read synchronously when the readback begins.
+ * Up to LC_RENDER_READBACKS readbacks can be queued.
+ */
+bool lcContext::BeginRenderFramebufferReadback(const std::pair<lcFramebuffer, lcFramebuffer>& RenderFramebuffer)
+{
+	if (mRenderReadbackCount == LC_RENDER_READBACKS)
+		return false;
+
+	lcRenderReadback& Readback = mRenderReadbacks[(mRenderReadbackFirst + mRenderReadbackCount) % LC_RENDER_READBACKS];
+	const int Width = RenderFramebuffer.first.mWidth;
+	const int Height = RenderFramebuffer.first.mHeight;
+
+	Readback.Width = Width;
+	Readback.Height = Height;
+	mRenderReadbackCount++;
+
+#ifndef LC_OPENGLES
+	if (gSupportsPixelBufferObject)
+	{
+		const int BufferSize = Width * Height * 4;
+
+		if (!Readback.BufferObject)
+			glGenBuffers(1, &Readback.BufferObject);
+
+		glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, Readback.BufferObject);
+
+		if (Readback.BufferSize != BufferSize)
+		{
+			glBufferData(GL_PIXEL_PACK_BUFFER_ARB, BufferSize, nullptr, GL_STREAM_READ_ARB);
+			Readback.BufferSize = BufferSize;
+		}
+
+		GLuint SavedFramebuffer = mFramebufferObject;
+
+		if (RenderFramebuffer.second.IsValid())
+		{
+			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, RenderFramebuffer.second.mObject);
+			glBindFramebuffer(GL_READ_FRAMEBUFFER, RenderFramebuffer.first.mObject);
+			glBlitFramebuffer(0, 0, Width, Height, 0, 0, Width, Height, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+			BindFramebuffer(RenderFramebuffer.second);
+		}
+		else
+			BindFramebuffer(RenderFramebuffer.first);
+
+		glReadPixels(0, 0, Width, Height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		BindFramebuffer(SavedFramebuffer);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, 0);
+
+		return true;
+	}
+#endif
+
+	Readback.Image = GetRenderFramebufferImage(RenderFramebuffer);
+
+	return true;
+}
+
+QImage lcContext::EndRenderFramebufferReadback()
+{
+	if (!mRenderReadbackCount)
+		return QImage();
+
+	lcRenderReadback& Readback = mRenderReadbacks[mRenderReadbackFirst];
+	mRenderReadbackFirst = (mRenderReadbackFirst + 1) % LC_RENDER_READBACKS;
+	mRenderReadbackCount--;
+
+#ifndef LC_OPENGLES
+	if (gSupportsPixelBufferObject)
+	{
+		const int Width = Readback.Width;
+		const int Height = Readback.Height;
+		QImage Image(Width, Height, QImage::Format_ARGB32);
+
+		glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, Readback.BufferObject);
+		const quint8* Buffer = (const quint8*)glMapBuffer(GL_PIXEL_PACK_BUFFER_ARB, GL_READ_ONLY_ARB);
+
+		if (Buffer)
+		{
+			for (int y = 0; y < Height; y++)
+			{
+				const quint8* Source = Buffer + (Height - y - 1) * Width * 4;
+				QRgb* Destination = (QRgb*)Image.scanLine(y);
+
+				for (int x = 0; x < Width; x++)
+				{
+					Destination[x] = qRgba(Source[0], Source[1], Source[2], Source[3]);
+					Source += 4;
+				}
+			}
+
+			glUnmapBuffer(GL_PIXEL_PACK_BUFFER_ARB);
+		}
+		else
+			Image = QImage();
+
+		glBindBuffer(GL_PIXEL_PACK_BUFFER_ARB, 0);
+
+		return Image;
+	}
+#endif
+
+	QImage Image = Readback.Image;
+	Readback.Image = QImage();
+
+	return Image;
+}
+
+void lcContext::DestroyRenderFramebufferReadbacks()
+{
+	for (lcRenderReadback& Readback : mRenderReadbacks)
+	{
+#ifndef LC_OPENGLES
+		if (Readback.BufferObject)
+			glDeleteBuffers(1, &Readback.BufferObject);
+#endif
+
+		Readback.BufferObject = 0;
+		Readback.BufferSize = 0;
+		Readback.Image = QImage();
+	}
+
+	mRenderReadbackFirst = 0;
+	mRenderReadbackCount = 0;
+}
+/*** LPub3D Mod end ***/
+
 lcVertexBuffer lcContext::CreateVertexBuffer(int Size, const void* Data)
 {
 	lcVertexBuffer VertexBuffer;
@@ -111,6 +111,10 @@ enum lcPolygonOffset
 ***/
 /*** LPub3D Mod end ***/
 
+/*** LPub3D Mod - pipelined readback ***/
+#define LC_RENDER_READBACKS 2
+/*** LPub3D Mod end ***/
+
 class lcContext
 {
 public:
@@ -199,6 +203,11 @@ public:
 	void DestroyRenderFramebuffer(std::pair<lcFramebuffer, lcFramebuffer>& RenderFramebuffer);
 	QImage GetRenderFramebufferImage(const std::pair<lcFramebuffer, lcFramebuffer>& RenderFramebuffer);
 	void GetRenderFramebufferImage(const std::pair<lcFramebuffer, lcFramebuffer>& RenderFramebuffer, quint8* Buffer);
+/*** LPub3D Mod - pipelined readback ***/
+	bool BeginRenderFramebufferReadback(const std::pair<lcFramebuffer, lcFramebuffer>& RenderFramebuffer);
+	QImage EndRenderFramebufferReadback();
+	void DestroyRenderFramebufferReadbacks();
+/*** LPub3D Mod end ***/
 
 	lcVertexBuffer CreateVertexBuffer(int Size, const void* Data);
 	void DestroyVertexBuffer(lcVertexBuffer& VertexBuffer);
@@ -260,6 +269,21 @@ protected:
 
 	GLuint mFramebufferObject;
 
+/*** LPub3D Mod - pipelined readback ***/
+	struct lcRenderReadback
+	{
+		GLuint BufferObject;
+		int BufferSize;
+		int Width;
+		int Height;
+		QImage Image;
+	};
+
+	lcRenderReadback mRenderReadbacks[LC_RENDER_READBACKS];
+	int mRenderReadbackFirst;
+	int mRenderReadbackCount;
+/*** LPub3D Mod end ***/
+
 	static lcProgram mPrograms[LC_NUM_MATERIALS];
 
 	Q_DECLARE_TR_FUNCTIONS(lcContext);
@@ -3,6 +3,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/stat.h>
+/*** LPub3D Mod - buffered exporters ***/
+#include <cmath>
+/*** LPub3D Mod end ***/
 #include "lc_file.h"
 
 lcMemFile::lcMemFile()
@@ -147,3 +150,83 @@ char* lcMemFile::ReadLine(char* Buffer, size_t BufferSize)
 	Buffer[BytesRead] = 0;
 	return Buffer;
 }
+
+/*** LPub3D Mod - buffered exporters ***/
+char* lcFormatText(char* Buffer, const char* Text)
+{
+	while (*Text)
+		*Buffer++ = *Text++;
+
+	*Buffer = 0;
+	return Buffer;
+}
+
+char* lcFormatInteger(char* Buffer, long long Value)
+{
+	unsigned long long Digits = Value < 0 ? 0ULL - (unsigned long long)Value : (unsigned long long)Value;
+	char Reversed[24];
+	int NumDigits = 0;
+
+	do
+	{
+		Reversed[NumDigits++] = '0' + (char)(Digits % 10);
+		Digits /= 10;
+	} while (Digits);
+
+	if (Value < 0)
+		*Buffer++ = '-';
+
+	while (NumDigits)
+		*Buffer++ = Reversed[--NumDigits];
+
+	*Buffer = 0;
+	return Buffer;
+}
+
+char* lcFormatFixed(char* Buffer, float Value, int Decimals)
+{
+	static const double Scales[] = { 1.0, 10.0, 100.0, 1000.0, 10000.0, 100000.0, 1000000.0 };
+
+	// A float has a 24 bit mantissa, so scaling it by up to 10^6 in double
+	// precision is exact and rounding the product to the nearest integer
+	// gives the same digits printf does. The C runtimes disagree on exact
+	// halves, glibc rounds them to even and msvcrt away from zero, so those
+	// go to the platform's printf along with anything that does not fit the
+	// integer path, including NaN and infinity.
+	if (Decimals < 0 || Decimals >= (int)(sizeof(Scales) / sizeof(Scales[0])))
+		return Buffer + sprintf(Buffer, "%.*f", Decimals, Value);
+
+	const double Scaled = fabs((double)Value * Scales[Decimals]);
+
+	if (!(Scaled < 9007199254740992.0) || Scaled - floor(Scaled) == 0.5)
+		return Buffer + sprintf(Buffer, "%.*f", Decimals, Value);
+
+	unsigned long long Digits = (unsigned long long)nearbyint(Scaled);
+	char Reversed[24];
+	int NumDigits = 0;
+
+	do
+	{
+		Reversed[NumDigits++] = '0' + (char)(Digits % 10);
+		Digits /= 10;
+	} while (Digits || NumDigits <= Decimals);
+
+	// printf keeps the sign of values that round to zero, "-0.00"
+	if (std::signbit(Value))
+		*Buffer++ = '-';
+
+	while (NumDigits > Decimals)
+		*Buffer++ = Reversed[--NumDigits];
+
+	if (Decimals)
+	{
+		*Buffer++ = '.';
+
+		while (NumDigits)
+			*Buffer++ = Reversed[--NumDigits];
+	}
+
+	*Buffer = 0;
+	return Buffer;
+}
+/*** LPub3D Mod end ***/
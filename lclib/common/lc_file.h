@@ -553,3 +553,13 @@ protected:
 	QFile mFile;
 };
 
+/*** LPub3D Mod - buffered exporters ***/
+// Text formatting for the model exporters. Each function writes at Buffer,
+// null terminates the text and returns a pointer to the terminator so calls
+// can be chained. lcFormatFixed produces the same text as the platform's
+// printf "%.*f" in the C numeric locale the application runs with.
+char* lcFormatText(char* Buffer, const char* Text);
+char* lcFormatInteger(char* Buffer, long long Value);
+char* lcFormatFixed(char* Buffer, float Value, int Decimals);
+/*** LPub3D Mod end ***/
+
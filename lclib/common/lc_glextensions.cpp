@@ -8,6 +8,9 @@ bool gSupportsFramebufferObjectEXT;
 bool gSupportsTexImage2DMultisample;
 bool gSupportsBlendFuncSeparate;
 bool gSupportsAnisotropic;
+/*** LPub3D Mod - pipelined readback ***/
+bool gSupportsPixelBufferObject;
+/*** LPub3D Mod end ***/
 GLfloat gMaxAnisotropy;
 
 #ifdef LC_LOAD_GLEXTENSIONS
@@ -221,6 +224,11 @@ void lcInitializeGLExtensions(const QGLContext* Context)
 		gSupportsVertexBufferObject = true;
 	}
 
+/*** LPub3D Mod - pipelined readback ***/
+	if (gSupportsVertexBufferObject && lcIsGLExtensionSupported(Extensions, "GL_ARB_pixel_buffer_object"))
+		gSupportsPixelBufferObject = true;
+/*** LPub3D Mod end ***/
+
 	// todo: check gl version
 	if (lcIsGLExtensionSupported(Extensions, "GL_ARB_framebuffer_object"))
 	{
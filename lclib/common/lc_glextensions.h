@@ -9,6 +9,9 @@ extern bool gSupportsFramebufferObjectEXT;
 extern bool gSupportsTexImage2DMultisample;
 extern bool gSupportsBlendFuncSeparate;
 extern bool gSupportsAnisotropic;
+/*** LPub3D Mod - pipelined readback ***/
+extern bool gSupportsPixelBufferObject;
+/*** LPub3D Mod end ***/
 extern GLfloat gMaxAnisotropy;
 
 #if !defined(Q_OS_MAC) && !defined(QT_OPENGL_ES)
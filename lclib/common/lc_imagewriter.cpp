@@ -0,0 +1,69 @@
+#include "lc_global.h"
+#include "lc_imagewriter.h"
+#include <QtConcurrent>
+
+/*** LPub3D Mod - pipelined readback ***/
+lcImageWriter::lcImageWriter(int MaxPending)
+{
+	mMaxPending = MaxPending > 0 ? MaxPending : qMax(QThread::idealThreadCount(), 1);
+}
+
+lcImageWriter::~lcImageWriter()
+{
+	Finish();
+}
+
+bool lcImageWriter::Write(const QString& FileName, const QImage& Image, const QByteArray& DefaultFormat, const std::function<QImage(const QImage&)>& Prepare)
+{
+	CollectFinished(false);
+
+	while ((int)mPending.size() >= mMaxPending)
+		CollectFinished(true);
+
+	if (!mErrors.empty())
+		return false;
+
+	mPending.push_back(QtConcurrent::run([FileName, Image, DefaultFormat, Prepare]()
+	{
+		lcImageWriteError Result;
+		QImageWriter Writer(FileName);
+
+		if (Writer.format().isEmpty())
+			Writer.setFormat(DefaultFormat);
+
+		if (!Writer.write(Prepare ? Prepare(Image) : Image))
+		{
+			Result.FileName = FileName;
+			Result.Error = Writer.errorString();
+		}
+
+		return Result;
+	}));
+
+	return true;
+}
+
+std::vector<lcImageWriteError> lcImageWriter::Finish()
+{
+	while (!mPending.empty())
+		CollectFinished(true);
+
+	std::vector<lcImageWriteError> Errors;
+	Errors.swap(mErrors);
+
+	return Errors;
+}
+
+void lcImageWriter::CollectFinished(bool WaitForOldest)
+{
+	while (!mPending.empty() && (WaitForOldest || mPending.front().isFinished()))
+	{
+		lcImageWriteError Result = mPending.front().result();
+		mPending.erase(mPending.begin());
+		WaitForOldest = false;
+
+		if (!Result.FileName.isEmpty())
+			mErrors.push_back(Result);
+	}
+}
+/*** LPub3D Mod end ***/
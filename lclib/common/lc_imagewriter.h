@@ -0,0 +1,36 @@
+#pragma once
+
+/*** LPub3D Mod - pipelined readback ***/
+struct lcImageWriteError
+{
+	QString FileName;
+	QString Error;
+};
+
+// Encodes and writes images on the global thread pool so the caller can
+// draw the next image while earlier ones are written. At most MaxPending
+// writes are in flight; Write blocks on the oldest one beyond that.
+class lcImageWriter
+{
+public:
+	explicit lcImageWriter(int MaxPending = 0);
+	~lcImageWriter();
+
+	lcImageWriter(const lcImageWriter&) = delete;
+	lcImageWriter& operator=(const lcImageWriter&) = delete;
+
+	// Prepare, when set, runs on the worker before encoding, e.g. to crop
+	// the image. Returns false once any earlier write has failed.
+	bool Write(const QString& FileName, const QImage& Image, const QByteArray& DefaultFormat, const std::function<QImage(const QImage&)>& Prepare = std::function<QImage(const QImage&)>());
+
+	// Waits for all queued writes and returns the failures in queue order.
+	std::vector<lcImageWriteError> Finish();
+
+protected:
+	void CollectFinished(bool WaitForOldest);
+
+	int mMaxPending;
+	std::vector<QFuture<lcImageWriteError>> mPending;
+	std::vector<lcImageWriteError> mErrors;
+};
+/*** LPub3D Mod end ***/
@@ -22,6 +22,11 @@
 /*** LPub3D Mod - Includes ***/
 #include "lpub.h"
 #include "version.h"
+#include "tracer.h"
+/*** LPub3D Mod end ***/
+
+/*** LPub3D Mod - part thumbnails ***/
+#define LC_THUMBNAIL_CACHE_KEEP 4
 /*** LPub3D Mod end ***/
 
 #if MAX_MEM_LEVEL >= 8
@@ -33,6 +38,9 @@
 #define LC_LIBRARY_CACHE_VERSION   0x0107
 #define LC_LIBRARY_CACHE_ARCHIVE   0x0001
 #define LC_LIBRARY_CACHE_DIRECTORY 0x0002
+/*** LPub3D Mod - piece cache dependencies ***/
+#define LC_LIBRARY_CACHE_PIECE     0x0004
+/*** LPub3D Mod end ***/
 /*** LPub3D Mod - part types ***/
 #define LC_LIBRARY_PART_TYPE       1
 /*** LPub3D Mod end ***/
@@ -94,6 +102,11 @@ void lcPiecesLibrary::Unload()
 	mZipFiles[LC_ZIPFILE_OFFICIAL] = nullptr;
 	delete mZipFiles[LC_ZIPFILE_UNOFFICIAL];
 	mZipFiles[LC_ZIPFILE_UNOFFICIAL] = nullptr;
+
+/*** LPub3D Mod - part search index ***/
+	mSearchText.clear();
+	mSearchTrigrams.clear();
+/*** LPub3D Mod end ***/
 }
 
 void lcPiecesLibrary::RemoveTemporaryPieces()
@@ -260,6 +273,9 @@ lcTexture* lcPiecesLibrary::FindTexture(const char* TextureName, Project* Curren
 
 bool lcPiecesLibrary::Load(const QString& LibraryPath, bool ShowProgress)
 {
+/*** LPub3D Mod - trace library load ***/
+	LPUB_TRACE_SPAN("lcPiecesLibrary::Load");
+/*** LPub3D Mod end ***/
 	Unload();
 
 	auto LoadCustomColors = []()
@@ -323,6 +339,10 @@ bool lcPiecesLibrary::Load(const QString& LibraryPath, bool ShowProgress)
 	lcLoadDefaultCategories();
 	lcSynthInit();
 
+/*** LPub3D Mod - part search index ***/
+	BuildSearchIndex();
+/*** LPub3D Mod end ***/
+
 	return true;
 }
 
@@ -528,12 +548,23 @@ bool lcPiecesLibrary::OpenDirectory(const QDir& LibraryDir, bool ShowProgress)
 	const int NumBaseFolders = sizeof(BaseFolders) / sizeof(BaseFolders[0]);
 
 	QFileInfoList FileLists[NumBaseFolders];
+/*** LPub3D Mod - part thumbnails ***/
+	QCryptographicHash DirectoryHash(QCryptographicHash::Md5);
+/*** LPub3D Mod end ***/
 
 	for (unsigned int BaseFolderIdx = 0; BaseFolderIdx < NumBaseFolders; BaseFolderIdx++)
 	{
 		QString ParstPath = QDir(LibraryDir.absoluteFilePath(BaseFolders[BaseFolderIdx])).absoluteFilePath(QLatin1String("parts/"));
 		QDir Dir = QDir(ParstPath, QLatin1String("*.dat"), QDir::SortFlags(QDir::Name | QDir::IgnoreCase), QDir::Files | QDir::Hidden | QDir::Readable);
 		FileLists[BaseFolderIdx] = Dir.entryInfoList();
+/*** LPub3D Mod - part thumbnails ***/
+		for (const QFileInfo& FileInfo : FileLists[BaseFolderIdx])
+		{
+			DirectoryHash.addData(FileInfo.fileName().toUtf8());
+			DirectoryHash.addData(QByteArray::number(FileInfo.size()));
+			DirectoryHash.addData(QByteArray::number(FileInfo.lastModified().toMSecsSinceEpoch()));
+		}
+/*** LPub3D Mod end ***/
 	}
 
 	if (FileLists[LC_FOLDER_OFFICIAL].isEmpty())
@@ -558,6 +589,12 @@ bool lcPiecesLibrary::OpenDirectory(const QDir& LibraryDir, bool ShowProgress)
 				char Name[LC_PIECE_NAME_LEN];
 				QString FileName = DirIterator.next();
 				QByteArray FileString = BaseDir.relativeFilePath(FileName).toLatin1();
+/*** LPub3D Mod - part thumbnails ***/
+				const QFileInfo FileInfo = DirIterator.fileInfo();
+				DirectoryHash.addData(FileString);
+				DirectoryHash.addData(QByteArray::number(FileInfo.size()));
+				DirectoryHash.addData(QByteArray::number(FileInfo.lastModified().toMSecsSinceEpoch()));
+/*** LPub3D Mod end ***/
 				const char* Src = strchr(FileString, '/') + 1;
 				char* Dst = Name;
 
@@ -634,6 +671,10 @@ bool lcPiecesLibrary::OpenDirectory(const QDir& LibraryDir, bool ShowProgress)
 		Texture->mName[sizeof(Texture->mName) - 1] = 0;
 	}
 
+/*** LPub3D Mod - part thumbnails ***/
+	mDirectoryCheckSum = DirectoryHash.result();
+/*** LPub3D Mod end ***/
+
 	return true;
 }
 
@@ -843,7 +884,8 @@ void lcPiecesLibrary::ReadDirectoryDescriptions(const QFileInfoList (&FileLists)
 	}
 }
 
-bool lcPiecesLibrary::ReadArchiveCacheFile(const QString& FileName, lcMemFile& CacheFile)
+/*** LPub3D Mod - piece cache dependencies ***/
+bool lcPiecesLibrary::ReadArchiveCacheFile(const QString& FileName, lcMemFile& CacheFile, bool PieceCache)
 {
 	QFile File(FileName);
 
@@ -855,13 +897,18 @@ bool lcPiecesLibrary::ReadArchiveCacheFile(const QString& FileName, lcMemFile& C
 	if (File.read((char*)&CacheVersion, sizeof(CacheVersion)) == -1 || CacheVersion != LC_LIBRARY_CACHE_VERSION)
 		return false;
 
-	if (File.read((char*)&CacheFlags, sizeof(CacheFlags)) == -1 || CacheFlags != LC_LIBRARY_CACHE_ARCHIVE)
+	if (File.read((char*)&CacheFlags, sizeof(CacheFlags)) == -1 || CacheFlags != (PieceCache ? LC_LIBRARY_CACHE_PIECE : LC_LIBRARY_CACHE_ARCHIVE))
 		return false;
 
-	qint64 CacheCheckSum[4];
+	// Piece caches are validated against the checksums of their own files
+	if (!PieceCache)
+	{
+		qint64 CacheCheckSum[4];
 
-	if (File.read((char*)&CacheCheckSum, sizeof(CacheCheckSum)) == -1 || memcmp(CacheCheckSum, mArchiveCheckSum, sizeof(CacheCheckSum)))
-		return false;
+		if (File.read((char*)&CacheCheckSum, sizeof(CacheCheckSum)) == -1 || memcmp(CacheCheckSum, mArchiveCheckSum, sizeof(CacheCheckSum)))
+			return false;
+	}
+/*** LPub3D Mod end ***/
 
 	quint32 UncompressedSize;
 
@@ -933,7 +980,8 @@ bool lcPiecesLibrary::ReadArchiveCacheFile(const QString& FileName, lcMemFile& C
 	return ret == Z_STREAM_END;
 }
 
-bool lcPiecesLibrary::WriteArchiveCacheFile(const QString& FileName, lcMemFile& CacheFile)
+/*** LPub3D Mod - piece cache dependencies ***/
+bool lcPiecesLibrary::WriteArchiveCacheFile(const QString& FileName, lcMemFile& CacheFile, bool PieceCache)
 {
 	QFile File(FileName);
 
@@ -941,7 +989,7 @@ bool lcPiecesLibrary::WriteArchiveCacheFile(const QString& FileName, lcMemFile&
 		return false;
 
 	quint32 CacheVersion = LC_LIBRARY_CACHE_VERSION;
-	quint32 CacheFlags = LC_LIBRARY_CACHE_ARCHIVE;
+	quint32 CacheFlags = PieceCache ? LC_LIBRARY_CACHE_PIECE : LC_LIBRARY_CACHE_ARCHIVE;
 	
 	if (File.write((char*)&CacheVersion, sizeof(CacheVersion)) == -1)
 		return false;
@@ -949,8 +997,9 @@ bool lcPiecesLibrary::WriteArchiveCacheFile(const QString& FileName, lcMemFile&
 	if (File.write((char*)&CacheFlags, sizeof(CacheFlags)) == -1)
 		return false;
 
-	if (File.write((char*)&mArchiveCheckSum, sizeof(mArchiveCheckSum)) == -1)
+	if (!PieceCache && File.write((char*)&mArchiveCheckSum, sizeof(mArchiveCheckSum)) == -1)
 		return false;
+/*** LPub3D Mod end ***/
 
 	quint32 UncompressedSize = (quint32)CacheFile.GetLength();
 
@@ -1112,12 +1161,35 @@ bool lcPiecesLibrary::LoadCachePiece(PieceInfo* Info)
 	QString FileName = QFileInfo(QDir(mCachePath), QString::fromLatin1(Info->mFileName)).absoluteFilePath();
 	lcMemFile MeshData;
 
-	if (!ReadArchiveCacheFile(FileName, MeshData))
+/*** LPub3D Mod - piece cache dependencies ***/
+	if (!ReadArchiveCacheFile(FileName, MeshData, true))
+		return false;
+
+	quint32 NumDependencies;
+	if (MeshData.ReadBuffer((char*)&NumDependencies, sizeof(NumDependencies)) == 0)
 		return false;
 
-	quint32 Flags;
-	if (MeshData.ReadBuffer((char*)&Flags, sizeof(Flags)) == 0)
+	QCryptographicHash Hash(QCryptographicHash::Md5);
+
+	for (quint32 DependencyIdx = 0; DependencyIdx < NumDependencies; DependencyIdx++)
+	{
+		char DependencyName[LC_MAXPATH];
+		quint16 Length;
+
+		if (MeshData.ReadBuffer((char*)&Length, sizeof(Length)) == 0 || Length == 0 || Length >= sizeof(DependencyName))
+			return false;
+
+		if (MeshData.ReadBuffer(DependencyName, Length) == 0)
+			return false;
+
+		DependencyName[Length] = 0;
+		AddCacheFileKey(DependencyName, Hash);
+	}
+
+	char CheckSum[16];
+	if (MeshData.ReadBuffer(CheckSum, sizeof(CheckSum)) == 0 || memcmp(CheckSum, Hash.result().constData(), sizeof(CheckSum)))
 		return false;
+/*** LPub3D Mod end ***/
 
 	lcMesh* Mesh = new lcMesh;
 	if (Mesh->FileLoad(MeshData))
@@ -1136,13 +1208,131 @@ bool lcPiecesLibrary::SaveCachePiece(PieceInfo* Info)
 {
 	lcMemFile MeshData;
 
+/*** LPub3D Mod - piece cache dependencies ***/
+	char PieceName[LC_PIECE_NAME_LEN];
+	strcpy(PieceName, Info->mFileName);
+	strupr(PieceName);
+
+	std::set<std::string> Dependencies;
+	Dependencies.insert(PieceName);
+
+	GetPieceFile(PieceName, [this, &Dependencies](lcFile& File)
+	{
+		GetCacheDependencies(File, Dependencies);
+	});
+
+	QCryptographicHash Hash(QCryptographicHash::Md5);
+
+	MeshData.WriteU32((quint32)Dependencies.size());
+
+	for (const std::string& DependencyName : Dependencies)
+	{
+		MeshData.WriteU16((quint16)DependencyName.size());
+		MeshData.WriteBuffer(DependencyName.c_str(), DependencyName.size());
+		AddCacheFileKey(DependencyName.c_str(), Hash);
+	}
+
+	MeshData.WriteBuffer(Hash.result().constData(), 16);
+/*** LPub3D Mod end ***/
+
 	if (!Info->GetMesh()->FileSave(MeshData))
 		return false;
 
 	QString FileName = QFileInfo(QDir(mCachePath), QString::fromLatin1(Info->mFileName)).absoluteFilePath();
 
-	return WriteArchiveCacheFile(FileName, MeshData);
+/*** LPub3D Mod - piece cache dependencies ***/
+	return WriteArchiveCacheFile(FileName, MeshData, true);
+/*** LPub3D Mod end ***/
+}
+
+/*** LPub3D Mod - piece cache dependencies ***/
+/*
+ * Add the upper case names of all files File includes, directly or through
+ * other subfiles and primitives, to Dependencies.
+ */
+void lcPiecesLibrary::GetCacheDependencies(lcFile& File, std::set<std::string>& Dependencies)
+{
+	char Line[1024];
+
+	while (File.ReadLine(Line, sizeof(Line)))
+	{
+		int LineType;
+		char FileName[LC_MAXPATH];
+
+		if (sscanf(Line, "%d", &LineType) != 1 || LineType != 1)
+			continue;
+
+		if (sscanf(Line, "%*d %*s %*s %*s %*s %*s %*s %*s %*s %*s %*s %*s %*s %*s %1023s", FileName) != 1)
+			continue;
+
+		for (char* Ch = FileName; *Ch; Ch++)
+		{
+			if (*Ch >= 'a' && *Ch <= 'z')
+				*Ch = *Ch + 'A' - 'a';
+			else if (*Ch == '\\')
+				*Ch = '/';
+		}
+
+		if (!Dependencies.insert(FileName).second)
+			continue;
+
+		auto FileCallback = [this, &Dependencies](lcFile& IncludeFile)
+		{
+			GetCacheDependencies(IncludeFile, Dependencies);
+		};
+
+		lcLibraryPrimitive* Primitive = FindPrimitive(FileName);
+
+		if (Primitive)
+			GetPrimitiveFile(Primitive, FileCallback);
+		else
+			GetPieceFile(FileName, FileCallback);
+	}
+}
+
+/*
+ * Add the name and content checksum of a part, subfile or primitive to a
+ * piece cache key. Archive entries use the CRC and size stored in the zip
+ * directory, library folder files are hashed.
+ */
+void lcPiecesLibrary::AddCacheFileKey(const char* FileName, QCryptographicHash& Hash)
+{
+	Hash.addData(FileName, (int)strlen(FileName) + 1);
+
+	lcLibraryPrimitive* Primitive = FindPrimitive(FileName);
+	const auto PieceIt = Primitive ? mPieces.end() : mPieces.find(FileName);
+
+	if (mZipFiles[LC_ZIPFILE_OFFICIAL])
+	{
+		const lcZipFileInfo* ZipInfo = nullptr;
+
+		if (Primitive && mZipFiles[Primitive->mZipFileType])
+			ZipInfo = &mZipFiles[Primitive->mZipFileType]->mFiles[Primitive->mZipFileIndex];
+		else if (PieceIt != mPieces.end() && PieceIt->second->mZipFileType != LC_NUM_ZIPFILES && mZipFiles[PieceIt->second->mZipFileType])
+			ZipInfo = &mZipFiles[PieceIt->second->mZipFileType]->mFiles[PieceIt->second->mZipFileIndex];
+
+		if (ZipInfo)
+		{
+			Hash.addData((const char*)&ZipInfo->crc, sizeof(ZipInfo->crc));
+			Hash.addData((const char*)&ZipInfo->uncompressed_size, sizeof(ZipInfo->uncompressed_size));
+			return;
+		}
+	}
+
+	auto FileCallback = [&Hash](lcFile& File)
+	{
+		QByteArray Data((int)File.GetLength(), 0);
+
+		if (File.ReadBuffer(Data.data(), Data.size()) == (size_t)Data.size())
+			Hash.addData(Data);
+	};
+
+	if (Primitive)
+		GetPrimitiveFile(Primitive, FileCallback);
+	else
+		GetPieceFile(FileName, FileCallback);
 }
+/*** LPub3D Mod end ***/
 
 class lcSleeper : public QThread
 {
@@ -1199,6 +1389,182 @@ void lcPiecesLibrary::ReleasePieceInfo(PieceInfo* Info)
 		Info->Unload();
 }
 
+/*** LPub3D Mod - part thumbnails ***/
+QString lcPiecesLibrary::GetThumbnailCachePath() const
+{
+	QCryptographicHash Hash(QCryptographicHash::Md5);
+
+	if (mZipFiles[LC_ZIPFILE_OFFICIAL])
+	{
+		Hash.addData(mLibraryFileName.toUtf8());
+		Hash.addData(mUnofficialFileName.toUtf8());
+		Hash.addData((const char*)mArchiveCheckSum, sizeof(mArchiveCheckSum));
+	}
+	else
+	{
+		Hash.addData(mLibraryDir.absolutePath().toUtf8());
+		Hash.addData(mDirectoryCheckSum);
+	}
+
+	// thumbnails are drawn with the loaded colour table and the current shading and edge settings
+	for (const lcColor& Color : gColorList)
+	{
+		Hash.addData((const char*)&Color.Code, sizeof(Color.Code));
+		Hash.addData((const char*)&Color.Value, sizeof(Color.Value));
+		Hash.addData((const char*)&Color.Edge, sizeof(Color.Edge));
+	}
+
+	const lcPreferences& Preferences = lcGetPreferences();
+	Hash.addData((const char*)&Preferences.mShadingMode, sizeof(Preferences.mShadingMode));
+	Hash.addData((const char*)&Preferences.mDrawEdgeLines, sizeof(Preferences.mDrawEdgeLines));
+	Hash.addData((const char*)&Preferences.mLineWidth, sizeof(Preferences.mLineWidth));
+
+	return QDir(mCachePath).absoluteFilePath(QLatin1String("thumbnails/") + QString::fromLatin1(Hash.result().toHex()));
+}
+
+void lcPiecesLibrary::PruneThumbnailCache(const QString& CurrentPath)
+{
+	if (CurrentPath == mThumbnailCachePath)
+		return;
+
+	mThumbnailCachePath = CurrentPath;
+
+	// keep the thumbnails of the most recently used libraries, colour tables and render settings
+	const QString ThumbnailPath = QDir(mCachePath).absoluteFilePath(QLatin1String("thumbnails"));
+
+	QtConcurrent::run([ThumbnailPath, CurrentPath]()
+	{
+		// rewriting the marker stamps the current directory as the most recently used
+		QFile Marker(QDir(CurrentPath).absoluteFilePath(QLatin1String("lastused")));
+		if (Marker.open(QIODevice::WriteOnly))
+			Marker.close();
+
+		QDir ThumbnailDir(ThumbnailPath);
+		std::vector<std::pair<QDateTime, QString>> CacheDirs;
+
+		for (const QFileInfo& CacheDir : ThumbnailDir.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot))
+		{
+			const QFileInfo LastUsed(QDir(CacheDir.absoluteFilePath()).absoluteFilePath(QLatin1String("lastused")));
+			CacheDirs.emplace_back(LastUsed.exists() ? LastUsed.lastModified() : CacheDir.lastModified(), CacheDir.absoluteFilePath());
+		}
+
+		std::sort(CacheDirs.begin(), CacheDirs.end(), [](const std::pair<QDateTime, QString>& a, const std::pair<QDateTime, QString>& b)
+		{
+			return a.first > b.first;
+		});
+
+		for (size_t CacheIdx = LC_THUMBNAIL_CACHE_KEEP; CacheIdx < CacheDirs.size(); CacheIdx++)
+			if (CacheDirs[CacheIdx].second != CurrentPath)
+				QDir(CacheDirs[CacheIdx].second).removeRecursively();
+	});
+}
+/*** LPub3D Mod end ***/
+
+/*** LPub3D Mod - part search index ***/
+/*
+ * Lower case Text the way the part list filter compares it, collapsing
+ * double spaces in descriptions, and append it to Folded.
+ */
+static void lcFoldSearchText(const char* Text, bool CollapseSpaces, std::string& Folded)
+{
+	for (const char* Src = Text; *Src; Src++)
+	{
+		Folded += (char)tolower((unsigned char)*Src);
+
+		if (CollapseSpaces && *Src == ' ' && *(Src + 1) == ' ')
+			Src++;
+	}
+}
+
+static quint32 lcSearchTrigram(const char* Text)
+{
+	return (quint32)(unsigned char)Text[0] | ((quint32)(unsigned char)Text[1] << 8) | ((quint32)(unsigned char)Text[2] << 16);
+}
+
+/*
+ * Each library part gets a search index into mSearchText, which holds its
+ * folded description and file name, and is listed under every trigram of
+ * that text. Models and temporary parts are left out because their names
+ * change with the project and are filtered directly.
+ */
+void lcPiecesLibrary::BuildSearchIndex()
+{
+	mSearchText.clear();
+	mSearchTrigrams.clear();
+
+	for (const auto& PieceIt : mPieces)
+	{
+		PieceInfo* Info = PieceIt.second;
+
+		if (Info->IsModel() || Info->IsProject() || Info->IsTemporary())
+		{
+			Info->mSearchIndex = -1;
+			continue;
+		}
+
+		const int SearchIndex = (int)mSearchText.size();
+		std::string Text;
+
+		lcFoldSearchText(Info->m_strDescription, true, Text);
+		Text += '\n';
+		lcFoldSearchText(Info->mFileName, false, Text);
+
+		for (size_t CharIdx = 0; CharIdx + 3 <= Text.size(); CharIdx++)
+		{
+			std::vector<int>& Pieces = mSearchTrigrams[lcSearchTrigram(&Text[CharIdx])];
+
+			if (Pieces.empty() || Pieces.back() != SearchIndex)
+				Pieces.push_back(SearchIndex);
+		}
+
+		Info->mSearchIndex = SearchIndex;
+		mSearchText.push_back(Text);
+	}
+}
+
+/*
+ * Set Matches[SearchIndex] for every indexed part whose description or file
+ * name contains Filter, ignoring case. Only the parts listed under the
+ * rarest trigram of the filter are compared.
+ */
+bool lcPiecesLibrary::SearchPieces(const QByteArray& Filter, std::vector<char>& Matches) const
+{
+	if (mSearchText.empty())
+		return false;
+
+	std::string Folded;
+	lcFoldSearchText(Filter.constData(), false, Folded);
+
+	Matches.assign(mSearchText.size(), 0);
+
+	if (Folded.size() < 3)
+	{
+		for (size_t SearchIndex = 0; SearchIndex < mSearchText.size(); SearchIndex++)
+			Matches[SearchIndex] = mSearchText[SearchIndex].find(Folded) != std::string::npos;
+
+		return true;
+	}
+
+	const std::vector<int>* Candidates = nullptr;
+
+	for (size_t CharIdx = 0; CharIdx + 3 <= Folded.size(); CharIdx++)
+	{
+		const auto TrigramIt = mSearchTrigrams.constFind(lcSearchTrigram(&Folded[CharIdx]));
+
+		if (TrigramIt == mSearchTrigrams.constEnd())
+			return true;
+
+		if (!Candidates || TrigramIt.value().size() < Candidates->size())
+			Candidates = &TrigramIt.value();
+	}
+
+	for (int SearchIndex : *Candidates)
+		Matches[SearchIndex] = mSearchText[SearchIndex].find(Folded) != std::string::npos;
+
+	return true;
+}
+/*** LPub3D Mod end ***/
+
 void lcPiecesLibrary::LoadQueuedPiece()
 {
 	mLoadMutex.lock();
@@ -1235,23 +1601,30 @@ void lcPiecesLibrary::WaitForLoadQueue()
 
 bool lcPiecesLibrary::LoadPieceData(PieceInfo* Info)
 {
+/*** LPub3D Mod - trace library load ***/
+	LPUB_TRACE_SPAN("lcPiecesLibrary::LoadPieceData");
+/*** LPub3D Mod end ***/
 	lcLibraryMeshData MeshData;
 	lcMeshLoader MeshLoader(MeshData, true, nullptr, false);
 
 	bool Loaded = false;
 	bool SaveCache = false;
 
+/*** LPub3D Mod - piece cache dependencies ***/
+	if (LoadCachePiece(Info))
+		return true;
+/*** LPub3D Mod end ***/
+
 	if (Info->mZipFileType != LC_NUM_ZIPFILES && mZipFiles[Info->mZipFileType])
 	{
-		if (LoadCachePiece(Info))
-			return true;
-
 		lcMemFile PieceFile;
 
 		if (mZipFiles[Info->mZipFileType]->ExtractFile(Info->mZipFileIndex, PieceFile))
 			Loaded = MeshLoader.LoadMesh(PieceFile, LC_MESHDATA_SHARED);
 
-		SaveCache = Loaded && (Info->mZipFileType == LC_ZIPFILE_OFFICIAL);
+/*** LPub3D Mod - piece cache dependencies ***/
+		SaveCache = Loaded;
+/*** LPub3D Mod end ***/
 	}
 	else
 	{
@@ -1273,6 +1646,10 @@ bool lcPiecesLibrary::LoadPieceData(PieceInfo* Info)
 			if (PieceFile.Open(QIODevice::ReadOnly))
 				Loaded = MeshLoader.LoadMesh(PieceFile, LC_MESHDATA_SHARED);
 		}
+
+/*** LPub3D Mod - piece cache dependencies ***/
+		SaveCache = Loaded;
+/*** LPub3D Mod end ***/
 	}
 	
 	if (!Loaded || mCancelLoading)
@@ -1836,6 +2213,10 @@ bool lcPiecesLibrary::ReloadUnoffLib()
 
 	//load categories
 	lcLoadDefaultCategories();
+
+/*** LPub3D Mod - part search index ***/
+	BuildSearchIndex();
+/*** LPub3D Mod end ***/
 	return true;
 }
 /*** LPub3D Mod end ***/
@@ -92,6 +92,14 @@ public:
 	PieceInfo* FindPiece(const char* PieceName, Project* Project, bool CreatePlaceholder, bool SearchProjectFolder);
 	void LoadPieceInfo(PieceInfo* Info, bool Wait, bool Priority);
 	void ReleasePieceInfo(PieceInfo* Info);
+/*** LPub3D Mod - part thumbnails ***/
+	QString GetThumbnailCachePath() const;
+	void PruneThumbnailCache(const QString& CurrentPath);
+/*** LPub3D Mod end ***/
+/*** LPub3D Mod - part search index ***/
+	void BuildSearchIndex();
+	bool SearchPieces(const QByteArray& Filter, std::vector<char>& Matches) const;
+/*** LPub3D Mod end ***/
 	bool LoadBuiltinPieces();
 	bool LoadPieceData(PieceInfo* Info);
 	void LoadQueuedPiece();
@@ -162,12 +170,18 @@ protected:
 	void ReadArchiveDescriptions(const QString& OfficialFileName, const QString& UnofficialFileName);
 	void ReadDirectoryDescriptions(const QFileInfoList (&FileLists)[LC_NUM_FOLDERTYPES], bool ShowProgress);
 
-	bool ReadArchiveCacheFile(const QString& FileName, lcMemFile& CacheFile);
-	bool WriteArchiveCacheFile(const QString& FileName, lcMemFile& CacheFile);
+/*** LPub3D Mod - piece cache dependencies ***/
+	bool ReadArchiveCacheFile(const QString& FileName, lcMemFile& CacheFile, bool PieceCache = false);
+	bool WriteArchiveCacheFile(const QString& FileName, lcMemFile& CacheFile, bool PieceCache = false);
+/*** LPub3D Mod end ***/
 	bool LoadCacheIndex(const QString& FileName);
 	bool SaveArchiveCacheIndex(const QString& FileName);
 	bool LoadCachePiece(PieceInfo* Info);
 	bool SaveCachePiece(PieceInfo* Info);
+/*** LPub3D Mod - piece cache dependencies ***/
+	void GetCacheDependencies(lcFile& File, std::set<std::string>& Dependencies);
+	void AddCacheFileKey(const char* FileName, QCryptographicHash& Hash);
+/*** LPub3D Mod end ***/
 	bool ReadDirectoryCacheFile(const QString& FileName, lcMemFile& CacheFile);
 	bool WriteDirectoryCacheFile(const QString& FileName, lcMemFile& CacheFile);
 
@@ -178,6 +192,16 @@ protected:
 	QMutex mTextureMutex;
 	std::vector<lcTexture*> mTextureUploads;
 
+/*** LPub3D Mod - part search index ***/
+	std::vector<std::string> mSearchText;
+	QHash<quint32, std::vector<int>> mSearchTrigrams;
+/*** LPub3D Mod end ***/
+
+/*** LPub3D Mod - part thumbnails ***/
+	QByteArray mDirectoryCheckSum;
+	QString mThumbnailCachePath;
+/*** LPub3D Mod end ***/
+
 	QString mCachePath;
 	qint64 mArchiveCheckSum[4];
 	QString mLibraryFileName;
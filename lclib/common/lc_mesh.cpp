@@ -249,6 +249,19 @@ bool lcMesh::IntersectsPlanes(const lcVector4 Planes[6])
 		return IntersectsPlanes<GLuint>(Planes);
 }
 
+/*** LPub3D Mod - buffered exporters ***/
+static char* lcFormatPOVVector(char* Buffer, float x, float y, float z)
+{
+	Buffer = lcFormatText(Buffer, "<");
+	Buffer = lcFormatFixed(Buffer, x, 2);
+	Buffer = lcFormatText(Buffer, ", ");
+	Buffer = lcFormatFixed(Buffer, y, 2);
+	Buffer = lcFormatText(Buffer, ", ");
+	Buffer = lcFormatFixed(Buffer, z, 2);
+	return lcFormatText(Buffer, ">");
+}
+/*** LPub3D Mod end ***/
+
 template<typename IndexType>
 void lcMesh::ExportPOVRay(lcFile& File, const char* MeshName, const char** ColorTable)
 {
@@ -293,9 +306,22 @@ void lcMesh::ExportPOVRay(lcFile& File, const char* MeshName, const char** Color
 			const lcVector3 n2 = lcUnpackNormal(Verts[Indices[Idx + 1]].Normal);
 			const lcVector3 n3 = lcUnpackNormal(Verts[Indices[Idx + 2]].Normal);
 
-			sprintf(Line, "  smooth_triangle { <%.2f, %.2f, %.2f>, <%.2f, %.2f, %.2f>, <%.2f, %.2f, %.2f>, <%.2f, %.2f, %.2f>, <%.2f, %.2f, %.2f>, <%.2f, %.2f, %.2f> }\n",
-			        -v1.y, -v1.x, v1.z, -n1.y, -n1.x, n1.z, -v2.y, -v2.x, v2.z, -n2.y, -n2.x, n2.z, -v3.y, -v3.x, v3.z, -n3.y, -n3.x, n3.z);
-			File.WriteLine(Line);
+/*** LPub3D Mod - buffered exporters ***/
+			char* Text = lcFormatText(Line, "  smooth_triangle { ");
+			Text = lcFormatPOVVector(Text, -v1.y, -v1.x, v1.z);
+			Text = lcFormatText(Text, ", ");
+			Text = lcFormatPOVVector(Text, -n1.y, -n1.x, n1.z);
+			Text = lcFormatText(Text, ", ");
+			Text = lcFormatPOVVector(Text, -v2.y, -v2.x, v2.z);
+			Text = lcFormatText(Text, ", ");
+			Text = lcFormatPOVVector(Text, -n2.y, -n2.x, n2.z);
+			Text = lcFormatText(Text, ", ");
+			Text = lcFormatPOVVector(Text, -v3.y, -v3.x, v3.z);
+			Text = lcFormatText(Text, ", ");
+			Text = lcFormatPOVVector(Text, -n3.y, -n3.x, n3.z);
+			Text = lcFormatText(Text, " }\n");
+			File.WriteBuffer(Line, Text - Line);
+/*** LPub3D Mod end ***/
 		}
 
 		if (Section->ColorIndex != gDefaultColor)
@@ -345,8 +371,25 @@ void lcMesh::ExportWavefrontIndices(lcFile& File, int DefaultColorIndex, int Ver
 			long int idx2 = Indices[Idx + 1] + VertexOffset;
 			long int idx3 = Indices[Idx + 2] + VertexOffset;
 
+/*** LPub3D Mod - buffered exporters ***/
+			// A degenerate triangle writes the previous line again, kept so the output does not change
 			if (idx1 != idx2 && idx1 != idx3 && idx2 != idx3)
-				sprintf(Line, "f %ld//%ld %ld//%ld %ld//%ld\n", idx1, idx1, idx2, idx2, idx3, idx3);
+			{
+				char* Text = lcFormatText(Line, "f ");
+				Text = lcFormatInteger(Text, idx1);
+				Text = lcFormatText(Text, "//");
+				Text = lcFormatInteger(Text, idx1);
+				Text = lcFormatText(Text, " ");
+				Text = lcFormatInteger(Text, idx2);
+				Text = lcFormatText(Text, "//");
+				Text = lcFormatInteger(Text, idx2);
+				Text = lcFormatText(Text, " ");
+				Text = lcFormatInteger(Text, idx3);
+				Text = lcFormatText(Text, "//");
+				Text = lcFormatInteger(Text, idx3);
+				lcFormatText(Text, "\n");
+			}
+/*** LPub3D Mod end ***/
 			File.WriteLine(Line);
 		}
 	}
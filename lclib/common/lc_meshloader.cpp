@@ -1297,6 +1297,248 @@ lcMesh* lcLibraryMeshData::CreateMesh()
 	return Mesh;
 }
 
+/*** LPub3D Mod - fast line parser ***/
+/*
+ * Line parser for geometry lines that follows the sscanf conversions
+ * ReadMeshData used before: %d line type and colour, %i colour when the
+ * colour reads as 0, %f values and %s file name. Plain decimal numbers are
+ * converted without the C library, anything else falls back to strtof.
+ */
+static inline bool lcIsScanSpace(char Ch)
+{
+	return Ch == ' ' || (Ch >= '\t' && Ch <= '\r');
+}
+
+static inline bool lcIsDigit(char Ch)
+{
+	return Ch >= '0' && Ch <= '9';
+}
+
+static bool lcParseMeshInt(const char*& Src, int& Value)
+{
+	const char* Ch = Src;
+
+	while (lcIsScanSpace(*Ch))
+		Ch++;
+
+	bool Negative = false;
+
+	if (*Ch == '-' || *Ch == '+')
+		Negative = *Ch++ == '-';
+
+	if (!lcIsDigit(*Ch))
+		return false;
+
+	quint32 Result = 0;
+
+	while (lcIsDigit(*Ch))
+		Result = Result * 10 + (*Ch++ - '0');
+
+	Value = (int)(Negative ? 0u - Result : Result);
+	Src = Ch;
+
+	return true;
+}
+
+static bool lcParseMeshIntAnyBase(const char*& Src, quint32& Value)
+{
+	const char* Ch = Src;
+
+	while (lcIsScanSpace(*Ch))
+		Ch++;
+
+	bool Negative = false;
+
+	if (*Ch == '-' || *Ch == '+')
+		Negative = *Ch++ == '-';
+
+	quint32 Result = 0;
+
+	if (Ch[0] == '0' && (Ch[1] == 'x' || Ch[1] == 'X') && isxdigit((unsigned char)Ch[2]))
+	{
+		for (Ch += 2; isxdigit((unsigned char)*Ch); Ch++)
+			Result = Result * 16 + (lcIsDigit(*Ch) ? *Ch - '0' : (*Ch | 0x20) - 'a' + 10);
+	}
+	else if (*Ch == '0')
+	{
+		for (; *Ch >= '0' && *Ch <= '7'; Ch++)
+			Result = Result * 8 + (*Ch - '0');
+	}
+	else if (lcIsDigit(*Ch))
+	{
+		for (; lcIsDigit(*Ch); Ch++)
+			Result = Result * 10 + (*Ch - '0');
+	}
+	else
+		return false;
+
+	Value = Negative ? 0u - Result : Result;
+	Src = Ch;
+
+	return true;
+}
+
+static bool lcParseMeshFloat(const char*& Src, float& Value)
+{
+	static const double Powers[] =
+	{
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+
+	while (lcIsScanSpace(*Src))
+		Src++;
+
+	const char* Ch = Src;
+	bool Negative = false;
+
+	if (*Ch == '-' || *Ch == '+')
+		Negative = *Ch++ == '-';
+
+	quint64 Mantissa = 0;
+	int Digits = 0;
+	int Exponent = 0;
+	bool HasDigits = false;
+	bool Exact = true;
+
+	for (; lcIsDigit(*Ch); Ch++)
+	{
+		HasDigits = true;
+
+		if (Digits < 19)
+		{
+			Mantissa = Mantissa * 10 + (*Ch - '0');
+			if (Mantissa)
+				Digits++;
+		}
+		else
+		{
+			Exact &= *Ch == '0';
+			Exponent++;
+		}
+	}
+
+	if (*Ch == '.')
+	{
+		for (Ch++; lcIsDigit(*Ch); Ch++)
+		{
+			HasDigits = true;
+
+			if (Digits < 19)
+			{
+				Mantissa = Mantissa * 10 + (*Ch - '0');
+				if (Mantissa)
+					Digits++;
+				Exponent--;
+			}
+			else
+				Exact &= *Ch == '0';
+		}
+	}
+
+	if (HasDigits && (*Ch == 'e' || *Ch == 'E'))
+	{
+		const char* ExponentCh = Ch + 1;
+		bool NegativeExponent = false;
+
+		if (*ExponentCh == '-' || *ExponentCh == '+')
+			NegativeExponent = *ExponentCh++ == '-';
+
+		if (lcIsDigit(*ExponentCh))
+		{
+			int ExponentValue = 0;
+
+			for (; lcIsDigit(*ExponentCh); ExponentCh++)
+				if (ExponentValue < 10000)
+					ExponentValue = ExponentValue * 10 + (*ExponentCh - '0');
+
+			Exponent += NegativeExponent ? -ExponentValue : ExponentValue;
+			Ch = ExponentCh;
+		}
+		else
+			Exact = false;
+	}
+
+	// Hex floats, inf, nan, long mantissas and large exponents are left to the C library
+	if (!HasDigits || !Exact || Mantissa >= (1ull << 53) || Exponent < -22 || Exponent > 22 || (*Ch && !lcIsScanSpace(*Ch)))
+	{
+		char* End;
+		Value = strtof(Src, &End);
+
+		if (End == Src)
+			return false;
+
+		Src = End;
+		return true;
+	}
+
+	double Result = (double)Mantissa;
+	Result = Exponent < 0 ? Result / Powers[-Exponent] : Result * Powers[Exponent];
+	Value = (float)(Negative ? -Result : Result);
+	Src = Ch;
+
+	return true;
+}
+
+bool lcParseMeshLineType(const char* Line, int& LineType)
+{
+	return lcParseMeshInt(Line, LineType);
+}
+
+bool lcParseMeshLine(const char* Line, lcMeshLine& MeshLine)
+{
+	static const int NumLineValues[] = { 0, 12, 6, 9, 12, 12 };
+	const char* Ch = Line;
+	int ColorCode;
+
+	if (!lcParseMeshInt(Ch, MeshLine.LineType))
+		return false;
+
+	const char* ColorCh = Ch;
+	quint32 ColorCodeHex = 0;
+
+	if (!lcParseMeshInt(ColorCh, ColorCode))
+		return false;
+
+	MeshLine.ColorCode = (quint32)ColorCode;
+	MeshLine.ColorCodeHex = MeshLine.ColorCode;
+	MeshLine.NumValues = 0;
+	MeshLine.FileName[0] = 0;
+
+	if (MeshLine.LineType < 1 || MeshLine.LineType > 5)
+		return true;
+
+	// Values follow the colour read with %i, which takes hex colours whole
+	lcParseMeshIntAnyBase(Ch, ColorCodeHex);
+
+	if (ColorCode == 0)
+		MeshLine.ColorCodeHex = ColorCodeHex;
+
+	const int NumValues = NumLineValues[MeshLine.LineType];
+
+	while (MeshLine.NumValues < NumValues && lcParseMeshFloat(Ch, MeshLine.Values[MeshLine.NumValues]))
+		MeshLine.NumValues++;
+
+	for (int ValueIdx = MeshLine.NumValues; ValueIdx < NumValues; ValueIdx++)
+		MeshLine.Values[ValueIdx] = 0.0f;
+
+	if (MeshLine.LineType == 1 && MeshLine.NumValues == NumValues)
+	{
+		while (lcIsScanSpace(*Ch))
+			Ch++;
+
+		char* Dst = MeshLine.FileName;
+
+		while (*Ch && !lcIsScanSpace(*Ch) && Dst - MeshLine.FileName < LC_MAXPATH - 1)
+			*Dst++ = *Ch++;
+
+		*Dst = 0;
+	}
+
+	return true;
+}
+/*** LPub3D Mod end ***/
+
 lcMeshLoader::lcMeshLoader(lcLibraryMeshData& MeshData, bool Optimize, Project* CurrentProject, bool SearchProjectFolder)
 	: mMeshData(MeshData), mOptimize(Optimize), mCurrentProject(CurrentProject), mSearchProjectFolder(SearchProjectFolder)
 {
@@ -1328,8 +1570,10 @@ bool lcMeshLoader::ReadMeshData(lcFile& File, const lcMatrix44& CurrentTransform
 
 		Line = Buffer;
 
-		if (sscanf(Line, "%d", &LineType) != 1)
+/*** LPub3D Mod - fast line parser ***/
+		if (!lcParseMeshLineType(Line, LineType))
 			continue;
+/*** LPub3D Mod end ***/
 
 		if (LineType == 0)
 		{
@@ -1564,15 +1808,24 @@ bool lcMeshLoader::ReadMeshData(lcFile& File, const lcMatrix44& CurrentTransform
 				continue;
 		}
 
-		if (sscanf(Line, "%d %d", &LineType, &ColorCode) != 2)
+/*** LPub3D Mod - fast line parser ***/
+		lcMeshLine MeshLine;
+
+		if (!lcParseMeshLine(Line, MeshLine))
 			continue;
 
+		LineType = MeshLine.LineType;
+		ColorCode = MeshLine.ColorCode;
+/*** LPub3D Mod end ***/
+
 		if (LineType < 1 || LineType > 5)
 			continue;
 
 		if (ColorCode == 0)
 		{
-			sscanf(Line, "%d %i", &LineType, &ColorCodeHex);
+/*** LPub3D Mod - fast line parser ***/
+			ColorCodeHex = MeshLine.ColorCodeHex;
+/*** LPub3D Mod end ***/
 
 			if (ColorCode != ColorCodeHex)
 				ColorCode = ColorCodeHex | LC_COLOR_DIRECT;
@@ -1601,20 +1854,18 @@ bool lcMeshLoader::ReadMeshData(lcFile& File, const lcMatrix44& CurrentTransform
 			}
 		}
 
-		int Dummy;
 		lcVector3 Points[4];
 
 		switch (LineType)
 		{
 		case 1:
 		{
-			char OriginalFileName[LC_MAXPATH];
-			float fm[12];
-
-			sscanf(Line, "%d %i %f %f %f %f %f %f %f %f %f %f %f %f %s", &LineType, &Dummy, &fm[0], &fm[1], &fm[2], &fm[3], &fm[4], &fm[5], &fm[6], &fm[7], &fm[8], &fm[9], &fm[10], &fm[11], OriginalFileName);
+/*** LPub3D Mod - fast line parser ***/
+			const float* fm = MeshLine.Values;
 
 			char FileName[LC_MAXPATH];
-			strcpy(FileName, OriginalFileName);
+			strcpy(FileName, MeshLine.FileName);
+/*** LPub3D Mod end ***/
 
 			char* Ch;
 			for (Ch = FileName; *Ch; Ch++)
@@ -1661,10 +1912,10 @@ bool lcMeshLoader::ReadMeshData(lcFile& File, const lcMatrix44& CurrentTransform
 		} break;
 
 		case 2:
-			sscanf(Line, "%d %i %f %f %f %f %f %f", &LineType, &Dummy, &Points[0].x, &Points[0].y, &Points[0].z, &Points[1].x, &Points[1].y, &Points[1].z);
-
-			Points[0] = lcMul31(Points[0], CurrentTransform);
-			Points[1] = lcMul31(Points[1], CurrentTransform);
+/*** LPub3D Mod - fast line parser ***/
+			Points[0] = lcMul31(MeshLine.GetPoint(0), CurrentTransform);
+			Points[1] = lcMul31(MeshLine.GetPoint(1), CurrentTransform);
+/*** LPub3D Mod end ***/
 
 			if (TextureMap)
 			{
@@ -1678,12 +1929,11 @@ bool lcMeshLoader::ReadMeshData(lcFile& File, const lcMatrix44& CurrentTransform
 			break;
 
 		case 3:
-			sscanf(Line, "%d %i %f %f %f %f %f %f %f %f %f", &LineType, &Dummy, &Points[0].x, &Points[0].y, &Points[0].z,
-				   &Points[1].x, &Points[1].y, &Points[1].z, &Points[2].x, &Points[2].y, &Points[2].z);
-
-			Points[0] = lcMul31(Points[0], CurrentTransform);
-			Points[1] = lcMul31(Points[1], CurrentTransform);
-			Points[2] = lcMul31(Points[2], CurrentTransform);
+/*** LPub3D Mod - fast line parser ***/
+			Points[0] = lcMul31(MeshLine.GetPoint(0), CurrentTransform);
+			Points[1] = lcMul31(MeshLine.GetPoint(1), CurrentTransform);
+			Points[2] = lcMul31(MeshLine.GetPoint(2), CurrentTransform);
+/*** LPub3D Mod end ***/
 
 			if (TextureMap)
 			{
@@ -1697,13 +1947,12 @@ bool lcMeshLoader::ReadMeshData(lcFile& File, const lcMatrix44& CurrentTransform
 			break;
 
 		case 4:
-			sscanf(Line, "%d %i %f %f %f %f %f %f %f %f %f %f %f %f", &LineType, &Dummy, &Points[0].x, &Points[0].y, &Points[0].z,
-				   &Points[1].x, &Points[1].y, &Points[1].z, &Points[2].x, &Points[2].y, &Points[2].z, &Points[3].x, &Points[3].y, &Points[3].z);
-
-			Points[0] = lcMul31(Points[0], CurrentTransform);
-			Points[1] = lcMul31(Points[1], CurrentTransform);
-			Points[2] = lcMul31(Points[2], CurrentTransform);
-			Points[3] = lcMul31(Points[3], CurrentTransform);
+/*** LPub3D Mod - fast line parser ***/
+			Points[0] = lcMul31(MeshLine.GetPoint(0), CurrentTransform);
+			Points[1] = lcMul31(MeshLine.GetPoint(1), CurrentTransform);
+			Points[2] = lcMul31(MeshLine.GetPoint(2), CurrentTransform);
+			Points[3] = lcMul31(MeshLine.GetPoint(3), CurrentTransform);
+/*** LPub3D Mod end ***/
 
 			if (TextureMap)
 			{
@@ -1717,13 +1966,12 @@ bool lcMeshLoader::ReadMeshData(lcFile& File, const lcMatrix44& CurrentTransform
 			break;
 
 		case 5:
-			sscanf(Line, "%d %i %f %f %f %f %f %f %f %f %f %f %f %f", &LineType, &Dummy, &Points[0].x, &Points[0].y, &Points[0].z,
-				   &Points[1].x, &Points[1].y, &Points[1].z, &Points[2].x, &Points[2].y, &Points[2].z, &Points[3].x, &Points[3].y, &Points[3].z);
-
-			Points[0] = lcMul31(Points[0], CurrentTransform);
-			Points[1] = lcMul31(Points[1], CurrentTransform);
-			Points[2] = lcMul31(Points[2], CurrentTransform);
-			Points[3] = lcMul31(Points[3], CurrentTransform);
+/*** LPub3D Mod - fast line parser ***/
+			Points[0] = lcMul31(MeshLine.GetPoint(0), CurrentTransform);
+			Points[1] = lcMul31(MeshLine.GetPoint(1), CurrentTransform);
+			Points[2] = lcMul31(MeshLine.GetPoint(2), CurrentTransform);
+			Points[3] = lcMul31(MeshLine.GetPoint(3), CurrentTransform);
+/*** LPub3D Mod end ***/
 
 			mMeshData.AddLine(MeshDataType, LineType, ColorCode, WindingCCW, Points, mOptimize);
 			break;
@@ -137,6 +137,26 @@ public:
 	bool mHasTextures;
 };
 
+/*** LPub3D Mod - fast line parser ***/
+struct lcMeshLine
+{
+	lcVector3 GetPoint(int PointIdx) const
+	{
+		return lcVector3(Values[PointIdx * 3], Values[PointIdx * 3 + 1], Values[PointIdx * 3 + 2]);
+	}
+
+	int LineType;
+	quint32 ColorCode;
+	quint32 ColorCodeHex;
+	int NumValues;
+	float Values[12];
+	char FileName[LC_MAXPATH];
+};
+
+bool lcParseMeshLineType(const char* Line, int& LineType);
+bool lcParseMeshLine(const char* Line, lcMeshLine& MeshLine);
+/*** LPub3D Mod end ***/
+
 class lcMeshLoader
 {
 public:
@@ -23,12 +23,24 @@
 #include "lc_qpropertiesdialog.h"
 #include "lc_qutils.h"
 #include "lc_lxf.h"
+/*** LPub3D Mod - pipelined readback ***/
+#include "lc_imagewriter.h"
+/*** LPub3D Mod end ***/
 
 /*** LPub3D Mod - includes ***/
 #include "lpub.h"
 #include "metaitem.h"
 /*** LPub3D Mod end ***/
 
+/*** LPub3D Mod - parallel scene ***/
+#include <QtConcurrent>
+#include <QAtomicInt>
+
+#define LC_SCENE_PARALLEL_MIN_PIECES 2048
+
+static QAtomicInt gSubModelMeshesGeneration(1);
+/*** LPub3D Mod end ***/
+
 void lcModelProperties::LoadDefaults()
 {
 	mAuthor = lcGetProfileString(LC_PROFILE_DEFAULT_AUTHOR_NAME);
@@ -159,6 +171,9 @@ lcModel::lcModel(const QString& Name)
 	mCurrentStep = 1;
 	mBackgroundTexture = nullptr;
 	mPieceInfo = nullptr;
+/*** LPub3D Mod - parallel scene ***/
+	mSubModelMeshesGeneration = 0;
+/*** LPub3D Mod end ***/
 }
 
 lcModel::~lcModel()
@@ -230,6 +245,10 @@ void lcModel::DeleteHistory()
 
 void lcModel::DeleteModel()
 {
+/*** LPub3D Mod - parallel scene ***/
+	InvalidateSubModelMeshes();
+/*** LPub3D Mod end ***/
+
 	lcReleaseTexture(mBackgroundTexture);
 	mBackgroundTexture = nullptr;
 
@@ -276,6 +295,10 @@ void lcModel::UpdatePieceInfo(std::vector<lcModel*>& UpdatedModels)
 	if (std::find(UpdatedModels.begin(), UpdatedModels.end(), this) != UpdatedModels.end())
 		return;
 
+/*** LPub3D Mod - parallel scene ***/
+	InvalidateSubModelMeshes();
+/*** LPub3D Mod end ***/
+
 	mPieceInfo->SetModel(this, false, nullptr, false);
 	UpdatedModels.push_back(this);
 
@@ -1270,9 +1293,70 @@ void lcModel::GetScene(lcScene& Scene, lcCamera* ViewCamera, bool DrawInterface,
 
 	mPieceInfo->AddRenderMesh(Scene);
 
-	for (lcPiece* Piece : mPieces)
-		if (Piece->IsVisible(mCurrentStep))
-			Piece->AddMainModelRenderMeshes(Scene, Highlight && Piece->GetStepShow() == mCurrentStep);
+/*** LPub3D Mod - parallel scene ***/
+	const int NumPieces = mPieces.GetSize();
+	const int NumThreads = QThread::idealThreadCount();
+
+	if (NumPieces < LC_SCENE_PARALLEL_MIN_PIECES || NumThreads < 2)
+	{
+		for (lcPiece* Piece : mPieces)
+			if (Piece->IsVisible(mCurrentStep))
+				Piece->AddMainModelRenderMeshes(Scene, Highlight && Piece->GetStepShow() == mCurrentStep);
+	}
+	else
+	{
+		// Flatten the referenced submodels up front so the workers only read the cached lists
+		for (lcPiece* Piece : mPieces)
+		{
+			if (!Piece->IsVisible(mCurrentStep))
+				continue;
+
+			PieceInfo* Info = Piece->mPieceInfo;
+
+			if (Info->IsModel())
+				Info->GetModel()->GetSubModelMeshes();
+			else if (Info->IsProject() && Info->GetProject()->GetMainModel())
+				Info->GetProject()->GetMainModel()->GetSubModelMeshes();
+		}
+
+		struct lcSceneChunk
+		{
+			int Start;
+			int End;
+			lcScene Scene;
+		};
+
+		const int ChunkSize = (NumPieces + NumThreads - 1) / NumThreads;
+		std::vector<lcSceneChunk> Chunks(NumThreads);
+
+		for (int ChunkIdx = 0; ChunkIdx < NumThreads; ChunkIdx++)
+		{
+			lcSceneChunk& Chunk = Chunks[ChunkIdx];
+
+			Chunk.Start = qMin(ChunkIdx * ChunkSize, NumPieces);
+			Chunk.End = qMin(Chunk.Start + ChunkSize, NumPieces);
+			Chunk.Scene.Begin(ViewCamera->mWorldView);
+			Chunk.Scene.SetActiveSubmodelInstance(ActiveSubmodelInstance, ActiveSubmodelTransform);
+			Chunk.Scene.SetDrawInterface(DrawInterface);
+		}
+
+		auto AddChunkRenderMeshes = [this, Highlight](lcSceneChunk& Chunk)
+		{
+			for (int PieceIdx = Chunk.Start; PieceIdx < Chunk.End; PieceIdx++)
+			{
+				lcPiece* Piece = mPieces[PieceIdx];
+
+				if (Piece->IsVisible(mCurrentStep))
+					Piece->AddMainModelRenderMeshes(Chunk.Scene, Highlight && Piece->GetStepShow() == mCurrentStep);
+			}
+		};
+
+		QtConcurrent::blockingMap(Chunks, AddChunkRenderMeshes);
+
+		for (const lcSceneChunk& Chunk : Chunks)
+			Scene.Merge(Chunk.Scene);
+	}
+/*** LPub3D Mod end ***/
 
 	if (DrawInterface && !ActiveSubmodelInstance)
 	{
@@ -1290,11 +1374,49 @@ void lcModel::GetScene(lcScene& Scene, lcCamera* ViewCamera, bool DrawInterface,
 
 void lcModel::AddSubModelRenderMeshes(lcScene& Scene, const lcMatrix44& WorldMatrix, int DefaultColorIndex, lcRenderMeshState RenderMeshState, bool ParentActive) const
 {
+/*** LPub3D Mod - parallel scene ***/
+	if (!ParentActive && !Scene.GetActiveSubmodelInstance())
+	{
+		for (const lcModelPartsEntry& SubModelMesh : GetSubModelMeshes())
+		{
+			int ColorIndex = SubModelMesh.ColorIndex == gDefaultColor ? DefaultColorIndex : SubModelMesh.ColorIndex;
+			Scene.AddMesh(SubModelMesh.Mesh, lcMul(SubModelMesh.WorldMatrix, WorldMatrix), ColorIndex, RenderMeshState);
+		}
+
+		return;
+	}
+/*** LPub3D Mod end ***/
+
 	for (lcPiece* Piece : mPieces)
 		if (Piece->IsVisibleInSubModel())
 			Piece->AddSubModelRenderMeshes(Scene, WorldMatrix, DefaultColorIndex, RenderMeshState, ParentActive);
 }
 
+/*** LPub3D Mod - parallel scene ***/
+const std::vector<lcModelPartsEntry>& lcModel::GetSubModelMeshes() const
+{
+	const int Generation = gSubModelMeshesGeneration.loadAcquire();
+
+	if (mSubModelMeshesGeneration != Generation)
+	{
+		mSubModelMeshes.clear();
+
+		for (lcPiece* Piece : mPieces)
+			if (Piece->IsVisibleInSubModel())
+				Piece->GetSubModelMeshes(mSubModelMeshes);
+
+		mSubModelMeshesGeneration = Generation;
+	}
+
+	return mSubModelMeshes;
+}
+
+void lcModel::InvalidateSubModelMeshes()
+{
+	gSubModelMeshesGeneration.ref();
+}
+/*** LPub3D Mod end ***/
+
 void lcModel::DrawBackground(lcGLWidget* Widget)
 {
 	if (mProperties.mBackgroundType == LC_BACKGROUND_SOLID)
@@ -1389,7 +1511,9 @@ void lcModel::SaveStepImages(const QString& BaseName, bool AddStepSuffix, bool Z
 	View.SetCamera(Camera, false);
 	View.SetContext(Context);
 
-	if (!View.BeginRenderToImage(Width, Height))
+/*** LPub3D Mod - pipelined readback ***/
+	if (!View.BeginRenderToImage(Width, Height, true))
+/*** LPub3D Mod end ***/
 	{
 /*** LPub3D Mod - set 3DViewer label ***/
 		QMessageBox::warning(gMainWindow, tr("3DViewer"), tr("Error creating images."));
@@ -1397,29 +1521,40 @@ void lcModel::SaveStepImages(const QString& BaseName, bool AddStepSuffix, bool Z
 		return;
 	}
 
+/*** LPub3D Mod - pipelined readback ***/
+	// Step N is read back and encoded while step N + 1 is drawn
+	lcImageWriter ImageWriter;
+	QString PendingFileName;
+	bool Pending = false;
+
 	for (lcStep Step = Start; Step <= End; Step++)
 	{
 		SetTemporaryStep(Step);
 		View.OnDraw();
+		View.BeginRenderImageReadback();
 
-		QString FileName;
+		if (Pending && !ImageWriter.Write(PendingFileName, View.EndRenderImageReadback(), "png"))
+		{
+			Pending = false;
+			break;
+		}
 
 		if (AddStepSuffix)
-			FileName = BaseName.arg(Step, 2, 10, QLatin1Char('0'));
+			PendingFileName = BaseName.arg(Step, 2, 10, QLatin1Char('0'));
 		else
-			FileName = BaseName;
+			PendingFileName = BaseName;
 
-		QImageWriter Writer(FileName);
+		Pending = true;
+	}
 
-		if (Writer.format().isEmpty())
-			Writer.setFormat("png");
+	if (Pending)
+		ImageWriter.Write(PendingFileName, View.EndRenderImageReadback(), "png");
 
-		if (!Writer.write(View.GetRenderImage()))
-		{
-			QMessageBox::information(gMainWindow, tr("Error"), tr("Error writing to file '%1':\n%2").arg(FileName, Writer.errorString()));
-			break;
-		}
-	}
+	const std::vector<lcImageWriteError> WriteErrors = ImageWriter.Finish();
+
+	if (!WriteErrors.empty())
+		QMessageBox::information(gMainWindow, tr("Error"), tr("Error writing to file '%1':\n%2").arg(WriteErrors.front().FileName, WriteErrors.front().Error));
+/*** LPub3D Mod end ***/
 
 	View.EndRenderToImage();
 	Context->ClearResources();
@@ -1507,6 +1642,10 @@ void lcModel::SaveCheckpoint(const QString& Description)
 {
 	lcModelHistoryEntry* ModelHistoryEntry = new lcModelHistoryEntry();
 
+/*** LPub3D Mod - parallel scene ***/
+	InvalidateSubModelMeshes();
+/*** LPub3D Mod end ***/
+
 	ModelHistoryEntry->Description = Description;
 
 	QTextStream Stream(&ModelHistoryEntry->File);
@@ -1560,6 +1699,10 @@ void lcModel::SetActive(bool Active)
 
 void lcModel::CalculateStep(lcStep Step)
 {
+/*** LPub3D Mod - parallel scene ***/
+	InvalidateSubModelMeshes();
+/*** LPub3D Mod end ***/
+
 	for (lcPiece* Piece : mPieces)
 	{
 		Piece->UpdatePosition(Step);
@@ -2092,6 +2235,10 @@ void lcModel::InsertPiece(lcPiece* Piece, int Index)
 			lcGetPiecesLibrary()->mBuffersDirty = true;
 	}
 
+/*** LPub3D Mod - parallel scene ***/
+	InvalidateSubModelMeshes();
+/*** LPub3D Mod end ***/
+
 	mPieces.InsertAt(Index, Piece);
 }
 
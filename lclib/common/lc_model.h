@@ -239,6 +239,10 @@ public:
 
 	void GetScene(lcScene& Scene, lcCamera* ViewCamera, bool DrawInterface, bool Highlight, lcPiece* ActiveSubmodelInstance, const lcMatrix44& ActiveSubmodelTransform) const;
 	void AddSubModelRenderMeshes(lcScene& Scene, const lcMatrix44& WorldMatrix, int DefaultColorIndex, lcRenderMeshState RenderMeshState, bool ParentActive) const;
+/*** LPub3D Mod - parallel scene ***/
+	const std::vector<lcModelPartsEntry>& GetSubModelMeshes() const;
+	static void InvalidateSubModelMeshes();
+/*** LPub3D Mod end ***/
 	void DrawBackground(lcGLWidget* Widget);
 	void SaveStepImages(const QString& BaseName, bool AddStepSuffix, bool Zoom, bool Highlight, int Width, int Height, lcStep Start, lcStep End);
 
@@ -374,6 +378,10 @@ protected:
 	lcArray<lcLight*> mLights;
 	lcArray<lcGroup*> mGroups;
 	QStringList mFileLines;
+/*** LPub3D Mod - parallel scene ***/
+	mutable std::vector<lcModelPartsEntry> mSubModelMeshes;
+	mutable int mSubModelMeshesGeneration;
+/*** LPub3D Mod end ***/
 
 	lcModelHistoryEntry* mSavedHistory;
 	std::vector<lcModelHistoryEntry*> mUndoHistory;
@@ -9,6 +9,12 @@
 #include "pieceinf.h"
 #include "view.h"
 #include "lc_glextensions.h"
+/*** LPub3D Mod - part thumbnails ***/
+#include <QtConcurrent>
+
+#define LC_THUMBNAIL_ATLAS_SIZE 2048
+#define LC_THUMBNAIL_RETRY_DELAY 100
+/*** LPub3D Mod end ***/
 
  Q_DECLARE_METATYPE(QList<int>)
 
@@ -43,6 +49,11 @@ lcPartSelectionListModel::lcPartSelectionListModel(QObject* Parent)
 	mListMode = lcGetProfileInt(LC_PROFILE_PARTS_LIST_LISTMODE);
 	mShowDecoratedParts = lcGetProfileInt(LC_PROFILE_PARTS_LIST_DECORATED);
 	mShowPartAliases = lcGetProfileInt(LC_PROFILE_PARTS_LIST_ALIASES);
+/*** LPub3D Mod - part thumbnails ***/
+	mPreviewGeneration = 0;
+	mDrawPreviewsQueued = false;
+	mLoadThumbnailsQueued = false;
+/*** LPub3D Mod end ***/
 
 	int ColorCode = lcGetProfileInt(LC_PROFILE_PARTS_LIST_COLOR);
 	if (ColorCode == -1)
@@ -75,6 +86,17 @@ void lcPartSelectionListModel::ClearRequests()
 	}
 
 	mRequestedPreviews.clear();
+
+/*** LPub3D Mod - part thumbnails ***/
+	for (int PendingIdx : mPendingPreviews)
+		Library->ReleasePieceInfo(mParts[PendingIdx].first);
+
+	mPendingPreviews.clear();
+	mPendingThumbnails.clear();
+	mQueuedPreviews.clear();
+	mThumbnailPath.clear();
+	mPreviewGeneration++;
+/*** LPub3D Mod end ***/
 }
 
 void lcPartSelectionListModel::Redraw()
@@ -208,6 +230,12 @@ void lcPartSelectionListModel::SetFilter(const QString& Filter)
 {
 	mFilter = Filter.toLatin1();
 
+/*** LPub3D Mod - part search index ***/
+	std::vector<char> Matches;
+	const bool Indexed = !mFilter.isEmpty() && lcGetPiecesLibrary()->SearchPieces(mFilter, Matches);
+	std::vector<char> Hidden(mParts.size());
+/*** LPub3D Mod end ***/
+
 	for (size_t PartIdx = 0; PartIdx < mParts.size(); PartIdx++)
 	{
 		PieceInfo* Info = mParts[PartIdx].first;
@@ -219,6 +247,10 @@ void lcPartSelectionListModel::SetFilter(const QString& Filter)
 			Visible = false;
 		else if (mFilter.isEmpty())
 			Visible = true;
+/*** LPub3D Mod - part search index ***/
+		else if (Indexed && Info->mSearchIndex >= 0 && Info->mSearchIndex < (int)Matches.size())
+			Visible = Matches[Info->mSearchIndex];
+/*** LPub3D Mod end ***/
 		else
 		{
 			char Description[sizeof(Info->m_strDescription)];
@@ -241,8 +273,20 @@ void lcPartSelectionListModel::SetFilter(const QString& Filter)
 			Visible = strcasestr(Description, mFilter) || strcasestr(Info->mFileName, mFilter);
 		}
 
-		mListView->setRowHidden((int)PartIdx, !Visible);
+/*** LPub3D Mod - part search index ***/
+		Hidden[PartIdx] = !Visible;
 	}
+
+	// Only touch the rows that change and relayout the view once
+	const bool UpdatesEnabled = mListView->updatesEnabled();
+	mListView->setUpdatesEnabled(false);
+
+	for (size_t PartIdx = 0; PartIdx < mParts.size(); PartIdx++)
+		if (mListView->isRowHidden((int)PartIdx) != (bool)Hidden[PartIdx])
+			mListView->setRowHidden((int)PartIdx, Hidden[PartIdx]);
+
+	mListView->setUpdatesEnabled(UpdatesEnabled);
+/*** LPub3D Mod end ***/
 }
 
 int lcPartSelectionListModel::rowCount(const QModelIndex& Parent) const
@@ -307,16 +351,43 @@ void lcPartSelectionListModel::RequestPreview(int InfoIndex)
 	if (!mIconSize || !mParts[InfoIndex].second.isNull())
 		return;
 
-	if (std::find(mRequestedPreviews.begin(), mRequestedPreviews.end(), InfoIndex) != mRequestedPreviews.end())
+/*** LPub3D Mod - part thumbnails ***/
+	if (mQueuedPreviews.find(InfoIndex) != mQueuedPreviews.end())
 		return;
 
+	mQueuedPreviews.insert(InfoIndex);
+
+	lcPartThumbnail Thumbnail;
+	Thumbnail.InfoIndex = InfoIndex;
+	Thumbnail.FileName = GetThumbnailFileName(mParts[InfoIndex].first);
+
+	if (Thumbnail.FileName.isEmpty())
+	{
+		RenderPreview(InfoIndex);
+		return;
+	}
+
+	mPendingThumbnails.push_back(Thumbnail);
+
+	if (!mLoadThumbnailsQueued)
+	{
+		mLoadThumbnailsQueued = true;
+		QMetaObject::invokeMethod(this, "LoadThumbnails", Qt::QueuedConnection);
+	}
+/*** LPub3D Mod end ***/
+}
+
+/*** LPub3D Mod - part thumbnails ***/
+void lcPartSelectionListModel::RenderPreview(int InfoIndex)
+{
 	PieceInfo* Info = mParts[InfoIndex].first;
 	lcGetPiecesLibrary()->LoadPieceInfo(Info, false, false);
 
 	if (Info->mState == LC_PIECEINFO_LOADED)
-		DrawPreview(InfoIndex);
+		QueuePreview(InfoIndex);
 	else
 		mRequestedPreviews.push_back(InfoIndex);
+/*** LPub3D Mod end ***/
 }
 
 void lcPartSelectionListModel::PartLoaded(PieceInfo* Info)
@@ -329,23 +400,105 @@ void lcPartSelectionListModel::PartLoaded(PieceInfo* Info)
 			if (PreviewIt != mRequestedPreviews.end())
 			{
 				mRequestedPreviews.erase(PreviewIt);
-				DrawPreview((int)PartIdx);
+/*** LPub3D Mod - part thumbnails ***/
+				QueuePreview((int)PartIdx);
+/*** LPub3D Mod end ***/
 			}
 			break;
 		}
 	}
 }
 
-void lcPartSelectionListModel::DrawPreview(int InfoIndex)
+/*** LPub3D Mod - part thumbnails ***/
+/*
+ * Previews requested while the list paints are drawn together on the next
+ * pass of the event loop. Each batch renders into the tiles of one atlas
+ * framebuffer and is read back once. The tiles are cut out, scaled and
+ * saved to the thumbnail cache on a worker thread, so a later session
+ * decodes them from disk, also on a worker thread, without rendering.
+ */
+void lcPartSelectionListModel::QueuePreview(int InfoIndex)
 {
+	mPendingPreviews.push_back(InfoIndex);
+
+	if (!mDrawPreviewsQueued)
+	{
+		mDrawPreviewsQueued = true;
+		QMetaObject::invokeMethod(this, "DrawPreviews", Qt::QueuedConnection);
+	}
+}
+
+QString lcPartSelectionListModel::GetThumbnailFileName(PieceInfo* Info)
+{
+	// models and temporary parts change with the project
+	if (Info->IsModel() || Info->IsProject() || Info->IsPlaceholder() || Info->IsTemporary())
+		return QString();
+
+	if (mThumbnailPath.isEmpty())
+	{
+		lcPiecesLibrary* Library = lcGetPiecesLibrary();
+		mThumbnailPath = Library->GetThumbnailCachePath();
+		QDir().mkpath(mThumbnailPath);
+		Library->PruneThumbnailCache(mThumbnailPath);
+	}
+
+	QString PartName = QString::fromLatin1(Info->mFileName).replace('/', '_').replace('\\', '_');
+
+	return QString("%1/%2_%3_%4.png").arg(mThumbnailPath, PartName, QString::number(lcGetColorCode(mColorIndex)), QString::number(mIconSize));
+}
+
+void lcPartSelectionListModel::LoadThumbnails()
+{
+	mLoadThumbnailsQueued = false;
+
+	if (mPendingThumbnails.empty())
+		return;
+
+	lcPartThumbnailBatch Batch;
+	Batch.Generation = mPreviewGeneration;
+	Batch.Thumbnails.swap(mPendingThumbnails);
+
+	QFutureWatcher<lcPartThumbnailBatch>* Watcher = new QFutureWatcher<lcPartThumbnailBatch>(this);
+	connect(Watcher, SIGNAL(finished()), this, SLOT(PreviewsFinished()));
+
+	// a missing or unreadable file leaves a null image and the part is rendered instead
+	Watcher->setFuture(QtConcurrent::run([Batch]() mutable
+	{
+		for (lcPartThumbnail& Thumbnail : Batch.Thumbnails)
+			Thumbnail.Image.load(Thumbnail.FileName);
+
+		return Batch;
+	}));
+}
+
+void lcPartSelectionListModel::DrawPreviews()
+{
+	mDrawPreviewsQueued = false;
+
+	if (mPendingPreviews.empty())
+		return;
+
+	// without a view or framebuffer to draw in, keep the previews pending and try again shortly
+	auto RetryLater = [this]()
+	{
+		mDrawPreviewsQueued = true;
+		QTimer::singleShot(LC_THUMBNAIL_RETRY_DELAY, this, SLOT(DrawPreviews()));
+	};
+
 	View* ActiveView = gMainWindow->GetActiveView();
 	if (!ActiveView)
+	{
+		RetryLater();
 		return;
+	}
 
 	ActiveView->MakeCurrent();
 	lcContext* Context = ActiveView->mContext;
-	int Width = mIconSize * 2;
-	int Height = mIconSize * 2;
+	const int TileSize = mIconSize * 2;
+	const int Columns = qMax(1, LC_THUMBNAIL_ATLAS_SIZE / TileSize);
+	const int Width = Columns * TileSize;
+	const int Height = Columns * TileSize;
+	const size_t TilesPerAtlas = Columns * Columns;
 
 	if (mRenderFramebuffer.first.mWidth != Width || mRenderFramebuffer.first.mHeight != Height)
 	{
@@ -354,51 +507,128 @@ void lcPartSelectionListModel::DrawPreview(int InfoIndex)
 	}
 
 	if (!mRenderFramebuffer.first.IsValid())
+	{
+		RetryLater();
 		return;
+	}
 
-	float Aspect = (float)Width / (float)Height;
-	Context->SetViewport(0, 0, Width, Height);
+	lcPiecesLibrary* Library = lcGetPiecesLibrary();
+	std::vector<int> Previews;
+	Previews.swap(mPendingPreviews);
 
-	Context->SetDefaultState();
-	Context->BindFramebuffer(mRenderFramebuffer.first);
+	for (size_t First = 0; First < Previews.size(); First += TilesPerAtlas)
+	{
+		const size_t Count = qMin(Previews.size() - First, TilesPerAtlas);
 
-	lcPiecesLibrary* Library = lcGetPiecesLibrary();
-	PieceInfo* Info = mParts[InfoIndex].first;
+		Context->SetDefaultState();
+		Context->BindFramebuffer(mRenderFramebuffer.first);
+		Context->SetViewport(0, 0, Width, Height);
+
+		glClearColor(1.0f, 1.0f, 1.0f, 0.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		lcPartThumbnailBatch Batch;
+		Batch.Generation = mPreviewGeneration;
+
+		for (size_t Tile = 0; Tile < Count; Tile++)
+		{
+			const int InfoIndex = Previews[First + Tile];
+			PieceInfo* Info = mParts[InfoIndex].first;
+
+			Context->SetViewport(((int)Tile % Columns) * TileSize, ((int)Tile / Columns) * TileSize, TileSize, TileSize);
+
+			lcMatrix44 ProjectionMatrix, ViewMatrix;
+
+			Info->ZoomExtents(20.0f, 1.0f, ProjectionMatrix, ViewMatrix);
+
+			Context->SetProjectionMatrix(ProjectionMatrix);
+
+			lcScene Scene;
+			Scene.SetAllowWireframe(false);
+			Scene.Begin(ViewMatrix);
 
-	glClearColor(1.0f, 1.0f, 1.0f, 0.0f);
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-		
-	lcMatrix44 ProjectionMatrix, ViewMatrix;
+			Info->AddRenderMeshes(Scene, lcMatrix44Identity(), mColorIndex, lcRenderMeshState::NORMAL, false);
 
-	Info->ZoomExtents(20.0f, Aspect, ProjectionMatrix, ViewMatrix);
+			Scene.End();
 
-	Context->SetProjectionMatrix(ProjectionMatrix);
+			Scene.Draw(Context);
 
-	lcScene Scene;
-	Scene.SetAllowWireframe(false);
-	Scene.Begin(ViewMatrix);
+			lcPartThumbnail Thumbnail;
+			Thumbnail.InfoIndex = InfoIndex;
+			Thumbnail.FileName = GetThumbnailFileName(Info);
+			Batch.Thumbnails.push_back(Thumbnail);
+		}
+
+		const QImage Atlas = Context->GetRenderFramebufferImage(mRenderFramebuffer);
 
-	Info->AddRenderMeshes(Scene, lcMatrix44Identity(), mColorIndex, lcRenderMeshState::NORMAL, false);
+		for (size_t Tile = 0; Tile < Count; Tile++)
+			Library->ReleasePieceInfo(mParts[Previews[First + Tile]].first);
 
-	Scene.End();
+		const int IconSize = mIconSize;
 
-	Scene.Draw(Context);
+		QFutureWatcher<lcPartThumbnailBatch>* Watcher = new QFutureWatcher<lcPartThumbnailBatch>(this);
+		connect(Watcher, SIGNAL(finished()), this, SLOT(PreviewsFinished()));
 
-	mParts[InfoIndex].second = QPixmap::fromImage(Context->GetRenderFramebufferImage(mRenderFramebuffer)).scaled(mIconSize, mIconSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+		Watcher->setFuture(QtConcurrent::run([Atlas, Batch, Columns, TileSize, IconSize]() mutable
+		{
+			for (size_t Tile = 0; Tile < Batch.Thumbnails.size(); Tile++)
+			{
+				lcPartThumbnail& Thumbnail = Batch.Thumbnails[Tile];
 
-	Library->ReleasePieceInfo(Info);
+				// the atlas is filled from the bottom row up and read back top down
+				const int x = ((int)Tile % Columns) * TileSize;
+				const int y = Atlas.height() - ((int)Tile / Columns + 1) * TileSize;
+
+				Thumbnail.Image = Atlas.copy(x, y, TileSize, TileSize).scaled(IconSize, IconSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+
+				if (!Thumbnail.FileName.isEmpty())
+				{
+					QSaveFile File(Thumbnail.FileName);
+
+					if (File.open(QIODevice::WriteOnly) && Thumbnail.Image.save(&File, "PNG"))
+						File.commit();
+				}
+			}
+
+			return Batch;
+		}));
+	}
 
 	Context->ClearFramebuffer();
 	Context->ClearResources();
+}
+
+void lcPartSelectionListModel::PreviewsFinished()
+{
+	QFutureWatcher<lcPartThumbnailBatch>* Watcher = static_cast<QFutureWatcher<lcPartThumbnailBatch>*>(sender());
+	const lcPartThumbnailBatch Batch = Watcher->result();
+	Watcher->deleteLater();
+
+	// the parts list changed while the batch was loaded or scaled
+	if (Batch.Generation != mPreviewGeneration)
+		return;
+
+	for (const lcPartThumbnail& Thumbnail : Batch.Thumbnails)
+	{
+		if (Thumbnail.Image.isNull())
+		{
+			RenderPreview(Thumbnail.InfoIndex);
+			continue;
+		}
+
+		mParts[Thumbnail.InfoIndex].second = QPixmap::fromImage(Thumbnail.Image);
+		mQueuedPreviews.erase(Thumbnail.InfoIndex);
 
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 2, 0))
-	QVector<int> Roles;
-	Roles.append(Qt::DecorationRole);
-	emit dataChanged(index(InfoIndex, 0), index(InfoIndex, 0), Roles);
+		QVector<int> Roles;
+		Roles.append(Qt::DecorationRole);
+		emit dataChanged(index(Thumbnail.InfoIndex, 0), index(Thumbnail.InfoIndex, 0), Roles);
 #else
-	emit dataChanged(index(InfoIndex, 0), index(InfoIndex, 0));
+		emit dataChanged(index(Thumbnail.InfoIndex, 0), index(Thumbnail.InfoIndex, 0));
 #endif
+	}
 }
+/*** LPub3D Mod end ***/
 
 void lcPartSelectionListModel::SetShowDecoratedParts(bool Show)
 {
@@ -425,6 +655,10 @@ void lcPartSelectionListModel::SetIconSize(int Size)
 	if (Size == mIconSize)
 		return;
 
+/*** LPub3D Mod - part thumbnails ***/
+	ClearRequests();
+/*** LPub3D Mod end ***/
+
 	mIconSize = Size;
 
 	beginResetModel();
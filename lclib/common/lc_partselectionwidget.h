@@ -5,6 +5,21 @@
 class lcPartSelectionListModel;
 class lcPartSelectionListView;
 
+/*** LPub3D Mod - part thumbnails ***/
+struct lcPartThumbnail
+{
+	int InfoIndex;
+	QImage Image;
+	QString FileName;
+};
+
+struct lcPartThumbnailBatch
+{
+	int Generation;
+	std::vector<lcPartThumbnail> Thumbnails;
+};
+/*** LPub3D Mod end ***/
+
 class lcPartSelectionItemDelegate : public QStyledItemDelegate
 {
 	Q_OBJECT
@@ -91,10 +106,19 @@ public:
 
 protected slots:
 	void PartLoaded(PieceInfo* Info);
+/*** LPub3D Mod - part thumbnails ***/
+	void LoadThumbnails();
+	void DrawPreviews();
+	void PreviewsFinished();
+/*** LPub3D Mod end ***/
 
 protected:
 	void ClearRequests();
-	void DrawPreview(int InfoIndex);
+/*** LPub3D Mod - part thumbnails ***/
+	void RenderPreview(int InfoIndex);
+	void QueuePreview(int InfoIndex);
+	QString GetThumbnailFileName(PieceInfo* Info);
+/*** LPub3D Mod end ***/
 
 	lcPartSelectionListView* mListView;
 	std::vector<QPair<PieceInfo*, QPixmap>> mParts;
@@ -108,6 +132,15 @@ protected:
 	bool mShowPartAliases;
 	QByteArray mFilter;
 	std::pair<lcFramebuffer, lcFramebuffer> mRenderFramebuffer;
+/*** LPub3D Mod - part thumbnails ***/
+	std::vector<int> mPendingPreviews;
+	std::vector<lcPartThumbnail> mPendingThumbnails;
+	std::set<int> mQueuedPreviews;
+	int mPreviewGeneration;
+	bool mDrawPreviewsQueued;
+	bool mLoadThumbnailsQueued;
+	QString mThumbnailPath;
+/*** LPub3D Mod end ***/
 };
 
 class lcPartSelectionListView : public QListView
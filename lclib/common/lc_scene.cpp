@@ -67,6 +67,30 @@ void lcScene::AddMesh(lcMesh* Mesh, const lcMatrix44& WorldMatrix, int ColorInde
 		mHasTexture = true;
 }
 
+/*** LPub3D Mod - parallel scene ***/
+void lcScene::Merge(const lcScene& Scene)
+{
+	const int Offset = mRenderMeshes.GetSize();
+
+	mRenderMeshes.AllocGrow(Scene.mRenderMeshes.GetSize());
+	for (const lcRenderMesh& RenderMesh : Scene.mRenderMeshes)
+		mRenderMeshes.Add(RenderMesh);
+
+	mOpaqueMeshes.AllocGrow(Scene.mOpaqueMeshes.GetSize());
+	for (int MeshIndex : Scene.mOpaqueMeshes)
+		mOpaqueMeshes.Add(MeshIndex + Offset);
+
+	mTranslucentMeshes.AllocGrow(Scene.mTranslucentMeshes.GetSize());
+	for (int MeshIndex : Scene.mTranslucentMeshes)
+		mTranslucentMeshes.Add(MeshIndex + Offset);
+
+	for (const lcObject* Object : Scene.mInterfaceObjects)
+		mInterfaceObjects.Add(Object);
+
+	mHasTexture |= Scene.mHasTexture;
+}
+/*** LPub3D Mod end ***/
+
 void lcScene::DrawRenderMeshes(lcContext* Context, int PrimitiveTypes, bool EnableNormals, bool DrawTranslucent, bool DrawTextured) const
 {
 	const lcArray<int>& Meshes = DrawTranslucent ? mTranslucentMeshes : mOpaqueMeshes;
@@ -42,6 +42,9 @@ public:
 	void Begin(const lcMatrix44& ViewMatrix);
 	void End();
 	void AddMesh(lcMesh* Mesh, const lcMatrix44& WorldMatrix, int ColorIndex, lcRenderMeshState State);
+/*** LPub3D Mod - parallel scene ***/
+	void Merge(const lcScene& Scene);
+/*** LPub3D Mod end ***/
 
 	void AddInterfaceObject(const lcObject* Object)
 	{
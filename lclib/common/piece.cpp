@@ -14,6 +14,9 @@
 #include "lc_scene.h"
 #include "lc_qutils.h"
 #include "lc_synth.h"
+/*** LPub3D Mod - parallel scene ***/
+#include "lc_model.h"
+/*** LPub3D Mod end ***/
 
 #define LC_PIECE_CONTROL_POINT_SIZE 10.0f
 
@@ -55,6 +58,10 @@ lcPiece::lcPiece(const lcPiece& Other)
 
 lcPiece::~lcPiece()
 {
+/*** LPub3D Mod - parallel scene ***/
+	lcModel::InvalidateSubModelMeshes();
+/*** LPub3D Mod end ***/
+
 	if (mPieceInfo)
 	{
 		lcPiecesLibrary* Library = lcGetPiecesLibrary();
@@ -68,6 +75,10 @@ void lcPiece::SetPieceInfo(PieceInfo* Info, const QString& ID, bool Wait)
 {
 	lcPiecesLibrary* Library = lcGetPiecesLibrary();
 
+/*** LPub3D Mod - parallel scene ***/
+	lcModel::InvalidateSubModelMeshes();
+/*** LPub3D Mod end ***/
+
 	mPieceInfo = Info;
 	if (mPieceInfo)
 		Library->LoadPieceInfo(mPieceInfo, Wait, true);
@@ -698,6 +709,16 @@ void lcPiece::AddSubModelRenderMeshes(lcScene& Scene, const lcMatrix44& WorldMat
 		Scene.AddInterfaceObject(this);
 }
 
+/*** LPub3D Mod - parallel scene ***/
+void lcPiece::GetSubModelMeshes(std::vector<lcModelPartsEntry>& SubModelMeshes) const
+{
+	if (!mMesh)
+		mPieceInfo->GetSubModelMeshes(mModelWorld, mColorIndex, SubModelMeshes);
+	else
+		SubModelMeshes.emplace_back(lcModelPartsEntry{ mModelWorld, mPieceInfo, mMesh, mColorIndex });
+}
+/*** LPub3D Mod end ***/
+
 void lcPiece::MoveSelected(lcStep Step, bool AddKey, const lcVector3& Distance)
 {
 	quint32 Section = GetFocusSection();
@@ -709,6 +730,9 @@ void lcPiece::MoveSelected(lcStep Step, bool AddKey, const lcVector3& Distance)
 		SetPosition(Position, Step, AddKey);
 
 		mModelWorld.SetTranslation(Position);
+/*** LPub3D Mod - parallel scene ***/
+		lcModel::InvalidateSubModelMeshes();
+/*** LPub3D Mod end ***/
 	}
 	else
 	{
@@ -915,11 +939,31 @@ void lcPiece::UpdatePosition(lcStep Step)
 	lcVector3 Position = CalculateKey(mPositionKeys, Step);
 	lcMatrix33 Rotation = CalculateKey(mRotationKeys, Step);
 
-	mModelWorld = lcMatrix44(Rotation, Position);
+/*** LPub3D Mod - parallel scene ***/
+	const lcMatrix44 ModelWorld(Rotation, Position);
+
+	// Drags, key edits and step changes all land here, only moved pieces invalidate the flattened submodels
+	if (memcmp(&ModelWorld, &mModelWorld, sizeof(lcMatrix44)))
+	{
+		mModelWorld = ModelWorld;
+		lcModel::InvalidateSubModelMeshes();
+	}
+/*** LPub3D Mod end ***/
 }
 
+/*** LPub3D Mod - parallel scene ***/
+void lcPiece::InvalidateSubModelMeshes()
+{
+	lcModel::InvalidateSubModelMeshes();
+}
+/*** LPub3D Mod end ***/
+
 void lcPiece::UpdateMesh()
 {
+/*** LPub3D Mod - parallel scene ***/
+	if (mMesh)
+		lcModel::InvalidateSubModelMeshes();
+/*** LPub3D Mod end ***/
 	delete mMesh;
 	lcSynthInfo* SynthInfo = mPieceInfo->GetSynthInfo();
 	mMesh = SynthInfo ? SynthInfo->CreateMesh(mControlPoints) : nullptr;
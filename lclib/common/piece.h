@@ -349,6 +349,10 @@ public:
 
 	void AddMainModelRenderMeshes(lcScene& Scene, bool Highlight) const;
 	void AddSubModelRenderMeshes(lcScene& Scene, const lcMatrix44& WorldMatrix, int DefaultColorIndex, lcRenderMeshState RenderMeshState, bool ParentActive) const;
+/*** LPub3D Mod - parallel scene ***/
+	void GetSubModelMeshes(std::vector<lcModelPartsEntry>& SubModelMeshes) const;
+	static void InvalidateSubModelMeshes();
+/*** LPub3D Mod end ***/
 
 	void InsertTime(lcStep Start, lcStep Time);
 	void RemoveTime(lcStep Start, lcStep Time);
@@ -360,6 +364,11 @@ public:
 
 	void SetHidden(bool Hidden)
 	{
+/*** LPub3D Mod - parallel scene ***/
+		if (Hidden != IsHidden())
+			InvalidateSubModelMeshes();
+/*** LPub3D Mod end ***/
+
 		if (Hidden)
 			mState |= LC_PIECE_HIDDEN;
 		else
@@ -439,6 +448,11 @@ public:
 		if (Step < 2)
 			Step = 2;
 
+/*** LPub3D Mod - parallel scene ***/
+		if (mStepHide != Step)
+			InvalidateSubModelMeshes();
+/*** LPub3D Mod end ***/
+
 		mStepHide = Step;
 
 		if (mStepHide <= mStepShow)
@@ -457,17 +471,28 @@ public:
 		}
 
 		if (mStepHide <= mStepShow)
+		{
+/*** LPub3D Mod - parallel scene ***/
+			InvalidateSubModelMeshes();
+/*** LPub3D Mod end ***/
 			mStepHide = mStepShow + 1;
+		}
 	}
 
 	void SetColorCode(quint32 ColorCode)
 	{
+/*** LPub3D Mod - parallel scene ***/
+		InvalidateSubModelMeshes();
+/*** LPub3D Mod end ***/
 		mColorCode = ColorCode;
 		mColorIndex = lcGetColorIndex(ColorCode);
 	}
 
 	void SetColorIndex(int ColorIndex)
 	{
+/*** LPub3D Mod - parallel scene ***/
+		InvalidateSubModelMeshes();
+/*** LPub3D Mod end ***/
 		mColorIndex = ColorIndex;
 		mColorCode = lcGetColorCode(ColorIndex);
 	}
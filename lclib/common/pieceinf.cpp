@@ -25,6 +25,9 @@ PieceInfo::PieceInfo()
 	mModel = nullptr;
 	mProject = nullptr;
 	mSynthInfo = nullptr;
+/*** LPub3D Mod - part search index ***/
+	mSearchIndex = -1;
+/*** LPub3D Mod end ***/
 }
 
 PieceInfo::~PieceInfo()
@@ -320,6 +323,30 @@ void PieceInfo::AddRenderMeshes(lcScene& Scene, const lcMatrix44& WorldMatrix, i
 	}
 }
 
+/*** LPub3D Mod - parallel scene ***/
+void PieceInfo::GetSubModelMeshes(const lcMatrix44& WorldMatrix, int ColorIndex, std::vector<lcModelPartsEntry>& SubModelMeshes) const
+{
+	if (mMesh || IsPlaceholder())
+		SubModelMeshes.emplace_back(lcModelPartsEntry{ WorldMatrix, this, IsPlaceholder() ? gPlaceholderMesh : mMesh, ColorIndex });
+
+	const lcModel* Model = nullptr;
+
+	if (IsModel())
+		Model = mModel;
+	else if (IsProject())
+		Model = mProject->GetMainModel();
+
+	if (!Model)
+		return;
+
+	for (const lcModelPartsEntry& SubModelMesh : Model->GetSubModelMeshes())
+	{
+		int SubColorIndex = SubModelMesh.ColorIndex == gDefaultColor ? ColorIndex : SubModelMesh.ColorIndex;
+		SubModelMeshes.emplace_back(lcModelPartsEntry{ lcMul(SubModelMesh.WorldMatrix, WorldMatrix), SubModelMesh.Info, SubModelMesh.Mesh, SubColorIndex });
+	}
+}
+/*** LPub3D Mod end ***/
+
 void PieceInfo::GetPartsList(int DefaultColorIndex, bool IncludeSubmodels, lcPartsList& PartsList) const
 {
 	if (IsModel() && IncludeSubmodels)
@@ -151,6 +151,9 @@ public:
 	void ZoomExtents(float FoV, float AspectRatio, lcMatrix44& ProjectionMatrix, lcMatrix44& ViewMatrix) const;
 	void AddRenderMesh(lcScene& Scene);
 	void AddRenderMeshes(lcScene& Scene, const lcMatrix44& WorldMatrix, int ColorIndex, lcRenderMeshState RenderMeshState, bool ParentActive) const;
+/*** LPub3D Mod - parallel scene ***/
+	void GetSubModelMeshes(const lcMatrix44& WorldMatrix, int ColorIndex, std::vector<lcModelPartsEntry>& SubModelMeshes) const;
+/*** LPub3D Mod end ***/
 
 	void CreatePlaceholder(const char* Name);
 
@@ -173,6 +176,9 @@ public:
 	char m_strDescription[128];
 /*** LPub3D Mod 166 - part type check ***/
 	int m_iPartType;
+/*** LPub3D Mod end ***/
+/*** LPub3D Mod - part search index ***/
+	int mSearchIndex;
 /*** LPub3D Mod end ***/
 	int mZipFileType;
 	int mZipFileIndex;
@@ -18,6 +18,9 @@
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
 #include <QtConcurrent>
 #endif
+/*** LPub3D Mod - glTF export ***/
+#include <QtEndian>
+/*** LPub3D Mod end ***/
 /*** LPub3D Mod - Include ***/
 #include "lpub.h"
 #include "annotations.h"
@@ -1205,6 +1208,60 @@ void Project::ExportBrickLink()
 	BrickLinkFile.WriteLine("</INVENTORY>\n");
 }
 
+/*** LPub3D Mod - buffered exporters ***/
+static void lcResetExportBuffer(lcMemFile& Buffer)
+{
+	Buffer.mGrowBytes = 64 * 1024;
+	Buffer.SetLength(0);
+}
+
+static void lcResetExportBuffer(QString& Buffer)
+{
+	Buffer.resize(0);
+}
+
+// Formats NumBlocks export blocks on the thread pool and writes them in
+// order. Consecutive blocks are formatted in runs, each into its own buffer,
+// and a bounded window of runs is kept in flight so the calling thread writes
+// finished runs while the following ones are still being formatted.
+template<typename BufferType>
+static void lcWriteExportBlocks(size_t NumBlocks, const std::function<void(size_t, BufferType&)>& FormatBlock, const std::function<void(const BufferType&)>& WriteBuffer)
+{
+	const size_t BlocksPerRun = 16;
+	const size_t NumRuns = (NumBlocks + BlocksPerRun - 1) / BlocksPerRun;
+	const size_t WindowSize = qMax(QThread::idealThreadCount(), 1) * 2;
+
+	std::vector<BufferType> Buffers(WindowSize);
+	std::vector<QFuture<void>> Runs(WindowSize);
+
+	auto StartRun = [&](size_t RunIdx)
+	{
+		BufferType& Buffer = Buffers[RunIdx % WindowSize];
+		lcResetExportBuffer(Buffer);
+
+		Runs[RunIdx % WindowSize] = QtConcurrent::run([&FormatBlock, &Buffer, RunIdx, BlocksPerRun, NumBlocks]()
+		{
+			const size_t EndBlock = qMin((RunIdx + 1) * BlocksPerRun, NumBlocks);
+
+			for (size_t BlockIdx = RunIdx * BlocksPerRun; BlockIdx < EndBlock; BlockIdx++)
+				FormatBlock(BlockIdx, Buffer);
+		});
+	};
+
+	for (size_t RunIdx = 0; RunIdx < qMin(NumRuns, WindowSize); RunIdx++)
+		StartRun(RunIdx);
+
+	for (size_t RunIdx = 0; RunIdx < NumRuns; RunIdx++)
+	{
+		Runs[RunIdx % WindowSize].waitForFinished();
+		WriteBuffer(Buffers[RunIdx % WindowSize]);
+
+		if (RunIdx + WindowSize < NumRuns)
+			StartRun(RunIdx + WindowSize);
+	}
+}
+/*** LPub3D Mod end ***/
+
 void Project::ExportCOLLADA(const QString& FileName)
 {
 	std::vector<lcModelPartsEntry> ModelParts = GetModelParts();
@@ -1296,8 +1353,7 @@ void Project::ExportCOLLADA(const QString& FileName)
 
 	Stream << "</library_materials>\r\n";
 	Stream << "<library_geometries>\r\n";
-	std::set<lcMesh*> AddedMeshes;
-
+/*** LPub3D Mod - buffered exporters ***/
 	auto GetMeshID = [](const lcModelPartsEntry& ModelPart)
 	{
 		const PieceInfo* Info = ModelPart.Info;
@@ -1309,6 +1365,25 @@ void Project::ExportCOLLADA(const QString& FileName)
 		return ID;
 	};
 
+	auto WriteBuffer = [&Stream](const QString& Buffer)
+	{
+		Stream << Buffer;
+	};
+
+	auto AppendVector = [](QString& Buffer, const lcVector3& Vector)
+	{
+		Buffer += QLatin1String("\t\t\t\t\t");
+		Buffer += QString::number(Vector.x);
+		Buffer += QLatin1Char(' ');
+		Buffer += QString::number(Vector.y);
+		Buffer += QLatin1Char(' ');
+		Buffer += QString::number(Vector.z);
+		Buffer += QLatin1String("\r\n");
+	};
+
+	std::set<lcMesh*> AddedMeshes;
+	std::vector<std::pair<lcMesh*, QString>> Geometries;
+
 	for (const lcModelPartsEntry& ModelPart : ModelParts)
 	{
 		lcMesh* Mesh = !ModelPart.Mesh ? ModelPart.Info->GetMesh() : ModelPart.Mesh;
@@ -1316,142 +1391,129 @@ void Project::ExportCOLLADA(const QString& FileName)
 		if (!AddedMeshes.insert(Mesh).second)
 			continue;
 
-		QString ID = GetMeshID(ModelPart);
+		Geometries.emplace_back(Mesh ? Mesh : gPlaceholderMesh, GetMeshID(ModelPart));
+	}
 
-		if (!Mesh)
-			Mesh = gPlaceholderMesh;
+	lcWriteExportBlocks<QString>(Geometries.size(), [&Geometries, &AppendVector](size_t GeometryIdx, QString& Buffer)
+	{
+		const lcMesh* Mesh = Geometries[GeometryIdx].first;
+		const QString& ID = Geometries[GeometryIdx].second;
 
-		Stream << QString("\t<geometry id=\"%1\">\r\n").arg(ID);
-		Stream << "\t\t<mesh>\r\n";
+		Buffer += QString("\t<geometry id=\"%1\">\r\n").arg(ID);
+		Buffer += "\t\t<mesh>\r\n";
 
-		Stream << QString("\t\t\t<source id=\"%1-pos\">\r\n").arg(ID);
-		Stream << QString("\t\t\t\t<float_array id=\"%1-pos-array\" count=\"%2\">\r\n").arg(ID, QString::number(Mesh->mNumVertices));
+		Buffer += QString("\t\t\t<source id=\"%1-pos\">\r\n").arg(ID);
+		Buffer += QString("\t\t\t\t<float_array id=\"%1-pos-array\" count=\"%2\">\r\n").arg(ID, QString::number(Mesh->mNumVertices));
 
-		lcVertex* Verts = (lcVertex*)Mesh->mVertexData;
+		const lcVertex* Verts = (const lcVertex*)Mesh->mVertexData;
 
 		for (int VertexIdx = 0; VertexIdx < Mesh->mNumVertices; VertexIdx++)
-		{
-			lcVector3& Position = Verts[VertexIdx].Position;
-			Stream << QString("\t\t\t\t\t%1 %2 %3\r\n").arg(QString::number(Position.x), QString::number(Position.y), QString::number(Position.z));
-		}
+			AppendVector(Buffer, Verts[VertexIdx].Position);
 
-		Stream << "\t\t\t\t</float_array>\r\n";
-		Stream << "\t\t\t\t<technique_common>\r\n";
-		Stream << QString("\t\t\t\t\t<accessor source=\"#%1-pos-array\" count=\"%2\" stride=\"3\">\r\n").arg(ID, QString::number(Mesh->mNumVertices));
-		Stream << "\t\t\t\t\t\t<param name=\"X\" type=\"float\" />\r\n";
-		Stream << "\t\t\t\t\t\t<param name=\"Y\" type=\"float\" />\r\n";
-		Stream << "\t\t\t\t\t\t<param name=\"Z\" type=\"float\" />\r\n";
-		Stream << "\t\t\t\t\t</accessor>\r\n";
-		Stream << "\t\t\t\t</technique_common>\r\n";
-		Stream << "\t\t\t</source>\r\n";
+		Buffer += "\t\t\t\t</float_array>\r\n";
+		Buffer += "\t\t\t\t<technique_common>\r\n";
+		Buffer += QString("\t\t\t\t\t<accessor source=\"#%1-pos-array\" count=\"%2\" stride=\"3\">\r\n").arg(ID, QString::number(Mesh->mNumVertices));
+		Buffer += "\t\t\t\t\t\t<param name=\"X\" type=\"float\" />\r\n";
+		Buffer += "\t\t\t\t\t\t<param name=\"Y\" type=\"float\" />\r\n";
+		Buffer += "\t\t\t\t\t\t<param name=\"Z\" type=\"float\" />\r\n";
+		Buffer += "\t\t\t\t\t</accessor>\r\n";
+		Buffer += "\t\t\t\t</technique_common>\r\n";
+		Buffer += "\t\t\t</source>\r\n";
 
-		Stream << QString("\t\t\t<source id=\"%1-normal\">\r\n").arg(ID);
-		Stream << QString("\t\t\t\t<float_array id=\"%1-normal-array\" count=\"%2\">\r\n").arg(ID, QString::number(Mesh->mNumVertices));
+		Buffer += QString("\t\t\t<source id=\"%1-normal\">\r\n").arg(ID);
+		Buffer += QString("\t\t\t\t<float_array id=\"%1-normal-array\" count=\"%2\">\r\n").arg(ID, QString::number(Mesh->mNumVertices));
 
 		for (int VertexIdx = 0; VertexIdx < Mesh->mNumVertices; VertexIdx++)
-		{
-			lcVector3 Normal = lcUnpackNormal(Verts[VertexIdx].Normal);
-			Stream << QString("\t\t\t\t\t%1 %2 %3\r\n").arg(QString::number(Normal.x), QString::number(Normal.y), QString::number(Normal.z));
-		}
-
-		Stream << "\t\t\t\t</float_array>\r\n";
-		Stream << "\t\t\t\t<technique_common>\r\n";
-		Stream << QString("\t\t\t\t\t<accessor source=\"#%1-normal-array\" count=\"%2\" stride=\"3\">\r\n").arg(ID, QString::number(Mesh->mNumVertices));
-		Stream << "\t\t\t\t\t\t<param name=\"X\" type=\"float\" />\r\n";
-		Stream << "\t\t\t\t\t\t<param name=\"Y\" type=\"float\" />\r\n";
-		Stream << "\t\t\t\t\t\t<param name=\"Z\" type=\"float\" />\r\n";
-		Stream << "\t\t\t\t\t</accessor>\r\n";
-		Stream << "\t\t\t\t</technique_common>\r\n";
-		Stream << "\t\t\t</source>\r\n";
-
-		Stream << QString("\t\t\t<vertices id=\"%1-vertices\">\r\n").arg(ID);
-		Stream << QString("\t\t\t\t<input semantic=\"POSITION\" source=\"#%1-pos\"/>\r\n").arg(ID);
-		Stream << "\t\t\t</vertices>\r\n";
+			AppendVector(Buffer, lcUnpackNormal(Verts[VertexIdx].Normal));
+
+		Buffer += "\t\t\t\t</float_array>\r\n";
+		Buffer += "\t\t\t\t<technique_common>\r\n";
+		Buffer += QString("\t\t\t\t\t<accessor source=\"#%1-normal-array\" count=\"%2\" stride=\"3\">\r\n").arg(ID, QString::number(Mesh->mNumVertices));
+		Buffer += "\t\t\t\t\t\t<param name=\"X\" type=\"float\" />\r\n";
+		Buffer += "\t\t\t\t\t\t<param name=\"Y\" type=\"float\" />\r\n";
+		Buffer += "\t\t\t\t\t\t<param name=\"Z\" type=\"float\" />\r\n";
+		Buffer += "\t\t\t\t\t</accessor>\r\n";
+		Buffer += "\t\t\t\t</technique_common>\r\n";
+		Buffer += "\t\t\t</source>\r\n";
+
+		Buffer += QString("\t\t\t<vertices id=\"%1-vertices\">\r\n").arg(ID);
+		Buffer += QString("\t\t\t\t<input semantic=\"POSITION\" source=\"#%1-pos\"/>\r\n").arg(ID);
+		Buffer += "\t\t\t</vertices>\r\n";
 
 		for (int SectionIdx = 0; SectionIdx < Mesh->mLods[LC_MESH_LOD_HIGH].NumSections; SectionIdx++)
 		{
-			lcMeshSection* Section = &Mesh->mLods[LC_MESH_LOD_HIGH].Sections[SectionIdx];
+			const lcMeshSection* Section = &Mesh->mLods[LC_MESH_LOD_HIGH].Sections[SectionIdx];
 
 			if (Section->PrimitiveType != LC_MESH_TRIANGLES && Section->PrimitiveType != LC_MESH_TEXTURED_TRIANGLES)
 				continue;
 
 			const char* ColorName = gColorList[Section->ColorIndex].SafeName;
 
-			if (Mesh->mIndexType == GL_UNSIGNED_SHORT)
-			{
-				quint16* Indices = (quint16*)Mesh->mIndexData + Section->IndexOffset / sizeof(quint16);
-
-				Stream << QString("\t\t\t<triangles count=\"%1\" material=\"%2\">\r\n").arg(QString::number(Section->NumIndices / 3), ColorName);
-				Stream << QString("\t\t\t<input semantic=\"VERTEX\" source=\"#%1-vertices\" offset=\"0\" />\r\n").arg(ID);
-				Stream << QString("\t\t\t<input semantic=\"NORMAL\" source=\"#%1-normal\" offset=\"0\" />\r\n").arg(ID);
-				Stream << "\t\t\t<p>\r\n";
-
-				for (int Idx = 0; Idx < Section->NumIndices; Idx += 3)
-				{
-					QString idx1 = QString::number(Indices[Idx + 0]);
-					QString idx2 = QString::number(Indices[Idx + 1]);
-					QString idx3 = QString::number(Indices[Idx + 2]);
+			Buffer += QString("\t\t\t<triangles count=\"%1\" material=\"%2\">\r\n").arg(QString::number(Section->NumIndices / 3), ColorName);
+			Buffer += QString("\t\t\t<input semantic=\"VERTEX\" source=\"#%1-vertices\" offset=\"0\" />\r\n").arg(ID);
+			Buffer += QString("\t\t\t<input semantic=\"NORMAL\" source=\"#%1-normal\" offset=\"0\" />\r\n").arg(ID);
+			Buffer += "\t\t\t<p>\r\n";
 
-					Stream << QString("\t\t\t\t %1 %2 %3\r\n").arg(idx1, idx2, idx3);
-				}
-			}
-			else
+			for (int Idx = 0; Idx < Section->NumIndices; Idx += 3)
 			{
-				quint32* Indices = (quint32*)Mesh->mIndexData + Section->IndexOffset / sizeof(quint32);
-
-				Stream << QString("\t\t\t<triangles count=\"%1\" material=\"%2\">\r\n").arg(QString::number(Section->NumIndices / 3), ColorName);
-				Stream << QString("\t\t\t<input semantic=\"VERTEX\" source=\"#%1-vertices\" offset=\"0\" />\r\n").arg(ID);
-				Stream << QString("\t\t\t<input semantic=\"NORMAL\" source=\"#%1-normal\" offset=\"0\" />\r\n").arg(ID);
-				Stream << "\t\t\t<p>\r\n";
+				quint32 Indices[3];
 
-				for (int Idx = 0; Idx < Section->NumIndices; Idx += 3)
+				for (int Corner = 0; Corner < 3; Corner++)
 				{
-					QString idx1 = QString::number(Indices[Idx + 0]);
-					QString idx2 = QString::number(Indices[Idx + 1]);
-					QString idx3 = QString::number(Indices[Idx + 2]);
-
-					Stream << QString("\t\t\t\t %1 %2 %3\r\n").arg(idx1, idx2, idx3);
+					if (Mesh->mIndexType == GL_UNSIGNED_SHORT)
+						Indices[Corner] = ((const quint16*)Mesh->mIndexData)[Section->IndexOffset / sizeof(quint16) + Idx + Corner];
+					else
+						Indices[Corner] = ((const quint32*)Mesh->mIndexData)[Section->IndexOffset / sizeof(quint32) + Idx + Corner];
 				}
+
+				Buffer += QLatin1String("\t\t\t\t ");
+				Buffer += QString::number(Indices[0]);
+				Buffer += QLatin1Char(' ');
+				Buffer += QString::number(Indices[1]);
+				Buffer += QLatin1Char(' ');
+				Buffer += QString::number(Indices[2]);
+				Buffer += QLatin1String("\r\n");
 			}
 
-			Stream << "\t\t\t\t</p>\r\n";
-			Stream << "\t\t\t</triangles>\r\n";
+			Buffer += "\t\t\t\t</p>\r\n";
+			Buffer += "\t\t\t</triangles>\r\n";
 		}
 
-		Stream << "\t\t</mesh>\r\n";
-		Stream << "\t</geometry>\r\n";
-	}
+		Buffer += "\t\t</mesh>\r\n";
+		Buffer += "\t</geometry>\r\n";
+	}, WriteBuffer);
 
 	Stream << "</library_geometries>\r\n";
 	Stream << "<library_visual_scenes>\r\n";
 	Stream << "\t<visual_scene id=\"DefaultScene\">\r\n";
 
-	for (const lcModelPartsEntry& ModelPart : ModelParts)
+	lcWriteExportBlocks<QString>(ModelParts.size(), [&ModelParts, &GetMeshID](size_t PartIdx, QString& Buffer)
 	{
+		const lcModelPartsEntry& ModelPart = ModelParts[PartIdx];
 		QString ID = GetMeshID(ModelPart);
 
-		Stream << "\t\t<node>\r\n";
-		Stream << "\t\t\t<matrix>\r\n";
+		Buffer += "\t\t<node>\r\n";
+		Buffer += "\t\t\t<matrix>\r\n";
 
 		const lcMatrix44& Matrix = ModelPart.WorldMatrix;
-		Stream << QString("\t\t\t\t%1 %2 %3 %4\r\n").arg(QString::number(Matrix[0][0]), QString::number(Matrix[1][0]), QString::number(Matrix[2][0]), QString::number(Matrix[3][0]));
-		Stream << QString("\t\t\t\t%1 %2 %3 %4\r\n").arg(QString::number(Matrix[0][1]), QString::number(Matrix[1][1]), QString::number(Matrix[2][1]), QString::number(Matrix[3][1]));
-		Stream << QString("\t\t\t\t%1 %2 %3 %4\r\n").arg(QString::number(Matrix[0][2]), QString::number(Matrix[1][2]), QString::number(Matrix[2][2]), QString::number(Matrix[3][2]));
-		Stream << QString("\t\t\t\t%1 %2 %3 %4\r\n").arg(QString::number(Matrix[0][3]), QString::number(Matrix[1][3]), QString::number(Matrix[2][3]), QString::number(Matrix[3][3]));
+		Buffer += QString("\t\t\t\t%1 %2 %3 %4\r\n").arg(QString::number(Matrix[0][0]), QString::number(Matrix[1][0]), QString::number(Matrix[2][0]), QString::number(Matrix[3][0]));
+		Buffer += QString("\t\t\t\t%1 %2 %3 %4\r\n").arg(QString::number(Matrix[0][1]), QString::number(Matrix[1][1]), QString::number(Matrix[2][1]), QString::number(Matrix[3][1]));
+		Buffer += QString("\t\t\t\t%1 %2 %3 %4\r\n").arg(QString::number(Matrix[0][2]), QString::number(Matrix[1][2]), QString::number(Matrix[2][2]), QString::number(Matrix[3][2]));
+		Buffer += QString("\t\t\t\t%1 %2 %3 %4\r\n").arg(QString::number(Matrix[0][3]), QString::number(Matrix[1][3]), QString::number(Matrix[2][3]), QString::number(Matrix[3][3]));
 
-		Stream << "\t\t\t</matrix>\r\n";
-		Stream << QString("\t\t\t<instance_geometry url=\"#%1\">\r\n").arg(ID);
-		Stream << "\t\t\t\t<bind_material>\r\n";
-		Stream << "\t\t\t\t\t<technique_common>\r\n";
+		Buffer += "\t\t\t</matrix>\r\n";
+		Buffer += QString("\t\t\t<instance_geometry url=\"#%1\">\r\n").arg(ID);
+		Buffer += "\t\t\t\t<bind_material>\r\n";
+		Buffer += "\t\t\t\t\t<technique_common>\r\n";
 
-		lcMesh* Mesh = !ModelPart.Mesh ? ModelPart.Info->GetMesh() : ModelPart.Mesh;
+		const lcMesh* Mesh = !ModelPart.Mesh ? ModelPart.Info->GetMesh() : ModelPart.Mesh;
 
 		if (!Mesh)
 			Mesh = gPlaceholderMesh;
 
 		for (int SectionIdx = 0; SectionIdx < Mesh->mLods[LC_MESH_LOD_HIGH].NumSections; SectionIdx++)
 		{
-			lcMeshSection* Section = &Mesh->mLods[LC_MESH_LOD_HIGH].Sections[SectionIdx];
+			const lcMeshSection* Section = &Mesh->mLods[LC_MESH_LOD_HIGH].Sections[SectionIdx];
 
 			if (Section->PrimitiveType != LC_MESH_TRIANGLES && Section->PrimitiveType != LC_MESH_TEXTURED_TRIANGLES)
 				continue;
@@ -1463,14 +1525,15 @@ void Project::ExportCOLLADA(const QString& FileName)
 			else
 				TargetColorName = gColorList[Section->ColorIndex].SafeName;
 
-			Stream << QString("\t\t\t\t\t\t<instance_material symbol=\"%1\" target=\"#%2-material\"/>\r\n").arg(SourceColorName, TargetColorName);
+			Buffer += QString("\t\t\t\t\t\t<instance_material symbol=\"%1\" target=\"#%2-material\"/>\r\n").arg(SourceColorName, TargetColorName);
 		}
 
-		Stream << "\t\t\t\t\t</technique_common>\r\n";
-		Stream << "\t\t\t\t</bind_material>\r\n";
-		Stream << "\t\t\t</instance_geometry>\r\n";
-		Stream << "\t\t</node>\r\n";
-	}
+		Buffer += "\t\t\t\t\t</technique_common>\r\n";
+		Buffer += "\t\t\t\t</bind_material>\r\n";
+		Buffer += "\t\t\t</instance_geometry>\r\n";
+		Buffer += "\t\t</node>\r\n";
+	}, WriteBuffer);
+/*** LPub3D Mod end ***/
 
 	Stream << "\t</visual_scene>\r\n";
 	Stream << "</library_visual_scenes>\r\n";
@@ -1782,6 +1845,298 @@ void Project::CreateHTMLPieceList(QTextStream& Stream, lcModel* Model, lcStep St
 	Stream << QLatin1String("</table>\r\n<br>");
 }
 
+/*** LPub3D Mod - glTF export ***/
+/*
+ * Write the model as a binary glTF 2.0 file. Each part mesh is written to
+ * the binary buffer once and every placed piece becomes a node that
+ * references it with its world matrix, so repeated parts cost one node
+ * each. Sections drawn in the default colour take the colour of the
+ * piece, so a mesh that has them gets one glTF mesh per colour it is used
+ * in, all sharing the same accessors. Textures and texture coordinates are
+ * not written, textured sections are exported in their colour only.
+ */
+bool Project::ExportGLTF(const QString& FileName)
+{
+	std::vector<lcModelPartsEntry> ModelParts = GetModelParts();
+
+	if (ModelParts.empty())
+	{
+		QMessageBox::information(gMainWindow, tr("3DViewer"), tr("Nothing to export."));
+		return false;
+	}
+
+	QString SaveFileName = GetExportFileName(FileName, QLatin1String("glb"), tr("Export glTF"), tr("glTF Binary Files (*.glb);;All Files (*.*)"));
+
+	if (SaveFileName.isEmpty())
+		return false;
+
+	enum
+	{
+		GLTF_ARRAY_BUFFER = 34962,
+		GLTF_ELEMENT_ARRAY_BUFFER = 34963,
+		GLTF_UNSIGNED_SHORT = 5123,
+		GLTF_UNSIGNED_INT = 5125,
+		GLTF_FLOAT = 5126
+	};
+
+	struct lcGLTFMesh
+	{
+		int Positions[2];
+		int Normals[2];
+		int IndexBufferView;
+	};
+
+	QByteArray Buffer;
+	QJsonArray BufferViews, Accessors, Meshes, Materials, Nodes, SceneNodes;
+	std::map<lcMesh*, lcGLTFMesh> MeshBuffers;
+	std::map<std::pair<lcMesh*, int>, int> MeshIndices;
+	std::map<int, int> MaterialIndices;
+
+	auto AddBufferView = [&Buffer, &BufferViews](const void* Data, int Size, int Target)
+	{
+		while (Buffer.size() % 4)
+			Buffer.append('\0');
+
+		QJsonObject BufferView;
+		BufferView["buffer"] = 0;
+		BufferView["byteOffset"] = Buffer.size();
+		BufferView["byteLength"] = Size;
+		BufferView["target"] = Target;
+		BufferViews.append(BufferView);
+
+		Buffer.append((const char*)Data, Size);
+
+		return BufferViews.size() - 1;
+	};
+
+	auto AddAccessor = [&Accessors](int BufferView, int ByteOffset, int ComponentType, int Count, const char* Type)
+	{
+		QJsonObject Accessor;
+		Accessor["bufferView"] = BufferView;
+		Accessor["byteOffset"] = ByteOffset;
+		Accessor["componentType"] = ComponentType;
+		Accessor["count"] = Count;
+		Accessor["type"] = QLatin1String(Type);
+		Accessors.append(Accessor);
+
+		return Accessors.size() - 1;
+	};
+
+	// Positions and unpacked normals of the plain and textured vertices
+	auto AddVertices = [&](const lcVertex* Vertices, int Stride, int NumVertices, int& Positions, int& Normals)
+	{
+		Positions = Normals = -1;
+
+		if (!NumVertices)
+			return;
+
+		std::vector<lcVector3> Data(NumVertices * 2);
+		lcVector3 Min(FLT_MAX, FLT_MAX, FLT_MAX), Max(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+		for (int VertexIdx = 0; VertexIdx < NumVertices; VertexIdx++)
+		{
+			const lcVertex* Vertex = (const lcVertex*)((const char*)Vertices + VertexIdx * Stride);
+
+			const lcVector3 Normal = lcUnpackNormal(Vertex->Normal);
+			const float Length = lcLength(Normal);
+
+			Data[VertexIdx] = Vertex->Position;
+			Data[NumVertices + VertexIdx] = Length > 0.0f ? Normal / Length : lcVector3(0.0f, 0.0f, 1.0f);
+			Min = lcMin(Min, Vertex->Position);
+			Max = lcMax(Max, Vertex->Position);
+		}
+
+		const int BufferView = AddBufferView(Data.data(), (int)(Data.size() * sizeof(lcVector3)), GLTF_ARRAY_BUFFER);
+
+		Positions = AddAccessor(BufferView, 0, GLTF_FLOAT, NumVertices, "VEC3");
+		Normals = AddAccessor(BufferView, NumVertices * (int)sizeof(lcVector3), GLTF_FLOAT, NumVertices, "VEC3");
+
+		QJsonObject Accessor = Accessors[Positions].toObject();
+		Accessor["min"] = QJsonArray({ Min.x, Min.y, Min.z });
+		Accessor["max"] = QJsonArray({ Max.x, Max.y, Max.z });
+		Accessors[Positions] = Accessor;
+	};
+
+	auto GetMaterial = [&Materials, &MaterialIndices](int ColorIndex)
+	{
+		const auto MaterialIt = MaterialIndices.find(ColorIndex);
+
+		if (MaterialIt != MaterialIndices.end())
+			return MaterialIt->second;
+
+		const lcColor& Color = gColorList[ColorIndex];
+
+		QJsonObject PBR;
+		PBR["baseColorFactor"] = QJsonArray({ Color.Value[0], Color.Value[1], Color.Value[2], Color.Value[3] });
+		PBR["metallicFactor"] = 0.0;
+		PBR["roughnessFactor"] = 0.5;
+
+		QJsonObject Material;
+		Material["name"] = QString::fromLatin1(Color.SafeName);
+		Material["pbrMetallicRoughness"] = PBR;
+		Material["doubleSided"] = true;
+
+		if (Color.Translucent)
+			Material["alphaMode"] = QLatin1String("BLEND");
+
+		Materials.append(Material);
+
+		return MaterialIndices[ColorIndex] = Materials.size() - 1;
+	};
+
+	for (const lcModelPartsEntry& ModelPart : ModelParts)
+	{
+		lcMesh* Mesh = !ModelPart.Mesh ? ModelPart.Info->GetMesh() : ModelPart.Mesh;
+
+		if (!Mesh)
+			Mesh = gPlaceholderMesh;
+
+		const bool HasDefault = (Mesh->mFlags & lcMeshFlag::HasDefault);
+		const std::pair<lcMesh*, int> MeshKey(Mesh, HasDefault ? ModelPart.ColorIndex : -1);
+		auto MeshIt = MeshIndices.find(MeshKey);
+
+		if (MeshIt == MeshIndices.end())
+		{
+			auto BufferIt = MeshBuffers.find(Mesh);
+
+			if (BufferIt == MeshBuffers.end())
+			{
+				lcGLTFMesh MeshBuffer;
+				const lcVertex* Vertices = (const lcVertex*)Mesh->mVertexData;
+				const lcVertex* TexturedVertices = (const lcVertex*)((const lcVertex*)Mesh->mVertexData + Mesh->mNumVertices);
+
+				AddVertices(Vertices, sizeof(lcVertex), Mesh->mNumVertices, MeshBuffer.Positions[0], MeshBuffer.Normals[0]);
+				AddVertices(TexturedVertices, sizeof(lcVertexTextured), Mesh->mNumTexturedVertices, MeshBuffer.Positions[1], MeshBuffer.Normals[1]);
+				MeshBuffer.IndexBufferView = Mesh->mIndexDataSize ? AddBufferView(Mesh->mIndexData, Mesh->mIndexDataSize, GLTF_ELEMENT_ARRAY_BUFFER) : -1;
+
+				BufferIt = MeshBuffers.insert(std::make_pair(Mesh, MeshBuffer)).first;
+			}
+
+			const lcGLTFMesh& MeshBuffer = BufferIt->second;
+			const int IndexSize = Mesh->mIndexType == GL_UNSIGNED_SHORT ? 2 : 4;
+			QJsonArray Primitives;
+
+			for (int SectionIdx = 0; SectionIdx < Mesh->mLods[LC_MESH_LOD_HIGH].NumSections; SectionIdx++)
+			{
+				const lcMeshSection* Section = &Mesh->mLods[LC_MESH_LOD_HIGH].Sections[SectionIdx];
+				const int VertexType = Section->PrimitiveType == LC_MESH_TEXTURED_TRIANGLES ? 1 : 0;
+
+				if ((Section->PrimitiveType != LC_MESH_TRIANGLES && Section->PrimitiveType != LC_MESH_TEXTURED_TRIANGLES) || !Section->NumIndices || MeshBuffer.Positions[VertexType] == -1 || MeshBuffer.IndexBufferView == -1)
+					continue;
+
+				QJsonObject Attributes;
+				Attributes["POSITION"] = MeshBuffer.Positions[VertexType];
+				Attributes["NORMAL"] = MeshBuffer.Normals[VertexType];
+
+				QJsonObject Primitive;
+				Primitive["attributes"] = Attributes;
+				Primitive["indices"] = AddAccessor(MeshBuffer.IndexBufferView, Section->IndexOffset, IndexSize == 2 ? GLTF_UNSIGNED_SHORT : GLTF_UNSIGNED_INT, Section->NumIndices, "SCALAR");
+				Primitive["material"] = GetMaterial(Section->ColorIndex == gDefaultColor ? ModelPart.ColorIndex : Section->ColorIndex);
+				Primitives.append(Primitive);
+			}
+
+			int MeshIndex = -1;
+
+			if (!Primitives.isEmpty())
+			{
+				QJsonObject GLTFMesh;
+				GLTFMesh["name"] = QString::fromLatin1(ModelPart.Info->mFileName);
+				GLTFMesh["primitives"] = Primitives;
+				Meshes.append(GLTFMesh);
+				MeshIndex = Meshes.size() - 1;
+			}
+
+			MeshIt = MeshIndices.insert(std::make_pair(MeshKey, MeshIndex)).first;
+		}
+
+		if (MeshIt->second == -1)
+			continue;
+
+		QJsonArray Matrix;
+		for (int Column = 0; Column < 4; Column++)
+			for (int Row = 0; Row < 4; Row++)
+				Matrix.append(ModelPart.WorldMatrix[Column][Row]);
+
+		QJsonObject Node;
+		Node["name"] = QString::fromLatin1(ModelPart.Info->mFileName);
+		Node["mesh"] = MeshIt->second;
+		Node["matrix"] = Matrix;
+		Nodes.append(Node);
+		SceneNodes.append(Nodes.size() - 1);
+	}
+
+	// glTF requires at least one mesh, material and buffer byte when listed
+	if (Meshes.isEmpty())
+	{
+		QMessageBox::information(gMainWindow, tr("3DViewer"), tr("Nothing to export."));
+		return false;
+	}
+
+	// The model is Z up in LDraw units, glTF is Y up in meters
+	const double Scale = 0.0004;
+	QJsonObject Root;
+	Root["name"] = QFileInfo(SaveFileName).completeBaseName();
+	Root["children"] = SceneNodes;
+	Root["matrix"] = QJsonArray({ Scale, 0.0, 0.0, 0.0, 0.0, 0.0, -Scale, 0.0, 0.0, Scale, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0 });
+	Nodes.append(Root);
+
+	QJsonObject Scene;
+	Scene["nodes"] = QJsonArray({ Nodes.size() - 1 });
+
+	while (Buffer.size() % 4)
+		Buffer.append('\0');
+
+	QJsonObject BufferObject;
+	BufferObject["byteLength"] = Buffer.size();
+
+	QJsonObject Asset;
+	Asset["version"] = QLatin1String("2.0");
+	Asset["generator"] = QLatin1String("3DViewer");
+
+	QJsonObject Document;
+	Document["asset"] = Asset;
+	Document["scene"] = 0;
+	Document["scenes"] = QJsonArray({ Scene });
+	Document["nodes"] = Nodes;
+	Document["meshes"] = Meshes;
+	Document["materials"] = Materials;
+	Document["accessors"] = Accessors;
+	Document["bufferViews"] = BufferViews;
+	Document["buffers"] = QJsonArray({ BufferObject });
+
+	QByteArray Json = QJsonDocument(Document).toJson(QJsonDocument::Compact);
+
+	while (Json.size() % 4)
+		Json.append(' ');
+
+	QFile File(SaveFileName);
+
+	if (!File.open(QIODevice::WriteOnly))
+	{
+		QMessageBox::warning(gMainWindow, tr("3DViewer"), tr("Could not open file '%1' for writing.").arg(SaveFileName));
+		return false;
+	}
+
+	// GLB header and chunk header words are little endian regardless of the host
+	auto WriteWords = [&File](std::initializer_list<quint32> Words)
+	{
+		for (quint32 Word : Words)
+		{
+			const quint32 LittleEndianWord = qToLittleEndian(Word);
+			File.write((const char*)&LittleEndianWord, sizeof(LittleEndianWord));
+		}
+	};
+
+	WriteWords({ 0x46546C67, 2, (quint32)(12 + 8 + Json.size() + 8 + Buffer.size()) });
+	WriteWords({ (quint32)Json.size(), 0x4E4F534A });
+	File.write(Json);
+	WriteWords({ (quint32)Buffer.size(), 0x004E4942 });
+	File.write(Buffer);
+
+	return File.error() == QFile::NoError;
+}
+/*** LPub3D Mod end ***/
+
 void Project::ExportHTML(const lcHTMLExportOptions& Options)
 {
 	QDir Dir(Options.PathName);
@@ -2284,6 +2639,15 @@ bool Project::ExportPOVRay(const QString& FileName)
 		}
 	};
 
+/*** LPub3D Mod - buffered exporters ***/
+	struct lcPOVMesh
+	{
+		lcMesh* Mesh;
+		char Name[LC_PIECE_NAME_LEN];
+	};
+
+	std::vector<lcPOVMesh> POVMeshes;
+
 	for (const lcModelPartsEntry& ModelPart : ModelParts)
 	{
 		lcMesh* Mesh = !ModelPart.Mesh ? ModelPart.Info->GetMesh() : ModelPart.Mesh;
@@ -2294,21 +2658,41 @@ bool Project::ExportPOVRay(const QString& FileName)
 		if (!Mesh)
 			continue;
 
-		char Name[LC_PIECE_NAME_LEN];
-		GetMeshName(ModelPart, Name);
+		lcPOVMesh POVMesh;
+		POVMesh.Mesh = Mesh;
+		GetMeshName(ModelPart, POVMesh.Name);
 
 		if (!ModelPart.Mesh)
 		{
 			std::pair<char[LC_PIECE_NAME_LEN], int>& Entry = PieceTable[ModelPart.Info];
-			sprintf(Entry.first, "lc_%s", Name);
+			sprintf(Entry.first, "lc_%s", POVMesh.Name);
 		}
 
-		Mesh->ExportPOVRay(POVFile, Name, &ColorTablePointer[0]);
-
-		sprintf(Line, "#declare lc_%s_clear = lc_%s\n\n", Name, Name);
-		POVFile.WriteLine(Line);
+		POVMeshes.push_back(POVMesh);
 	}
 
+	// The object pass below only reads the table from the worker threads
+	for (const lcModelPartsEntry& ModelPart : ModelParts)
+		if (!ModelPart.Mesh)
+			PieceTable[ModelPart.Info];
+
+	auto WriteBuffer = [&POVFile](const lcMemFile& Buffer)
+	{
+		POVFile.WriteBuffer(Buffer.mBuffer, Buffer.GetLength());
+	};
+
+	lcWriteExportBlocks<lcMemFile>(POVMeshes.size(), [&POVMeshes, &ColorTablePointer](size_t MeshIdx, lcMemFile& Buffer)
+	{
+		const lcPOVMesh& POVMesh = POVMeshes[MeshIdx];
+		char Line[1024];
+
+		POVMesh.Mesh->ExportPOVRay(Buffer, POVMesh.Name, &ColorTablePointer[0]);
+
+		sprintf(Line, "#declare lc_%s_clear = lc_%s\n\n", POVMesh.Name, POVMesh.Name);
+		Buffer.WriteLine(Line);
+	}, WriteBuffer);
+/*** LPub3D Mod end ***/
+
 	lcCamera* Camera = gMainWindow->GetActiveView()->mCamera;
 	const lcVector3& Position = Camera->mPosition;
 	const lcVector3& Target = Camera->mTargetPosition;
@@ -2352,32 +2736,49 @@ bool Project::ExportPOVRay(const QString& FileName)
 	sprintf(Line, "light_source{ <%f, %f, %f>\n  color rgb 0.5\n  area_light 200, 200, 10, 10\n  jitter\n}\n\n", 2.0f * Radius + Center.x, 0.0f * Radius + Center.y, -2.0f * Radius + Center.z);
 	POVFile.WriteLine(Line);
 
-	for (const lcModelPartsEntry& ModelPart : ModelParts)
+/*** LPub3D Mod - buffered exporters ***/
+	auto FormatMatrix = [](char* Text, const float* f)
 	{
+		const float Values[12] = { -f[5], -f[4], -f[6], -f[1], -f[0], -f[2], f[9], f[8], f[10], f[13] / 25.0f, f[12] / 25.0f, f[14] / 25.0f };
+
+		Text = lcFormatText(Text, "matrix <");
+
+		for (int ValueIdx = 0; ValueIdx < 12; ValueIdx++)
+		{
+			if (ValueIdx)
+				Text = lcFormatText(Text, ", ");
+
+			Text = lcFormatFixed(Text, Values[ValueIdx], 4);
+		}
+
+		return lcFormatText(Text, ">\n}\n");
+	};
+
+	lcWriteExportBlocks<lcMemFile>(ModelParts.size(), [&ModelParts, &PieceTable, &ColorTable, &GetMeshName, &FormatMatrix](size_t PartIdx, lcMemFile& Buffer)
+	{
+		const lcModelPartsEntry& ModelPart = ModelParts[PartIdx];
 		int Color = ModelPart.ColorIndex;
 		const char* Suffix = lcIsColorTranslucent(Color) ? "_clear" : "";
 		const float* f = ModelPart.WorldMatrix;
+		char Line[1024];
+		char* Text;
 
 		if (!ModelPart.Mesh)
 		{
-			std::pair<char[LC_PIECE_NAME_LEN], int>& Entry = PieceTable[ModelPart.Info];
+			const std::pair<char[LC_PIECE_NAME_LEN], int>& Entry = PieceTable.find(ModelPart.Info)->second;
 
 			if (Entry.second & LGEO_PIECE_SLOPE)
 			{
-				sprintf(Line, "merge {\n object {\n  %s%s\n  texture { %s }\n }\n"
-						" object {\n  %s_slope\n  texture { %s normal { bumps 0.3 scale 0.02 } }\n }\n"
-						" matrix <%.4f, %.4f, %.4f, %.4f, %.4f, %.4f, %.4f, %.4f, %.4f, %.4f, %.4f, %.4f>\n}\n",
-						Entry.first, Suffix, ColorTable[Color].data(), Entry.first, ColorTable[Color].data(),
-						-f[5], -f[4], -f[6], -f[1], -f[0], -f[2], f[9], f[8], f[10], f[13] / 25.0f, f[12] / 25.0f, f[14] / 25.0f);
+				Text = Line + sprintf(Line, "merge {\n object {\n  %s%s\n  texture { %s }\n }\n"
+				                      " object {\n  %s_slope\n  texture { %s normal { bumps 0.3 scale 0.02 } }\n }\n ",
+				                      Entry.first, Suffix, ColorTable[Color].data(), Entry.first, ColorTable[Color].data());
 			}
 			else
 			{
 				if (!ModelPart.Info || !ModelPart.Info->GetMesh())
-					continue;
-
-				sprintf(Line, "object {\n %s%s\n texture { %s }\n matrix <%.4f, %.4f, %.4f, %.4f, %.4f, %.4f, %.4f, %.4f, %.4f, %.4f, %.4f, %.4f>\n}\n",
-						Entry.first, Suffix, ColorTable[Color].data(), -f[5], -f[4], -f[6], -f[1], -f[0], -f[2], f[9], f[8], f[10], f[13] / 25.0f, f[12] / 25.0f, f[14] / 25.0f);
+					return;
 
+				Text = Line + sprintf(Line, "object {\n %s%s\n texture { %s }\n ", Entry.first, Suffix, ColorTable[Color].data());
 			}
 		}
 		else
@@ -2385,12 +2786,13 @@ bool Project::ExportPOVRay(const QString& FileName)
 			char Name[LC_PIECE_NAME_LEN];
 			GetMeshName(ModelPart, Name);
 
-			sprintf(Line, "object {\n lc_%s%s\n texture { %s }\n matrix <%.4f, %.4f, %.4f, %.4f, %.4f, %.4f, %.4f, %.4f, %.4f, %.4f, %.4f, %.4f>\n}\n",
-					Name, Suffix, ColorTable[Color].data(), -f[5], -f[4], -f[6], -f[1], -f[0], -f[2], f[9], f[8], f[10], f[13] / 25.0f, f[12] / 25.0f, f[14] / 25.0f);
+			Text = Line + sprintf(Line, "object {\n lc_%s%s\n texture { %s }\n ", Name, Suffix, ColorTable[Color].data());
 		}
 
-		POVFile.WriteLine(Line);
-	}
+		Text = FormatMatrix(Text, f);
+		Buffer.WriteBuffer(Line, Text - Line);
+	}, WriteBuffer);
+/*** LPub3D Mod end ***/
 
 	return true;
 }
@@ -2453,60 +2855,87 @@ void Project::ExportWavefront(const QString& FileName)
 		MaterialFile.WriteLine(Line);
 	}
 
-	for (const lcModelPartsEntry& ModelPart : ModelParts)
+/*** LPub3D Mod - buffered exporters ***/
+	std::vector<lcMesh*> Meshes(ModelParts.size());
+	std::vector<quint32> VertexOffsets(ModelParts.size());
+
+	for (size_t PartIdx = 0; PartIdx < ModelParts.size(); PartIdx++)
 	{
+		const lcModelPartsEntry& ModelPart = ModelParts[PartIdx];
 		lcMesh* Mesh = !ModelPart.Mesh ? ModelPart.Info->GetMesh() : ModelPart.Mesh;
 
-		if (!Mesh)
-			continue;
-
-		const lcMatrix44& ModelWorld = ModelPart.WorldMatrix;
-		lcVertex* Verts = (lcVertex*)Mesh->mVertexData;
-
-		for (int VertexIdx = 0; VertexIdx < Mesh->mNumVertices; VertexIdx++)
-		{
-			lcVector3 Vertex = lcMul31(Verts[VertexIdx].Position, ModelWorld);
-			sprintf(Line, "v %.2f %.2f %.2f\n", Vertex[0], Vertex[1], Vertex[2]);
-			OBJFile.WriteLine(Line);
-		}
+		Meshes[PartIdx] = Mesh;
+		VertexOffsets[PartIdx] = vert;
 
-		OBJFile.WriteLine("#\n\n");
+		if (Mesh)
+			vert += Mesh->mNumVertices;
 	}
 
-	for (const lcModelPartsEntry& ModelPart : ModelParts)
+	auto WriteBuffer = [&OBJFile](const lcMemFile& Buffer)
 	{
-		lcMesh* Mesh = !ModelPart.Mesh ? ModelPart.Info->GetMesh() : ModelPart.Mesh;
+		OBJFile.WriteBuffer(Buffer.mBuffer, Buffer.GetLength());
+	};
+
+	auto FormatVertices = [&ModelParts, &Meshes](size_t PartIdx, lcMemFile& Buffer, bool Normals)
+	{
+		const lcMesh* Mesh = Meshes[PartIdx];
 
 		if (!Mesh)
-			continue;
+			return;
 
-		const lcMatrix44& ModelWorld = ModelPart.WorldMatrix;
-		lcVertex* Verts = (lcVertex*)Mesh->mVertexData;
+		const lcMatrix44& ModelWorld = ModelParts[PartIdx].WorldMatrix;
+		const lcVertex* Verts = (const lcVertex*)Mesh->mVertexData;
+		char Line[128];
 
 		for (int VertexIdx = 0; VertexIdx < Mesh->mNumVertices; VertexIdx++)
 		{
-			lcVector3 Normal = lcMul30(lcUnpackNormal(Verts[VertexIdx].Normal), ModelWorld);
-			sprintf(Line, "vn %.2f %.2f %.2f\n", Normal[0], Normal[1], Normal[2]);
-			OBJFile.WriteLine(Line);
+			lcVector3 Vector;
+			char* Text;
+
+			if (Normals)
+			{
+				Vector = lcMul30(lcUnpackNormal(Verts[VertexIdx].Normal), ModelWorld);
+				Text = lcFormatText(Line, "vn ");
+			}
+			else
+			{
+				Vector = lcMul31(Verts[VertexIdx].Position, ModelWorld);
+				Text = lcFormatText(Line, "v ");
+			}
+
+			Text = lcFormatFixed(Text, Vector[0], 2);
+			Text = lcFormatText(Text, " ");
+			Text = lcFormatFixed(Text, Vector[1], 2);
+			Text = lcFormatText(Text, " ");
+			Text = lcFormatFixed(Text, Vector[2], 2);
+			Text = lcFormatText(Text, "\n");
+			Buffer.WriteBuffer(Line, Text - Line);
 		}
 
-		OBJFile.WriteLine("#\n\n");
-	}
+		Buffer.WriteLine("#\n\n");
+	};
 
-	int NumPieces = 0;
-	for (const lcModelPartsEntry& ModelPart : ModelParts)
+	lcWriteExportBlocks<lcMemFile>(ModelParts.size(), [&FormatVertices](size_t PartIdx, lcMemFile& Buffer)
 	{
-		sprintf(Line, "g Piece%.3d\n", NumPieces++);
-		OBJFile.WriteLine(Line);
+		FormatVertices(PartIdx, Buffer, false);
+	}, WriteBuffer);
 
-		lcMesh* Mesh = !ModelPart.Mesh ? ModelPart.Info->GetMesh() : ModelPart.Mesh;
+	lcWriteExportBlocks<lcMemFile>(ModelParts.size(), [&FormatVertices](size_t PartIdx, lcMemFile& Buffer)
+	{
+		FormatVertices(PartIdx, Buffer, true);
+	}, WriteBuffer);
 
-		if (Mesh)
-		{
-			Mesh->ExportWavefrontIndices(OBJFile, ModelPart.ColorIndex, vert);
-			vert += Mesh->mNumVertices;
-		}
-	}
+	lcWriteExportBlocks<lcMemFile>(ModelParts.size(), [&ModelParts, &Meshes, &VertexOffsets](size_t PartIdx, lcMemFile& Buffer)
+	{
+		char Line[32];
+
+		sprintf(Line, "g Piece%.3d\n", (int)PartIdx);
+		Buffer.WriteLine(Line);
+
+		if (Meshes[PartIdx])
+			Meshes[PartIdx]->ExportWavefrontIndices(Buffer, ModelParts[PartIdx].ColorIndex, VertexOffsets[PartIdx]);
+	}, WriteBuffer);
+/*** LPub3D Mod end ***/
 }
 
 void Project::SaveImage()
@@ -141,6 +141,9 @@ public:
 	void ExportBrickLink();
 	void ExportCOLLADA(const QString& FileName);
 	void ExportCSV();
+/*** LPub3D Mod - glTF export ***/
+	bool ExportGLTF(const QString& FileName);
+/*** LPub3D Mod end ***/
 	void ExportHTML(const lcHTMLExportOptions& Options);
 	bool ExportPOVRay(const QString& FileName);
 	void ExportWavefront(const QString& FileName);
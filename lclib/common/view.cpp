@@ -23,6 +23,9 @@ View::View(lcModel* Model)
 	mActiveSubmodelInstance = nullptr;
 	mCamera = nullptr;
 	mHighlight = false;
+/*** LPub3D Mod - pipelined readback ***/
+	mRenderReadbackDeferred = false;
+/*** LPub3D Mod end ***/
 	memset(mGridSettings, 0, sizeof(mGridSettings));
 
 	mDragState = lcDragState::NONE;
@@ -794,7 +797,9 @@ lcArray<lcObject*> View::FindObjectsInBox(float x1, float y1, float x2, float y2
 	return ObjectBoxTest.Objects;
 }
 
-bool View::BeginRenderToImage(int Width, int Height)
+/*** LPub3D Mod - pipelined readback ***/
+bool View::BeginRenderToImage(int Width, int Height, bool DeferReadback)
+/*** LPub3D Mod end ***/
 {
 	GLint MaxTexture;
 	glGetIntegerv(GL_MAX_TEXTURE_SIZE, &MaxTexture);
@@ -811,16 +816,49 @@ bool View::BeginRenderToImage(int Width, int Height)
 
 	mRenderFramebuffer = mContext->CreateRenderFramebuffer(TileWidth, TileHeight);
 	mContext->BindFramebuffer(mRenderFramebuffer.first);
+/*** LPub3D Mod - pipelined readback ***/
+	// Tiled images are assembled from several draws, so only single tile
+	// images can leave the framebuffer to the context readback queue
+	mRenderReadbackDeferred = DeferReadback && TileWidth == Width && TileHeight == Height;
+/*** LPub3D Mod end ***/
 	return mRenderFramebuffer.first.IsValid();
 }
 
 void View::EndRenderToImage()
 {
 	mRenderImage = QImage();
+/*** LPub3D Mod - pipelined readback ***/
+	mRenderImageReadbacks.clear();
+	mRenderReadbackDeferred = false;
+	mContext->DestroyRenderFramebufferReadbacks();
+/*** LPub3D Mod end ***/
 	mContext->DestroyRenderFramebuffer(mRenderFramebuffer);
 	mContext->ClearFramebuffer();
 }
 
+/*** LPub3D Mod - pipelined readback ***/
+/*
+ * Queues the image drawn by the last OnDraw. A deferred single tile image
+ * is read back by the context while the caller draws the next one; a tiled
+ * image is already complete and is only held until it is taken.
+ */
+void View::BeginRenderImageReadback()
+{
+	if (mRenderReadbackDeferred)
+		mContext->BeginRenderFramebufferReadback(mRenderFramebuffer);
+	else
+		mRenderImageReadbacks.append(mRenderImage);
+}
+
+QImage View::EndRenderImageReadback()
+{
+	if (mRenderReadbackDeferred)
+		return mContext->EndRenderFramebufferReadback();
+
+	return mRenderImageReadbacks.isEmpty() ? QImage() : mRenderImageReadbacks.takeFirst();
+}
+/*** LPub3D Mod end ***/
+
 void View::OnDraw()
 {
 	if (!mModel)
@@ -900,7 +938,9 @@ void View::OnDraw()
 
 			mScene.Draw(mContext);
 
-			if (!mRenderImage.isNull())
+/*** LPub3D Mod - pipelined readback ***/
+			if (!mRenderImage.isNull() && !mRenderReadbackDeferred)
+/*** LPub3D Mod end ***/
 			{
 				quint8* Buffer = (quint8*)malloc(mWidth * mHeight * 4);
 				uchar* ImageBuffer = mRenderImage.bits();
@@ -154,7 +154,9 @@ public:
 		lcUnprojectPoints(Points, NumPoints, mCamera->mWorldView, GetProjectionMatrix(), Viewport);
 	}
 
-	bool BeginRenderToImage(int Width, int Height);
+/*** LPub3D Mod - pipelined readback ***/
+	bool BeginRenderToImage(int Width, int Height, bool DeferReadback = false);
+/*** LPub3D Mod end ***/
 	void EndRenderToImage();
 
 	QImage GetRenderImage() const
@@ -162,6 +164,11 @@ public:
 		return mRenderImage;
 	}
 
+/*** LPub3D Mod - pipelined readback ***/
+	void BeginRenderImageReadback();
+	QImage EndRenderImageReadback();
+/*** LPub3D Mod end ***/
+
 /*** LPub3D Mod - Moved from protected: for rotate angles ***/
 public:
 	lcTrackButton mTrackButton;
@@ -205,6 +212,10 @@ protected:
 	bool mHighlight;
 	QImage mRenderImage;
 	std::pair<lcFramebuffer, lcFramebuffer> mRenderFramebuffer;
+/*** LPub3D Mod - pipelined readback ***/
+	bool mRenderReadbackDeferred;
+	QList<QImage> mRenderImageReadbacks;
+/*** LPub3D Mod end ***/
 	lcViewSphere mViewSphere;
 
 	lcVertexBuffer mGridBuffer;
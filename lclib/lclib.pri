@@ -17,6 +17,7 @@ HEADERS += \
     $$PWD/common/lc_global.h \
     $$PWD/common/lc_glwidget.h \
     $$PWD/common/lc_http.h \
+    $$PWD/common/lc_imagewriter.h \
     $$PWD/common/lc_library.h \
     $$PWD/common/lc_lxf.h \
     $$PWD/common/lc_mainwindow.h \
@@ -77,6 +78,7 @@ SOURCES +=  \
     $$PWD/common/lc_file.cpp \
     $$PWD/common/lc_glextensions.cpp \
     $$PWD/common/lc_http.cpp \
+    $$PWD/common/lc_imagewriter.cpp \
     $$PWD/common/lc_library.cpp \
     $$PWD/common/lc_lxf.cpp \
     $$PWD/common/lc_mainwindow.cpp \
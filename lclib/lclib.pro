@@ -56,6 +56,10 @@ QMAKE_CFLAGS    += $(Q_CFLAGS)
 
 DEFINES += LC_DISABLE_UPDATE_CHECK=1
 
+# set config to compile out page build pipeline tracing
+# CONFIG+=notrace
+notrace: DEFINES += LPUB_NO_TRACE
+
 # USE CPP 11
 unix:!freebsd:!macx {
     GCC_VERSION = $$system(g++ -dumpversion)
@@ -23,8 +23,8 @@
 #include "version.h"
 #include "QsLog.h"
 
-int                         Annotations::returnInt;
-QString                     Annotations::returnString;
+QMutex                      Annotations::catalogMutex;
+std::shared_ptr<const AnnotationCatalog> Annotations::_catalog;
 QList<QString>              Annotations::titleAnnotations;
 QHash<QString, QString>     Annotations::freeformAnnotations;
 QHash<QString, QStringList> Annotations::annotationStyles;
@@ -205,6 +205,8 @@ void Annotations::loadLD2BLColorsXRef(QByteArray& Buffer){
         Buffer.append(LEGOLD2BLColorsXRef, sizeof(LEGOLD2BLColorsXRef));
     else
         Buffer.append(LD2BLColorsXRef, sizeof(LD2BLColorsXRef));
+
+    invalidateCatalog();
 }
 
 void Annotations::loadLD2BLCodesXRef(QByteArray& Buffer){
@@ -524,6 +526,8 @@ void Annotations::loadLD2BLCodesXRef(QByteArray& Buffer){
         Buffer.append(LEGOLD2BLCodesXRef, sizeof(LEGOLD2BLCodesXRef));
     else
         Buffer.append(LD2BLCodesXRef, sizeof(LD2BLCodesXRef));
+
+    invalidateCatalog();
 }
 
 void Annotations::loadBLColors(QByteArray& Buffer){
@@ -764,6 +768,8 @@ void Annotations::loadBLColors(QByteArray& Buffer){
         Buffer.append(LEGOBLColors, sizeof(LEGOBLColors));
     else
         Buffer.append(BLColors, sizeof(BLColors));
+
+    invalidateCatalog();
 }
 
 void Annotations::loadDefaultAnnotationStyles(QByteArray& Buffer){
@@ -978,6 +984,8 @@ void Annotations::loadDefaultAnnotationStyles(QByteArray& Buffer){
     else
     if (Preferences::validLDrawLibrary == VEXIQ_LIBRARY)
         Buffer.append(VEXIQDefaultAnnotationStyles, sizeof(VEXIQDefaultAnnotationStyles));
+
+    invalidateCatalog();
 }
 
 void Annotations::loadLD2RBColorsXRef(QByteArray& Buffer){
@@ -1015,6 +1023,8 @@ void Annotations::loadLD2RBColorsXRef(QByteArray& Buffer){
         Buffer.append(LEGOLD2RBColorsXRef, sizeof(LEGOLD2RBColorsXRef));
     else
         Buffer.append(LD2RBColorsXRef, sizeof(LD2RBColorsXRef));
+
+    invalidateCatalog();
 }
 
 void Annotations::loadLD2RBCodesXRef(QByteArray& Buffer){
@@ -1041,11 +1051,14 @@ void Annotations::loadLD2RBCodesXRef(QByteArray& Buffer){
         Buffer.append(LEGOLD2RBCodesXRef, sizeof(LEGOLD2RBCodesXRef));
     else
         Buffer.append(LD2RBCodesXRef, sizeof(LD2RBCodesXRef));
+
+    invalidateCatalog();
 }
 
 Annotations::Annotations()
 {
-    returnString = QString();
+    // the lists below are read by catalog() from the render threads
+    QMutexLocker locker(&catalogMutex);
 
     if (titleAnnotations.size() == 0) {
         QString annotations = Preferences::titleAnnotationsFile;
@@ -1487,13 +1500,22 @@ Annotations::Annotations()
             }
         }
     }
+
+    // rebuild the catalog from the lists loaded above
+    invalidateCatalog();
 }
 
 // key : blitemid+blcolorid
 // val1: blitemid+"-"+blcolorid
 // val2: elementid
 bool Annotations::loadBLCodes(){
-    if (blCodes.size() == 0) {
+    bool loaded;
+    {
+        QMutexLocker locker(&catalogMutex);
+        loaded = blCodes.size() != 0;
+    }
+    if (! loaded) {
+        QHash<QString, QStringList> codes;
         QString blCodesFile = Preferences::blCodesFile;
         QRegExp rx("^([^\\t]+)\\t+\\s*([^\\t]+)\\t+\\s*([^\\t]+).*$");
         if (! blCodesFile.isEmpty()) {
@@ -1539,7 +1561,7 @@ bool Annotations::loadBLCodes(){
                     QString blitemid = rx.cap(1);
                     QString blcolorid = getBLColorID(rx.cap(2));
                     QString elementid = rx.cap(3);
-                    blCodes[QString(blitemid+blcolorid).toLower()] << QString(blitemid+"-"+blcolorid).toUpper() << elementid;
+                    codes[QString(blitemid+"\t"+blcolorid).toLower()] << QString(blitemid+"-"+blcolorid).toUpper() << elementid;
 // DEBUG -->>>
 //                    Stream << QString("Key: %1 Value[0]: %2 Value[1]: %3")
 //                                      .arg(QString(blitemid+blcolorid).toLower())
@@ -1552,6 +1574,11 @@ bool Annotations::loadBLCodes(){
 //            Stream.flush();
 // DEBUG <<<---
 
+            {
+                QMutexLocker locker(&catalogMutex);
+                blCodes.swap(codes);
+            }
+            invalidateCatalog();
         } else {
            return  false;
         }
@@ -1560,7 +1587,13 @@ bool Annotations::loadBLCodes(){
 }
 
 bool Annotations::loadBLCodes(QByteArray &Buffer){
-    if (blCodes.size() == 0) {
+    bool loaded;
+    {
+        QMutexLocker locker(&catalogMutex);
+        loaded = blCodes.size() != 0;
+    }
+    if (! loaded) {
+        QHash<QString, QStringList> codes;
         QRegExp rx("^([^\\t]+)\\t+\\s*([^\\t]+)\\t+\\s*([^\\t]+).*$");
         QTextStream instream(Buffer);
 
@@ -1587,10 +1620,16 @@ bool Annotations::loadBLCodes(QByteArray &Buffer){
                 QString blitemid = rx.cap(1);
                 QString blcolorid = getBLColorID(rx.cap(2));
                 QString elementid = rx.cap(3);
-                blCodes[QString(blitemid+blcolorid).toLower()] << QString(blitemid+"-"+blcolorid).toUpper() << elementid;
+                codes[QString(blitemid+"\t"+blcolorid).toLower()] << QString(blitemid+"-"+blcolorid).toUpper() << elementid;
             }
         }
 
+        {
+            QMutexLocker locker(&catalogMutex);
+            blCodes.swap(codes);
+        }
+        invalidateCatalog();
+
         //    write stream to file
         QFile file(QString("%1/extras/%2").arg(Preferences::lpubDataPath,VER_LPUB3D_BLCODES_FILE));
         if(file.open(QIODevice::WriteOnly | QIODevice::Text))
@@ -1637,7 +1676,13 @@ bool Annotations::loadBLCodes(QByteArray &Buffer){
 // key: ldpartid+ldcolorid
 // val: elementid
 bool Annotations::loadLEGOElements(){
-    if (legoElements.size() == 0) {
+    bool loaded;
+    {
+        QMutexLocker locker(&catalogMutex);
+        loaded = legoElements.size() != 0;
+    }
+    if (! loaded) {
+        QHash<QString, QString> elements;
         QString legoElementsFile = Preferences::legoElementsFile;
         QRegExp rx("^([^\\t]+)\\t+\\s*([^\\t]+)\\t+\\s*([^\\t]+).*$");
         if (!legoElementsFile.isEmpty()) {
@@ -1675,9 +1720,15 @@ bool Annotations::loadLEGOElements(){
                     QString ldpartid = rx.cap(1);
                     QString ldcolorid = rx.cap(2);
                     QString elementid = rx.cap(3);
-                    legoElements[QString(ldpartid+ldcolorid).toLower()] = elementid;
+                    elements[QString(ldpartid+"\t"+ldcolorid).toLower()] = elementid;
                 }
             }
+
+            {
+                QMutexLocker locker(&catalogMutex);
+                legoElements.swap(elements);
+            }
+            invalidateCatalog();
         } else {
             QString message = QString("LEGO Elements file was not found : %1").arg(legoElementsFile);
             if (Preferences::modeGUI){
@@ -1691,115 +1742,193 @@ bool Annotations::loadLEGOElements(){
     return true;
 }
 
-const QString &Annotations::freeformAnnotation(QString part)
+int AnnotationCatalog::internPart(const QString &part)
 {
-  if (freeformAnnotations.contains(part.toLower())) {
-    return freeformAnnotations[part.toLower()];
-  }
-  return returnString;
+    const QString key = part.toLower();
+    QHash<QString, int>::const_iterator i = partIndexes.constFind(key);
+    if (i != partIndexes.constEnd())
+        return i.value();
+    const int index = partIndexes.size();
+    partIndexes.insert(key, index);
+    return index;
 }
 
-const int &Annotations::getAnnotationStyle(QString part)
+void Annotations::invalidateCatalog()
 {
-  returnInt = 0;
-  if (annotationStyles.contains(part.toLower())) {
-    bool ok;
-    returnInt = annotationStyles[part.toLower()][0].toInt(&ok);
-    if (ok)
-      return returnInt;
-  }
-  return returnInt;
+    std::atomic_store(&_catalog, std::shared_ptr<const AnnotationCatalog>());
 }
 
-const int &Annotations::getAnnotationCategory(QString part){
-  returnInt = 0;
-  if (annotationStyles.contains(part.toLower())) {
-    bool ok;
-    returnInt = annotationStyles[part.toLower()][1].toInt(&ok);
-    if (ok)
-      return returnInt;
-  }
-  return returnInt;
+/*
+ * Return the current catalog, building it from the loaded
+ * lists when they changed since the last build.
+ */
+std::shared_ptr<const AnnotationCatalog> Annotations::catalog()
+{
+    std::shared_ptr<const AnnotationCatalog> current = std::atomic_load(&_catalog);
+    if (current)
+        return current;
+
+    QMutexLocker locker(&catalogMutex);
+    current = std::atomic_load(&_catalog);
+    if (current)
+        return current;
+
+    std::shared_ptr<AnnotationCatalog> built = std::make_shared<AnnotationCatalog>();
+
+    built->freeform = freeformAnnotations;
+
+    QHash<QString, QStringList>::const_iterator s = annotationStyles.constBegin();
+    for ( ; s != annotationStyles.constEnd(); ++s) {
+        const QStringList &values = s.value();
+        if (values.size() < 3)
+            continue;
+        AnnotationCatalog::Style style;
+        style.style      = values.at(0).toInt();
+        style.category   = values.at(1).toInt();
+        style.annotation = values.at(2);
+        built->styles.insert(s.key(), style);
+    }
+
+    // key: blitemid<tab>blcolorid, val: blitemid-blcolorid, elementid
+    QHash<QString, QStringList>::const_iterator b = blCodes.constBegin();
+    for ( ; b != blCodes.constEnd(); ++b) {
+        const int tab = b.key().indexOf('\t');
+        bool ok;
+        const int blcolorid = b.key().mid(tab + 1).toInt(&ok);
+        if (tab < 0 || ! ok || b.value().size() < 2)
+            continue;
+        AnnotationCatalog::BLElement element;
+        element.itemColor = b.value().at(0);
+        element.element   = b.value().at(1);
+        built->blElements.insert(AnnotationCatalog::key(built->internPart(b.key().left(tab)), blcolorid), element);
+    }
+
+    // key: ldpartid<tab>ldcolorid, val: elementid
+    QHash<QString, QString>::const_iterator l = legoElements.constBegin();
+    for ( ; l != legoElements.constEnd(); ++l) {
+        const int tab = l.key().indexOf('\t');
+        bool ok;
+        const int ldcolorid = l.key().mid(tab + 1).toInt(&ok);
+        if (tab < 0 || ! ok)
+            continue;
+        built->legoElements.insert(AnnotationCatalog::key(built->internPart(l.key().left(tab)), ldcolorid), l.value());
+    }
+
+    QHash<QString, QString>::const_iterator x = ld2blColorsXRef.constBegin();
+    for ( ; x != ld2blColorsXRef.constEnd(); ++x) {
+        bool ldOk, blOk;
+        const int ldcolorid = x.key().toInt(&ldOk);
+        const int blcolorid = x.value().toInt(&blOk);
+        if (ldOk && blOk)
+            built->ld2blColors.insert(ldcolorid, blcolorid);
+    }
+
+    for (x = ld2blCodesXRef.constBegin(); x != ld2blCodesXRef.constEnd(); ++x) {
+        const int ldpartid = built->internPart(x.key());
+        built->ld2blParts.insert(ldpartid, x.value());
+        built->ld2blPartIndexes.insert(ldpartid, built->internPart(x.value()));
+    }
+
+    for (x = ld2rbColorsXRef.constBegin(); x != ld2rbColorsXRef.constEnd(); ++x) {
+        bool ldOk;
+        const int ldcolorid = x.key().toInt(&ldOk);
+        if (ldOk)
+            built->ld2rbColors.insert(ldcolorid, x.value().toInt());
+    }
+
+    for (x = ld2rbCodesXRef.constBegin(); x != ld2rbCodesXRef.constEnd(); ++x)
+        built->ld2rbParts.insert(built->internPart(x.key()), x.value());
+
+    current = built;
+    std::atomic_store(&_catalog, current);
+    return current;
 }
 
-const QString &Annotations::getStyleAnnotation(QString part)
+QString Annotations::freeformAnnotation(const QString &part)
 {
-  if (annotationStyles.contains(part.toLower())) {
-    return annotationStyles[part.toLower()][2];
-  }
-  return returnString;
+  return catalog()->freeform.value(part.toLower());
 }
 
-const QString &Annotations::getBLColorID(QString blcolorname)
+int Annotations::getAnnotationStyle(const QString &part)
 {
-  if (blColors.contains(blcolorname.toLower())) {
-    return blColors[blcolorname.toLower()];
-  }
-  return returnString;
+  std::shared_ptr<const AnnotationCatalog> c = catalog();
+  QHash<QString, AnnotationCatalog::Style>::const_iterator i = c->styles.constFind(part.toLower());
+  return i != c->styles.constEnd() ? i.value().style : 0;
 }
 
-//key: ldpartid+ldcolorid
-const QString &Annotations::getLEGOElement(QString elementkey)
+int Annotations::getAnnotationCategory(const QString &part){
+  std::shared_ptr<const AnnotationCatalog> c = catalog();
+  QHash<QString, AnnotationCatalog::Style>::const_iterator i = c->styles.constFind(part.toLower());
+  return i != c->styles.constEnd() ? i.value().category : 0;
+}
+
+QString Annotations::getStyleAnnotation(const QString &part)
 {
-    loadLEGOElements();
-    if (legoElements.contains(elementkey.toLower())) {
-        return legoElements[elementkey.toLower()];
-    }
+  std::shared_ptr<const AnnotationCatalog> c = catalog();
+  QHash<QString, AnnotationCatalog::Style>::const_iterator i = c->styles.constFind(part.toLower());
+  return i != c->styles.constEnd() ? i.value().annotation : QString();
+}
 
-    return returnString;
+QString Annotations::getBLColorID(const QString &blcolorname)
+{
+  return blColors.value(blcolorname.toLower());
 }
 
-const QString &Annotations::getBLElement(QString ldcolorid, QString ldpartid, int which)
+QString Annotations::getLEGOElement(const QString &ldpartid, const QString &ldcolorid)
+{
+    loadLEGOElements();
+    std::shared_ptr<const AnnotationCatalog> c = catalog();
+    const int part = c->partIndex(ldpartid);
+    if (part < 0)
+        return QString();
+    return c->legoElements.value(AnnotationCatalog::key(part, ldcolorid.toInt()));
+}
+
+QString Annotations::getBLElement(const QString &ldcolorid, const QString &ldpartid, int which)
 {
     loadBLCodes();
-    QString blcolorid,elementkey;
-    if (ld2blColorsXRef.contains(ldcolorid.toLower())) {
-        blcolorid = ld2blColorsXRef[ldcolorid.toLower()];
-    }
-    if (!blcolorid.isEmpty()){
-        elementkey = QString(ldpartid+blcolorid).toLower();
-        if (blCodes.contains(elementkey)){
-            return blCodes[elementkey][which];
-        }
-        else
-        if (ld2blCodesXRef.contains(ldpartid.toLower())) {
-            elementkey = QString(ld2blCodesXRef[ldpartid.toLower()]+blcolorid).toLower();
-            if (blCodes.contains(elementkey)) {
-                return blCodes[elementkey][which];
-            }
-        }
+    std::shared_ptr<const AnnotationCatalog> c = catalog();
+    bool ok;
+    QHash<int, int>::const_iterator color = c->ld2blColors.constFind(ldcolorid.toInt(&ok));
+    if (! ok || color == c->ld2blColors.constEnd())
+        return QString();
+
+    const int part = c->partIndex(ldpartid);
+    QHash<quint64, AnnotationCatalog::BLElement>::const_iterator i =
+            c->blElements.constFind(AnnotationCatalog::key(part, color.value()));
+    if (part < 0 || i == c->blElements.constEnd()) {
+        const int blpart = c->ld2blPartIndexes.value(part, -1);
+        if (blpart < 0)
+            return QString();
+        i = c->blElements.constFind(AnnotationCatalog::key(blpart, color.value()));
+        if (i == c->blElements.constEnd())
+            return QString();
     }
-    return returnString;
+    return which ? i.value().element : i.value().itemColor;
 }
 
-const int &Annotations::getRBColorID(QString ldcolorid)
+int Annotations::getRBColorID(const QString &ldcolorid)
 {
-    returnInt = -1;
-    if (ld2rbColorsXRef.contains(ldcolorid.toLower()))
-        returnInt = ld2rbColorsXRef[ldcolorid.toLower()].toInt();
-    return returnInt;
+    bool ok;
+    const int color = ldcolorid.toInt(&ok);
+    return ok ? catalog()->ld2rbColors.value(color, -1) : -1;
 }
 
-const QString &Annotations::getBrickLinkPartId(QString ldpartid)
+QString Annotations::getBrickLinkPartId(const QString &ldpartid)
 {
-    returnString = ldpartid;
-    if (ld2blCodesXRef.contains(ldpartid.toLower()))
-        returnString = ld2blCodesXRef[ldpartid.toLower()];
-    return returnString;
+    std::shared_ptr<const AnnotationCatalog> c = catalog();
+    const int part = c->partIndex(ldpartid);
+    return c->ld2blParts.value(part, ldpartid);
 }
 
-const int &Annotations::getBrickLinkColor(int ldcolorid) {
-    returnInt = 0;
-    if (ld2blColorsXRef.contains(QString::number(ldcolorid)))
-        returnInt = ld2blColorsXRef[QString::number(ldcolorid)].toInt();
-    return returnInt;
+int Annotations::getBrickLinkColor(int ldcolorid) {
+    return catalog()->ld2blColors.value(ldcolorid, 0);
 }
 
-const QString &Annotations::getRBPartID(QString ldpartid)
+QString Annotations::getRBPartID(const QString &ldpartid)
 {
-    if (ld2rbCodesXRef.contains(ldpartid.toLower()))
-        returnString = ld2rbCodesXRef[ldpartid.toLower()];
-    return returnString;
+    std::shared_ptr<const AnnotationCatalog> c = catalog();
+    return c->ld2rbParts.value(c->partIndex(ldpartid));
 }
 
 bool Annotations::overwriteFile(const QString &file)
@@ -16,13 +16,62 @@
 #define ANNOTATIONS_H
 
 #include <QHash>
+#include <QMutex>
 #include <QString>
 #include <QStringList>
 
+#include <memory>
+
+/*
+ * Immutable lookup tables built from the loaded annotation, BrickLink
+ * and Rebrickable lists. Part ids are interned once as lower case keys
+ * and (part, colour) pairs use integer keys. A built catalog is never
+ * modified so it can be shared by render and export threads.
+ */
+class AnnotationCatalog
+{
+  public:
+    struct Style {
+        int     style;
+        int     category;
+        QString annotation;
+    };
+    struct BLElement {
+        QString itemColor;
+        QString element;
+    };
+
+    static quint64 key(int part, int color)
+    {
+        return (quint64(quint32(part)) << 32) | quint32(color);
+    }
+
+    int partIndex(const QString &part) const
+    {
+        return partIndexes.value(part.toLower(), -1);
+    }
+
+    int internPart(const QString &part);
+
+    QHash<QString, int>       partIndexes;   // interned lower case part ids
+    QHash<QString, QString>   freeform;
+    QHash<QString, Style>     styles;
+    QHash<quint64, BLElement> blElements;    // (BrickLink item, BrickLink colour)
+    QHash<quint64, QString>   legoElements;  // (LDraw part, LDraw colour)
+    QHash<int, int>           ld2blColors;
+    QHash<int, QString>       ld2blParts;
+    QHash<int, int>           ld2blPartIndexes;
+    QHash<int, int>           ld2rbColors;
+    QHash<int, QString>       ld2rbParts;
+};
+
 class Annotations {
   private:
-    static int                         returnInt;
-    static QString                     returnString;
+    static QMutex                      catalogMutex;
+    static std::shared_ptr<const AnnotationCatalog> _catalog;
+    static std::shared_ptr<const AnnotationCatalog> catalog();
+    static void invalidateCatalog();
+
     static QList<QString>              titleAnnotations;
     static QHash<QString, QString>     freeformAnnotations;
     static QHash<QString, QStringList> annotationStyles;
@@ -37,10 +86,10 @@ class Annotations {
     static QHash<QString, QString>     ld2rbCodesXRef;
   public:
     Annotations();
-    static const QString &freeformAnnotation(QString part);
-    static const int &getAnnotationStyle(QString part);
-    static const int &getAnnotationCategory(QString part);
-    static const QString &getStyleAnnotation(QString part);
+    static QString freeformAnnotation(const QString &part);
+    static int getAnnotationStyle(const QString &part);
+    static int getAnnotationCategory(const QString &part);
+    static QString getStyleAnnotation(const QString &part);
     static bool exportAnnotationStyleFile();
     static void loadDefaultAnnotationStyles(QByteArray &Buffer);
     static bool overwriteFile(const QString &file);
@@ -56,15 +105,16 @@ class Annotations {
     static bool loadBLCodes(QByteArray &Buffer);
     static bool loadLEGOElements();
 
-    static const QString &getBLColorID(QString blcolorname);
-    static const QString &getLEGOElement(QString elementkey);
-    static const QString &getBLElement(QString ldcolorid,
-                                       QString ldpartid,
-                                       int     which = 0);
-    static const QString &getBrickLinkPartId(QString ldpartid);
-    static const int &getBrickLinkColor(int ldcolorid);
-    static const int &getRBColorID(QString blcolorid);
-    static const QString &getRBPartID(QString blpartid);
+    static QString getBLColorID(const QString &blcolorname);
+    static QString getLEGOElement(const QString &ldpartid,
+                                  const QString &ldcolorid);
+    static QString getBLElement(const QString &ldcolorid,
+                                const QString &ldpartid,
+                                int            which = 0);
+    static QString getBrickLinkPartId(const QString &ldpartid);
+    static int getBrickLinkColor(int ldcolorid);
+    static int getRBColorID(const QString &ldcolorid);
+    static QString getRBPartID(const QString &ldpartid);
 
     static bool exportBLColorsFile();
     static bool exportLD2BLColorsXRefFile();
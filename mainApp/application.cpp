@@ -27,6 +27,7 @@
 #include "lc_profile.h"
 
 #include "updatecheck.h"
+#include "tracer.h"
 
 #include "QsLogDest.h"
 
@@ -339,6 +340,15 @@ void Application::initialize()
             if (Param == QLatin1String("-ns") || Param == QLatin1String("--no-stdout-log"))
                 Preferences::setStdOutToLogPreference(true);
             else
+            // Page build pipeline trace
+            if (Param == QLatin1String("-tr") || Param == QLatin1String("--trace-file"))
+            {
+                if (ArgIdx < NumArguments - 1 && Arguments[ArgIdx + 1][0] != '-')
+                    Tracer::start(QDir::toNativeSeparators(QFileInfo(Arguments[++ArgIdx]).absoluteFilePath()));
+                else
+                    fprintf(stdout, "Not enough parameters for the '%s' argument.\n", Param.toLatin1().constData());
+            }
+            else
             // Version output
             if (Param == QLatin1String("-v") || Param == QLatin1String("--version"))
             {
@@ -377,6 +387,17 @@ void Application::initialize()
                 fprintf(stdout, "  +ll, ++liblego: Load the LDraw LEGO archive parts library in GUI mode.\n");
                 fprintf(stdout, "  +lt, ++libtente: Load the LDraw TENTE archive parts library in GUI mode.\n");
                 fprintf(stdout, "  +lv, ++libvexiq: Load the LDraw VEXIQ archive parts library in GUI mode.\n");
+                fprintf(stdout, "  -bm, --benchmark: Time the model load and page build pipeline and save the results as JSON. Uses a synthetic model when no LDraw file is given.\n");
+                fprintf(stdout, "  --benchmark-buffer-exchange: Add buffer exchange steps to the synthetic benchmark model. Default is off.\n");
+                fprintf(stdout, "  --benchmark-callouts: Place synthetic benchmark submodels in callouts. Default is off.\n");
+                fprintf(stdout, "  --benchmark-depth <levels>: Set the synthetic benchmark model submodel depth. Default is 2.\n");
+                fprintf(stdout, "  --benchmark-iterations <count>: Set the timed runs of each benchmark suite. Default is 5.\n");
+                fprintf(stdout, "  --benchmark-mosaic: Colour the synthetic benchmark model with every defined colour and direct colours. Default is off.\n");
+                fprintf(stdout, "  --benchmark-output <file.json>: Designate the benchmark results save file. Default is <model name>_benchmark.json in the working directory.\n");
+                fprintf(stdout, "  --benchmark-parts <count>: Set the synthetic benchmark model parts per step. Default is 8.\n");
+                fprintf(stdout, "  --benchmark-seed <number>: Set the synthetic benchmark model generator seed. Default is 1.\n");
+                fprintf(stdout, "  --benchmark-steps <count>: Set the synthetic benchmark model steps per submodel. Default is 20.\n");
+                fprintf(stdout, "  --benchmark-submodels <count>: Set the synthetic benchmark model submodels per level. Default is 3.\n");
                 fprintf(stdout, "  -d, --image-output-directory <directory>: Designate the png, jpg or bmp save folder using absolute path.\n");
                 fprintf(stdout, "  -fc, --fade-steps-color <LDraw color code>: Set the global fade color. Overridden by fade opacity - if opacity not 100 percent. Default is %s\n",LEGO_FADE_COLOUR_DEFAULT);
                 fprintf(stdout, "  -fo, --fade-step-opacity <percent>: Set the fade steps opacity percent. Overrides fade color - if opacity not 100 percent. Default is %s percent\n",QString(FADE_OPACITY_DEFAULT).toLatin1().constData());
@@ -387,13 +408,15 @@ void Application::initialize()
                 fprintf(stdout, "  -lt, --libtente: Load the LDraw TENTE archive parts library in command console mode.\n");
                 fprintf(stdout, "  -lv, --libvexiq: Load the LDraw VEXIQ archive parts library in command console mode.\n");
                 fprintf(stdout, "  -ns, --no-stdout-log: Do not enable standard output for logged entries. Useful on Linux to prevent double (stdout and QSLog) output. Default is off.\n");
-                fprintf(stdout, "  -o, --export-option <option>: Set output format pdf, png, jpeg, bmp, stl, 3ds, pov, dae or obj. Used with process-export. Default is pdf.\n");
+                fprintf(stdout, "  -o, --export-option <option>: Set output format pdf, png, jpeg, bmp, stl, 3ds, pov, dae, obj or glb. Used with process-export. Default is pdf.\n");
                 fprintf(stdout, "  -of, --pdf-output-file <path>: Designate the pdf document save file using absolute path.\n");
+                fprintf(stdout, "  -ir, --pdf-image-resolution <dpi>: Set the maximum resolution of images embedded in the pdf document. Default is 0 (full resolution).\n");
                 fprintf(stdout, "  -p, --preferred-renderer <renderer>: Set renderer native, ldglite, ldview, ldview-sc, ldview-scsl, povray, or povray-ldv. Default is native.\n ");
                 fprintf(stdout, "  -pe, --process-export: Export instruction document or images. Used with export-option. Default is pdf document.\n");
                 fprintf(stdout, "  -pf, --process-file: Process ldraw file and generate images in png format.\n");
                 fprintf(stdout, "  -r, --range <page range>: Set page range - e.g. 1,2,9,10-42. Default is all pages.\n");
                 fprintf(stdout, "  -rs, --reset-search-dirs: Reset the LDraw parts directories to those searched by default. Default is off.\n");
+                fprintf(stdout, "  -tr, --trace-file <path>: Record page build pipeline timings and save them as Chrome trace JSON using absolute path. Default is off.\n");
                 fprintf(stdout, "  -v, --version: Output LPub3D version information and exit.\n");
                 fprintf(stdout, "  -x, --clear-cache: Reset the LDraw file and image caches. Used with export-option change. Default is off.\n");
 //              fprintf(stdout, "  -im, --image-matte: [Experimental] Turn on image matting for fade previous step. Combine current and previous images using pixel blending - LDView only. Default is off.\n");
@@ -409,8 +432,10 @@ void Application::initialize()
                 fprintf(stdout, "  -vv, --viewer-version: Output 3DViewer - by LeoCAD version information and exit.\n");
                 fprintf(stdout, "  -3ds, --export-3ds <outfile.3ds>: Export the model to 3D Studio 3DS format.\n");
                 fprintf(stdout, "  -dae, --export-collada <outfile.dae>: Export the model to COLLADA DAE format.\n");
+                fprintf(stdout, "  -glb, --export-gltf <outfile.glb>: Export the model to instanced glTF binary GLB format.\n");
                 fprintf(stdout, "  -html, --export-html <folder>: Create an HTML page for the model.\n");
                 fprintf(stdout, "  -obj, --export-wavefront <outfile.obj>: Export the model to Wavefront OBJ format.\n");
+                fprintf(stdout, "  -pov, --export-povray <outfile.pov>: Export the model to POV-Ray format.\n");
                 fprintf(stdout, "  --camera-angles <latitude> <longitude>: Set the camera angles in degrees around the model.\n");
                 fprintf(stdout, "  --highlight: Highlight parts in the steps they appear.\n");
                 fprintf(stdout, "  --html-parts-height <height>: Set the HTML part pictures height.\n");
@@ -535,6 +560,9 @@ void Application::initialize()
         logger.addDestination(debugDestination);
         logger.addDestination(fileDestination);
 
+        // write log messages from a background thread
+        logger.setAsynchronous(true);
+
         // logging examples
         bool showLogExamples = false;
         if (showLogExamples)
@@ -563,6 +591,8 @@ void Application::initialize()
         logger.setLoggingLevel(OffLevel);
     }
 
+    Gui::setMessageLogging();
+
     qRegisterMetaType<LogType>("LogType");
 
     logInfo() << QString("Initializing application...");
@@ -735,8 +765,19 @@ int Application::run()
     emit gui->messageSig(LOG_ERROR, QString("Run: An unhandled exception has been thrown."));
   }
 
+  if (Tracer::enabled())
+  {
+      bool traced = Tracer::finish();
+      emit gui->messageSig(traced ? LOG_INFO : LOG_ERROR, QString("Run: %1 page build trace.")
+                           .arg(traced ? "Saved" : "Could not save"));
+  }
+
   emit gui->messageSig(LOG_INFO, QString("Run: Application terminated with return code %1.").arg(ExecReturn));
 
+  // write any queued log messages and log synchronously from here on
+  QsLogging::Logger::instance().setAsynchronous(false);
+  Gui::flushStdOut();
+
   if (!m_print_output)
   {
     delete gMainWindow;
@@ -0,0 +1,612 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Trevor SANDY. All rights reserved.
+**
+** This file may be used under the terms of the
+** GNU General Public License (GPL) version 3.0
+** which accompanies this distribution, and is
+** available at http://www.gnu.org/licenses/gpl.html
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include "benchmark.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSet>
+#include <QTextStream>
+
+#include <algorithm>
+
+#include "lpub.h"
+#include "lpub_preferences.h"
+#include "ldrawfiles.h"
+#include "excludedparts.h"
+#include "pli.h"
+#include "render.h"
+#include "meta.h"
+#include "version.h"
+#include "color.h"
+
+#include "lc_application.h"
+#include "lc_colors.h"
+#include "lc_library.h"
+#include "lc_meshloader.h"
+#include "lc_zipfile.h"
+#include "lc_file.h"
+#include "pieceinf.h"
+
+namespace {
+
+/*
+ * Common official parts and colours so the synthetic model resolves
+ * against any complete LDraw library.
+ */
+const char *const benchmarkParts[] = {
+  "3001.dat",  "3003.dat",  "3004.dat",  "3010.dat",  "3020.dat",
+  "3022.dat",  "3023.dat",  "3024.dat",  "3039.dat",  "3040b.dat",
+  "3062b.dat", "3068b.dat", "3069b.dat", "3070b.dat", "3622.dat",
+  "3623.dat",  "3710.dat",  "3795.dat",  "4070.dat",  "6141.dat"
+};
+const int benchmarkColours[] = { 0, 1, 2, 4, 14, 15, 19, 25, 71, 72 };
+
+const int numBenchmarkParts   = int(sizeof(benchmarkParts) / sizeof(benchmarkParts[0]));
+
+// Linear congruential generator, so a seed gives the same model on every platform and Qt version
+class ModelRandom
+{
+public:
+  explicit ModelRandom(quint32 seed) : _state(seed) {}
+  int bounded(int range)
+  {
+    _state = _state * 1664525u + 1013904223u;
+    return int((_state >> 8) % quint32(range));
+  }
+private:
+  quint32 _state;
+};
+
+QString modelName(int level, int index)
+{
+  return level == 0 ? QString("benchmark.ldr") : QString("benchmark_%1_%2.ldr").arg(level).arg(index);
+}
+
+QString partLine(ModelRandom &random, const QString &type, const QString &colour)
+{
+  return QString("1 %1 %2 %3 %4 1 0 0 0 1 0 0 0 1 %5")
+         .arg(colour)
+         .arg((random.bounded(21) - 10) * 20)
+         .arg(-random.bounded(10) * 24)
+         .arg((random.bounded(21) - 10) * 20)
+         .arg(type);
+}
+
+struct SuiteResult
+{
+  QString         name;
+  qint64          items;
+  QVector<double> samples; // milliseconds
+};
+
+template <typename Function>
+SuiteResult timeSuite(const QString &name, int iterations, Function function)
+{
+  SuiteResult result;
+  result.name  = name;
+  result.items = 0;
+
+  QElapsedTimer timer;
+  for (int i = 0; i < iterations; i++) {
+    timer.start();
+    result.items = function();
+    result.samples.append(double(timer.nsecsElapsed()) / 1000000.0);
+  }
+
+  emit gui->messageSig(LOG_INFO, QString("Benchmark %1: %2 ms best of %3 runs (%4 items).")
+                       .arg(name)
+                       .arg(*std::min_element(result.samples.constBegin(), result.samples.constEnd()), 0, 'f', 3)
+                       .arg(iterations)
+                       .arg(result.items));
+  return result;
+}
+
+QJsonObject suiteObject(const SuiteResult &result)
+{
+  QVector<double> sorted = result.samples;
+  std::sort(sorted.begin(), sorted.end());
+
+  double total = 0.0;
+  QJsonArray samples;
+  for (double sample : result.samples) {
+    total += sample;
+    samples.append(sample);
+  }
+
+  QJsonObject suite;
+  suite["name"]       = result.name;
+  suite["iterations"] = sorted.size();
+  suite["items"]      = double(result.items);
+  suite["min_ms"]     = sorted.isEmpty() ? 0.0 : sorted.first();
+  suite["median_ms"]  = sorted.isEmpty() ? 0.0 : sorted.at(sorted.size() / 2);
+  suite["mean_ms"]    = sorted.isEmpty() ? 0.0 : total / sorted.size();
+  suite["max_ms"]     = sorted.isEmpty() ? 0.0 : sorted.last();
+  suite["samples_ms"] = samples;
+  return suite;
+}
+
+/*
+ * The sscanf conversions lcMeshLoader::ReadMeshData made before it used
+ * lcParseMeshLine, kept as the reference for the conformance check.
+ */
+bool scanMeshLine(const char *line, lcMeshLine &meshLine)
+{
+  int colorCode;
+  if (sscanf(line, "%d %d", &meshLine.LineType, &colorCode) != 2)
+    return false;
+
+  meshLine.ColorCode    = quint32(colorCode);
+  meshLine.ColorCodeHex = meshLine.ColorCode;
+  meshLine.NumValues    = 0;
+  meshLine.FileName[0]  = 0;
+  if (meshLine.LineType < 1 || meshLine.LineType > 5)
+    return true;
+
+  if (colorCode == 0)
+    sscanf(line, "%*d %i", reinterpret_cast<int *>(&meshLine.ColorCodeHex));
+
+  float *v = meshLine.Values;
+  int scanned = 0;
+  switch (meshLine.LineType) {
+  case 1:
+    scanned = sscanf(line, "%*d %*i %f %f %f %f %f %f %f %f %f %f %f %f %1023s",
+                     &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6], &v[7], &v[8], &v[9], &v[10], &v[11], meshLine.FileName);
+    break;
+  case 2:
+    scanned = sscanf(line, "%*d %*i %f %f %f %f %f %f", &v[0], &v[1], &v[2], &v[3], &v[4], &v[5]);
+    break;
+  case 3:
+    scanned = sscanf(line, "%*d %*i %f %f %f %f %f %f %f %f %f", &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6], &v[7], &v[8]);
+    break;
+  default:
+    scanned = sscanf(line, "%*d %*i %f %f %f %f %f %f %f %f %f %f %f %f",
+                     &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6], &v[7], &v[8], &v[9], &v[10], &v[11]);
+    break;
+  }
+  meshLine.NumValues = qBound(0, scanned, meshLine.LineType == 2 ? 6 : meshLine.LineType == 3 ? 9 : 12);
+  return true;
+}
+
+bool sameMeshLine(const lcMeshLine &a, const lcMeshLine &b)
+{
+  return a.LineType     == b.LineType     &&
+         a.ColorCode    == b.ColorCode    &&
+         a.ColorCodeHex == b.ColorCodeHex &&
+         a.NumValues    == b.NumValues    &&
+         memcmp(a.Values, b.Values, sizeof(float) * size_t(a.NumValues)) == 0 &&
+         strcmp(a.FileName, b.FileName) == 0;
+}
+
+} // namespace
+
+/*
+ * The main model and each submodel level hold options.steps steps of
+ * options.partsPerStep parts. The first options.submodels steps of every
+ * model above the deepest level add one submodel of the next level, so
+ * each submodel is shared by all the models of the level above it. Every
+ * fourth step is a ROTSTEP to exercise part rotation. A mosaic model draws
+ * part colours from every colour code in the loaded colour table, and one
+ * part in four uses a direct 0x2RRGGBB colour.
+ */
+bool Benchmark::generateModel(const QString &fileName, const BenchmarkOptions &options)
+{
+  QFile file(fileName);
+  if (!file.open(QFile::WriteOnly | QFile::Text)) {
+    emit gui->messageSig(LOG_ERROR, QString("Cannot write benchmark model %1:\n%2.")
+                         .arg(fileName)
+                         .arg(file.errorString()));
+    return false;
+  }
+
+  ModelRandom random(options.seed);
+  QTextStream out(&file);
+
+  QVector<int> colours;
+  if (options.mosaic)
+    for (const lcColor &colour : gColorList)
+      if (colour.Code != 16 && colour.Code != 24 && colour.Code < LC_COLOR_DIRECT)
+        colours << int(colour.Code);
+  if (colours.isEmpty())
+    for (int colour : benchmarkColours)
+      colours << colour;
+
+  const int depth = qMax(0, options.submodelDepth);
+  for (int level = 0; level <= depth; level++) {
+    const int models = level == 0 ? 1 : qMax(1, qMin(options.submodels, options.steps));
+    for (int index = 0; index < models; index++) {
+      const QString name = modelName(level, index);
+      out << "0 FILE " << name << "\n"
+          << "0 Benchmark model level " << level << " number " << index << "\n"
+          << "0 Name: " << name << "\n"
+          << "0 Author: LPub3D Benchmark\n";
+
+      for (int step = 0; step < options.steps; step++) {
+        if (options.bufferExchange && step % 5 == 3)
+          out << "0 BUFEXCHG A STORE\n";
+        if (options.bufferExchange && step % 5 == 4)
+          out << "0 BUFEXCHG A RETRIEVE\n";
+
+        if (level < depth && step < options.submodels) {
+          if (options.callouts)
+            out << "0 !LPUB CALLOUT BEGIN\n";
+          out << partLine(random, modelName(level + 1, step), "16") << "\n";
+          if (options.callouts)
+            out << "0 !LPUB CALLOUT END\n";
+        }
+
+        for (int part = 0; part < options.partsPerStep; part++) {
+          const QString type = benchmarkParts[random.bounded(numBenchmarkParts)];
+          QString colour;
+          if (options.mosaic && random.bounded(4) == 0)
+            colour = QString("0x2%1").arg(random.bounded(0x1000000), 6, 16, QChar('0'));
+          else
+            colour = QString::number(colours.at(random.bounded(colours.size())));
+          out << partLine(random, type, colour) << "\n";
+        }
+
+        if (step % 4 == 3)
+          out << "0 ROTSTEP 0 " << (random.bounded(8) * 45) << " 0 ABS\n";
+        else
+          out << "0 STEP\n";
+      }
+      out << "0 NOFILE\n";
+    }
+  }
+
+  out.flush();
+  return file.error() == QFile::NoError;
+}
+
+int Benchmark::run(const QString &resultFile, const QString &modelFile, const BenchmarkOptions &options)
+{
+  const int iterations = qMax(1, options.iterations);
+
+  // never overwrite a model or other document with the results
+  QFileInfo resultInfo(resultFile);
+  if (resultInfo.exists() && resultInfo.suffix().toLower() != "json") {
+    emit gui->messageSig(LOG_ERROR, QString("Benchmark results file %1 exists and is not a JSON file.")
+                         .arg(resultFile));
+    return 1;
+  }
+
+  QString fileName = modelFile;
+  if (fileName.isEmpty()) {
+    fileName = QDir::toNativeSeparators(QString("%1/lpub3d_benchmark_%2.mpd")
+                                        .arg(QDir::tempPath())
+                                        .arg(options.seed));
+    if (!generateModel(fileName, options))
+      return 1;
+  }
+  fileName = QFileInfo(fileName).absoluteFilePath();
+
+  emit gui->messageSig(LOG_INFO, QString("Benchmark model %1.").arg(fileName));
+
+  QFile modelData(fileName);
+  if (!modelData.open(QFile::ReadOnly | QFile::Text)) {
+    emit gui->messageSig(LOG_ERROR, QString("Cannot read benchmark model %1:\n%2.")
+                         .arg(fileName)
+                         .arg(modelData.errorString()));
+    return 1;
+  }
+  const qint64 modelBytes = modelData.size();
+  const QStringList lines = QString::fromUtf8(modelData.readAll()).split("\n");
+  modelData.close();
+
+  QStringList partLines;
+  QStringList partColours;
+  QSet<QString> partTypes;
+  for (const QString &line : lines) {
+    QString trimmed = line.trimmed();
+    if (trimmed.startsWith("1 ")) {
+      partLines << trimmed;
+      QStringList tokens;
+      split(trimmed, tokens);
+      if (tokens.size() == 15 && tokens[14].endsWith(".dat", Qt::CaseInsensitive))
+        partTypes.insert(tokens[14].toLower());
+      if (tokens.size() > 1)
+        partColours << tokens[1];
+    }
+  }
+  // a representative step for the rotation suite
+  const QStringList stepParts = partLines.mid(0, qMax(1, options.partsPerStep));
+
+  QList<SuiteResult> results;
+
+  // line tokenizing, string copies against offsets
+  results << timeSuite("split", iterations, [&lines]() {
+    QStringList tokens;
+    for (const QString &line : lines)
+      split(line, tokens);
+    return qint64(lines.size());
+  });
+  results << timeSuite("tokenize", iterations, [&lines]() {
+    LDrawTokens tokens;
+    for (const QString &line : lines)
+      tokens.tokenize(line);
+    return qint64(lines.size());
+  });
+
+  // excluded part lookups made while counting parts
+  results << timeSuite("lineHasExcludedPart", iterations, [&partLines]() {
+    qint64 excluded = 0;
+    for (const QString &line : partLines)
+      if (ExcludedParts::lineHasExcludedPart(line))
+        excluded++;
+    return excluded;
+  });
+
+  // model load, parsed and then restored from its snapshot
+  const bool snapshotCache = Preferences::modelSnapshotCache;
+  Preferences::modelSnapshotCache = false;
+  results << timeSuite("loadFile", iterations, [&fileName]() {
+    gui->ldrawFile.loadFile(fileName);
+    return qint64(gui->ldrawFile.subFileOrder().size());
+  });
+  Preferences::modelSnapshotCache = true;
+  gui->ldrawFile.loadFile(fileName);
+  results << timeSuite("loadFileSnapshot", iterations, [&fileName]() {
+    gui->ldrawFile.loadFile(fileName);
+    return qint64(gui->ldrawFile.subFileOrder().size());
+  });
+  Preferences::modelSnapshotCache = snapshotCache;
+
+  // page build passes over the fully opened model
+  if (!gui->openFile(fileName))
+    return 1;
+
+  results << timeSuite("countInstances", iterations, []() {
+    gui->ldrawFile.countInstances();
+    return qint64(gui->ldrawFile.subFileOrder().size());
+  });
+
+  results << timeSuite("writeToTmp", iterations, []() {
+    gui->ldrawFile.tempCacheCleared();
+    gui->writeToTmp();
+    return qint64(gui->ldrawFile.subFileOrder().size());
+  });
+
+  results << timeSuite("countPages", iterations, []() {
+    gui->ldrawFile.unrendered();
+    gui->maxPages = -1;
+    gui->countPages();
+    return qint64(gui->maxPages);
+  });
+
+  // part list sort over every part type and colour used by the model
+  results << timeSuite("sortParts", iterations, [&partLines]() {
+    Pli pli;
+    pli.pliMeta.sort.setValue(true);
+    QHash<QString, PliPart*> parts;
+    for (const QString &line : partLines) {
+      QStringList tokens;
+      split(line, tokens);
+      if (tokens.size() != 15)
+        continue;
+      const QString key = QString("%1_%2").arg(tokens[14]).arg(tokens[1]);
+      if (parts.contains(key))
+        continue;
+      PliPart *part      = new PliPart(tokens[14], tokens[1]);
+      part->sortColour   = QString("%1").arg(tokens[1].toInt(), 5, 10, QChar('0'));
+      part->sortCategory = tokens[14].left(2);
+      part->sortSize     = tokens[14].left(4);
+      part->sortElement  = key;
+      parts.insert(key, part);
+    }
+    pli.sortedKeys = parts.keys();
+    pli.sortParts(parts);
+    qDeleteAll(parts);
+    return qint64(pli.sortedKeys.size());
+  });
+
+  // in memory rotation of a step's parts
+  Meta meta;
+  RotStepData rotStepData;
+  rotStepData.rots[1] = 45;
+  rotStepData.type    = "ABS";
+  meta.rotStep.setValue(rotStepData);
+  results << timeSuite("rotateParts", iterations, [&stepParts, &meta]() {
+    const QString addLine = "1 color 0 0 0 1 0 0 0 1 0 0 0 1 foo.ldr";
+    QStringList parts = stepParts;
+    Render::rotateParts(addLine, meta.rotStep, parts, meta.LPub.assem.cameraAngles, false);
+    return qint64(parts.size());
+  });
+
+  // colour code lookups for every part line, 3DViewer and LPub3D tables
+  std::vector<quint32> colourCodes;
+  for (const QString &colour : partColours) {
+    bool ok;
+    if (colour.startsWith("0x2", Qt::CaseInsensitive)) {
+      const quint32 rgb = colour.mid(3).toUInt(&ok, 16);
+      if (ok)
+        colourCodes.push_back((rgb & 0xffffff) | LC_COLOR_DIRECT);
+    } else {
+      const quint32 code = colour.toUInt(&ok);
+      if (ok)
+        colourCodes.push_back(code);
+    }
+  }
+  results << timeSuite("colorIndex", iterations, [&colourCodes]() {
+    qint64 found = 0;
+    for (quint32 code : colourCodes)
+      if (lcGetColorIndex(code) >= 0)
+        found++;
+    return found;
+  });
+  results << timeSuite("ldrawColor", iterations, [&partColours]() {
+    qint64 found = 0;
+    for (const QString &colour : partColours)
+      if (LDrawColor::color(colour).isValid())
+        found++;
+    return found;
+  });
+
+  // library mesh loader over each distinct part type not already in use
+  lcPiecesLibrary *library = lcGetPiecesLibrary();
+  if (library) {
+    QList<PieceInfo*> pieces;
+    for (const QString &type : partTypes) {
+      PieceInfo *info = library->FindPiece(type.toLatin1().constData(), nullptr, false, false);
+      if (info && info->GetRefCount() == 0)
+        pieces << info;
+    }
+    results << timeSuite("meshLoader", iterations, [library, &pieces]() {
+      for (PieceInfo *info : pieces) {
+        library->LoadPieceInfo(info, true, true);
+        library->ReleasePieceInfo(info);
+      }
+      return qint64(pieces.size());
+    });
+  }
+
+  // geometry line parsing over the official library, checked against sscanf
+  QJsonObject meshLines;
+  std::vector<QByteArray> libraryLines;
+  lcZipFile libraryArchive;
+  if (libraryArchive.OpenRead(Preferences::lpub3dLibFile)) {
+    for (int fileIdx = 0; fileIdx < libraryArchive.mFiles.GetSize(); fileIdx++) {
+      lcMemFile file;
+      if (!libraryArchive.ExtractFile(fileIdx, file))
+        continue;
+      char line[1024];
+      int lineType;
+      while (file.ReadLine(line, sizeof(line)))
+        if (sscanf(line, "%d", &lineType) == 1 && lineType >= 1 && lineType <= 5)
+          libraryLines.push_back(QByteArray(line));
+    }
+  }
+  if (!libraryLines.empty()) {
+    qint64 mismatches = 0;
+    for (const QByteArray &line : libraryLines) {
+      lcMeshLine parsed, scanned;
+      const bool parsedOk  = lcParseMeshLine(line.constData(), parsed);
+      const bool scannedOk = scanMeshLine(line.constData(), scanned);
+      if (parsedOk != scannedOk || (parsedOk && !sameMeshLine(parsed, scanned))) {
+        if (mismatches++ < 10)
+          emit gui->messageSig(LOG_NOTICE, QString("Benchmark line parser mismatch: %1").arg(QString(line).trimmed()));
+      }
+    }
+    emit gui->messageSig(mismatches ? LOG_ERROR : LOG_INFO,
+                         QString("Benchmark line parser conformance: %1 mismatches in %2 library lines.")
+                         .arg(mismatches).arg(libraryLines.size()));
+    meshLines["library"]    = Preferences::lpub3dLibFile;
+    meshLines["lines"]      = double(libraryLines.size());
+    meshLines["mismatches"] = double(mismatches);
+
+    results << timeSuite("meshLineScanf", iterations, [&libraryLines]() {
+      lcMeshLine meshLine;
+      for (const QByteArray &line : libraryLines)
+        scanMeshLine(line.constData(), meshLine);
+      return qint64(libraryLines.size());
+    });
+    results << timeSuite("meshLineParse", iterations, [&libraryLines]() {
+      lcMeshLine meshLine;
+      for (const QByteArray &line : libraryLines)
+        lcParseMeshLine(line.constData(), meshLine);
+      return qint64(libraryLines.size());
+    });
+
+    // exporter number formatting over the same values, checked against the
+    // sprintf output the OBJ and POV-Ray exporters wrote before
+    std::vector<float> values;
+    for (const QByteArray &line : libraryLines) {
+      lcMeshLine meshLine;
+      if (lcParseMeshLine(line.constData(), meshLine))
+        values.insert(values.end(), meshLine.Values, meshLine.Values + meshLine.NumValues);
+    }
+    qint64 formatMismatches = 0;
+    for (const float value : values) {
+      for (const int decimals : { 2, 4 }) {
+        char formatted[64], printed[64];
+        lcFormatFixed(formatted, value, decimals);
+        sprintf(printed, "%.*f", decimals, value);
+        if (strcmp(formatted, printed) != 0 && formatMismatches++ < 10)
+          emit gui->messageSig(LOG_NOTICE, QString("Benchmark fixed format mismatch: %1 printed %2").arg(formatted).arg(printed));
+      }
+    }
+    emit gui->messageSig(formatMismatches ? LOG_ERROR : LOG_INFO,
+                         QString("Benchmark fixed format conformance: %1 mismatches in %2 library values.")
+                         .arg(formatMismatches).arg(values.size()));
+    meshLines["values"]           = double(values.size());
+    meshLines["formatMismatches"] = double(formatMismatches);
+
+    results << timeSuite("formatSprintf", iterations, [&values]() {
+      char text[64];
+      for (const float value : values)
+        sprintf(text, "%.*f", 4, value);
+      return qint64(values.size());
+    });
+    results << timeSuite("formatFixed", iterations, [&values]() {
+      char text[64];
+      for (const float value : values)
+        lcFormatFixed(text, value, 4);
+      return qint64(values.size());
+    });
+  }
+
+  // results
+  QJsonObject model;
+  model["file"]           = fileName;
+  model["synthetic"]      = modelFile.isEmpty();
+  model["bytes"]          = double(modelBytes);
+  model["lines"]          = lines.size();
+  model["parts"]          = partLines.size();
+  model["colours"]        = partColours.toSet().size();
+  model["submodels"]      = gui->ldrawFile.subFileOrder().size();
+  model["pages"]          = gui->maxPages;
+  if (modelFile.isEmpty()) {
+    model["submodelDepth"]  = options.submodelDepth;
+    model["submodelsPerLevel"] = options.submodels;
+    model["steps"]          = options.steps;
+    model["partsPerStep"]   = options.partsPerStep;
+    model["callouts"]       = options.callouts;
+    model["bufferExchange"] = options.bufferExchange;
+    model["mosaic"]         = options.mosaic;
+    model["seed"]           = double(options.seed);
+  }
+  model["fadeSteps"]      = Preferences::enableFadeSteps;
+  model["highlightStep"]  = Preferences::enableHighlightStep;
+
+  QJsonArray suites;
+  for (const SuiteResult &result : results)
+    suites.append(suiteObject(result));
+
+  QJsonObject root;
+  root["version"]    = QString(VER_PRODUCTVERSION_STR);
+  root["revision"]   = QString(VER_REVISION_STR);
+  root["qt"]         = QString(qVersion());
+  root["renderer"]   = Preferences::preferredRenderer;
+  root["iterations"] = iterations;
+  root["model"]      = model;
+  if (!meshLines.isEmpty())
+    root["meshLines"] = meshLines;
+  root["suites"]     = suites;
+
+  const QByteArray json = QJsonDocument(root).toJson();
+  QFile file(resultFile);
+  if (!file.open(QFile::WriteOnly)) {
+    emit gui->messageSig(LOG_ERROR, QString("Cannot write benchmark results %1:\n%2.")
+                         .arg(resultFile)
+                         .arg(file.errorString()));
+    return 1;
+  }
+  file.write(json);
+  emit gui->messageSig(LOG_INFO, QString("Benchmark results saved to %1.").arg(resultFile));
+  return 0;
+}
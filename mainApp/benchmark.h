@@ -0,0 +1,78 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Trevor SANDY. All rights reserved.
+**
+** This file may be used under the terms of the
+** GNU General Public License (GPL) version 3.0
+** which accompanies this distribution, and is
+** available at http://www.gnu.org/licenses/gpl.html
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+/****************************************************************************
+ *
+ * Headless timing suites for the model load and page build pipeline.
+ *
+ * Benchmark::run() times line tokenizing, excluded part lookups,
+ * LDrawFile::loadFile (parsed and from snapshot), countInstances,
+ * writeToTmp, the findPage pass of countPages, Pli::sortParts,
+ * Render::rotateParts, colour code lookups, the 3DViewer library mesh
+ * loader, the mesh loader's geometry line parser and the exporters' number
+ * formatting, then writes the results as JSON. The line parser and the
+ * number formatting are also checked against the sscanf and sprintf calls
+ * they replaced over every line of the official library archive.
+ *
+ * Without a model file the suites run against a synthetic MPD written by
+ * Benchmark::generateModel(). The generator is seeded, so the same options
+ * always produce the same model and results from different builds can be
+ * compared directly. The mosaic option colours the synthetic model with
+ * every colour defined by the loaded colour table and with direct colours
+ * to time colour lookups over a colour rich model.
+ *
+ * See the --benchmark command line option.
+ *
+ ***************************************************************************/
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <QString>
+
+class BenchmarkOptions
+{
+public:
+  int     submodelDepth;  // levels of nested submodels below the main model
+  int     submodels;      // submodels at each level
+  int     steps;          // steps in each model
+  int     partsPerStep;
+  bool    callouts;       // place submodels in callouts
+  bool    bufferExchange; // store and retrieve the step buffer every fifth step
+  bool    mosaic;         // colour each part with any defined or a direct colour
+  int     iterations;     // timed runs of each suite
+  quint32 seed;
+
+  BenchmarkOptions()
+  {
+    submodelDepth  = 2;
+    submodels      = 3;
+    steps          = 20;
+    partsPerStep   = 8;
+    callouts       = false;
+    bufferExchange = false;
+    mosaic         = false;
+    iterations     = 5;
+    seed           = 1;
+  }
+};
+
+class Benchmark
+{
+public:
+  static bool generateModel(const QString &fileName, const BenchmarkOptions &options);
+  static int run(const QString &resultFile, const QString &modelFile, const BenchmarkOptions &options);
+};
+
+#endif // BENCHMARK_H
@@ -28,6 +28,61 @@ QHash<QString, QString> LDrawColor::color2value;
 QHash<QString, QString> LDrawColor::color2edge;
 QHash<QString, QString> LDrawColor::color2name;
 QHash<QString, QString> LDrawColor::ldname2ldcolor;
+QVector<QColor> LDrawColor::code2QColor;
+QVector<int> LDrawColor::code2alpha;
+
+/*
+ * This function returns the code table index of a color code string or -1
+ * when the string is not a decimal code below LDRAW_COLOR_TABLE_SIZE written
+ * the way QString::number() writes it, so table and hash lookups agree.
+ */
+static int tableCode(const QString &code)
+{
+  const int size = code.size();
+  if (size == 0 || size > 4 || (size > 1 && code.at(0) == QLatin1Char('0')))
+    return -1;
+
+  int value = 0;
+  for (const QChar c : code) {
+    if (c < QLatin1Char('0') || c > QLatin1Char('9'))
+      return -1;
+    value = value * 10 + (c.unicode() - '0');
+  }
+  return value < LDRAW_COLOR_TABLE_SIZE ? value : -1;
+}
+
+// ASCII hex digit test that is safe for any QChar, unlike isxdigit on toLatin1()
+static bool isHexDigit(const QChar c)
+{
+  return (c >= QLatin1Char('0') && c <= QLatin1Char('9')) ||
+         (c >= QLatin1Char('a') && c <= QLatin1Char('f')) ||
+         (c >= QLatin1Char('A') && c <= QLatin1Char('F'));
+}
+
+/*
+ * This function returns the hex digits of a 0x or # prefixed hex color
+ * expression at the end of the string, ignoring trailing white space, or
+ * an empty string when there is none.
+ */
+static QString hexDigits(const QString &nickname)
+{
+  int end = nickname.size();
+  while (end > 0 && nickname.at(end - 1).isSpace())
+    end--;
+
+  int start = end;
+  while (start > 0 && isHexDigit(nickname.at(start - 1)))
+    start--;
+
+  if (start == end)
+    return QString();
+  if (start >= 1 && nickname.at(start - 1) == QLatin1Char('#'))
+    return nickname.mid(start, end - start);
+  if (start >= 2 && nickname.at(start - 1).toLower() == QLatin1Char('x') &&
+      nickname.at(start - 2) == QLatin1Char('0'))
+    return nickname.mid(start, end - start);
+  return QString();
+}
 
 /*
  * This function extracts colours loaded by the 3DViewer  to
@@ -38,6 +93,8 @@ void LDrawColor::LDrawColorInit()
 {
     name2QColor.clear();
     color2name.clear();
+    code2QColor.fill(QColor(), LDRAW_COLOR_TABLE_SIZE);
+    code2alpha.fill(-1, LDRAW_COLOR_TABLE_SIZE);
 
     for (lcColor& gColor : gColorList)
     {
@@ -64,6 +121,10 @@ void LDrawColor::LDrawColorInit()
         ldname2ldcolor.insert(name.toLower(),code);   // color code from name
         color2name.insert(code,name);                 // color name from code (normal) - e.g. Dark_Nougat
         color2name.insert(color.name(),name);         // color name from value (normal)
+        if (nativeColor->Code < LDRAW_COLOR_TABLE_SIZE) {
+            code2QColor[int(nativeColor->Code)] = color;
+            code2alpha[int(nativeColor->Code)] = alpha;
+        }
     }
 }
 
@@ -73,19 +134,23 @@ void LDrawColor::LDrawColorInit()
  */
 QColor LDrawColor::color(QString nickname)
 {
-  bool isHex = false;
-  QRegExp hexRx("\\s*(0x|#)([\\da-fA-F]+)\\s*$",Qt::CaseInsensitive);
-  QString name(nickname.toUpper());
-  if (!(isHex= nickname.contains(hexRx))){
-      name = nickname.toLower();
+  const int index = tableCode(nickname);
+  if (index != -1 && code2QColor.size() == LDRAW_COLOR_TABLE_SIZE) {
+      const QColor &color = code2QColor.at(index);
+      if (color.isValid())
+          return color;
   }
+
+  const QString hex = hexDigits(nickname);
+  const bool isHex = !hex.isEmpty();
+  const QString name(isHex ? nickname.toUpper() : nickname.toLower());
 //  logDebug() << QString("RECEIVED Color NICKNAME (formatted)  [%1] for QCOLOR").arg(name);
   if (name2QColor.contains(name)) {
 //      logNotice() << QString("RETURNED [%1] from NAME for QCOLOR").arg(name2QColor[name].name());
       return name2QColor[name];
     } else
       if (isHex) {
-          QString prefix("0xf"+hexRx.cap(2));
+          QString prefix("0xf"+hex);
           bool ok;
           QRgb rgb = QRgb(prefix.toLong(&ok,16));
           QColor color(rgb);
@@ -103,6 +168,9 @@ QColor LDrawColor::color(QString nickname)
  */
 int LDrawColor::alpha(QString code)
 {
+  const int index = tableCode(code);
+  if (index != -1 && code2alpha.size() == LDRAW_COLOR_TABLE_SIZE && code2alpha.at(index) != -1)
+    return code2alpha.at(index);
   if (color2alpha.contains(code))
     return color2alpha[code];
   return 255;
@@ -198,6 +266,9 @@ QString LDrawColor::ldColorCode(QString name)
  */
 bool LDrawColor::colorExist(QString code)
 {
+  const int index = tableCode(code);
+  if (index != -1 && code2QColor.size() == LDRAW_COLOR_TABLE_SIZE && code2QColor.at(index).isValid())
+    return true;
   if (name2QColor.contains(code))
     return true;
   return false;
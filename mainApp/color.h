@@ -22,6 +22,11 @@
 #include <QHash>
 #include <QString>
 #include <QColor>
+#include <QVector>
+
+// LDraw color codes below this value are looked up in the code tables
+// rather than the string keyed hash tables.
+#define LDRAW_COLOR_TABLE_SIZE 1024
 
 /*
  * This class encapsulates LDraw color codes, color names and Qt's Qcolor
@@ -44,6 +49,8 @@ class LDrawColor {
     static QHash<QString, QString> color2edge;
     static QHash<QString, QString> color2name;
     static QHash<QString, QString> ldname2ldcolor;
+    static QVector<QColor> code2QColor;           // QColor from code, invalid if code is not defined
+    static QVector<int> code2alpha;               // color alpha from code, -1 if code is not defined
   public:
 
     /*
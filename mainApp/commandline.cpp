@@ -15,6 +15,7 @@
 ****************************************************************************/
 
 #include "application.h"
+#include "benchmark.h"
 #include "lpub.h"
 
 int Gui::processCommandLine()
@@ -30,6 +31,8 @@ int Gui::processCommandLine()
   // Declarations
    int fadeStepsOpacity    = FADE_OPACITY_DEFAULT;
    int highlightLineWidth  = HIGHLIGHT_LINE_WIDTH_DEFAULT;
+   int pdfImageResolution  = Preferences::pdfImageMaxResolution;
+   int benchmarkSeed       = 1;
   bool processExport       = false;
   bool processFile         = false;
   bool fadeSteps           = false;
@@ -39,10 +42,12 @@ int Gui::processCommandLine()
   bool useLDVSingleCall    = false;
   bool useLDVSnapShotList  = false;
   bool useNativeRenderer   = false;
+  bool runBenchmark        = false;
   QString generator        = RENDERER_NATIVE;
+  BenchmarkOptions benchmarkOptions;
 
   QString pageRange, exportOption,
-          commandlineFile, preferredRenderer,
+          commandlineFile, preferredRenderer, benchmarkFile,
           fadeStepsColour, highlightStepColour, message;
 
   // Process parameters
@@ -72,6 +77,14 @@ int Gui::processCommandLine()
           continue;
       }
 
+      /* Treated in Application::initialize(), skip the option and its path */
+      if (Param == QLatin1String("-tr") || Param == QLatin1String("--trace-file"))
+      {
+          if (ArgIdx < NumArguments - 1 && Arguments[ArgIdx + 1][0] != '-')
+              ArgIdx++;
+          continue;
+      }
+
       auto ParseString = [&ArgIdx, &Arguments, NumArguments](QString& Value, bool Required)
       {
           if (ArgIdx < NumArguments - 1 && Arguments[ArgIdx + 1][0] != '-')
@@ -144,6 +157,9 @@ int Gui::processCommandLine()
       if (Param == QLatin1String("-of") || Param == QLatin1String("--pdf-output-file"))
         ParseString(saveFileName, false);
       else
+      if (Param == QLatin1String("-ir") || Param == QLatin1String("--pdf-image-resolution"))
+        ParseInteger(pdfImageResolution);
+      else
       if (Param == QLatin1String("-rs") || Param == QLatin1String("--reset-search-dirs"))
           resetSearchDirs = true;
       else
@@ -164,6 +180,39 @@ int Gui::processCommandLine()
       else
       if (Param == QLatin1String("--line-width"))
         ParseInteger(highlightLineWidth);
+      else
+      if (Param == QLatin1String("-bm") || Param == QLatin1String("--benchmark"))
+        runBenchmark = true;
+      else
+      if (Param == QLatin1String("--benchmark-output"))
+        ParseString(benchmarkFile, true);
+      else
+      if (Param == QLatin1String("--benchmark-depth"))
+        ParseInteger(benchmarkOptions.submodelDepth);
+      else
+      if (Param == QLatin1String("--benchmark-submodels"))
+        ParseInteger(benchmarkOptions.submodels);
+      else
+      if (Param == QLatin1String("--benchmark-steps"))
+        ParseInteger(benchmarkOptions.steps);
+      else
+      if (Param == QLatin1String("--benchmark-parts"))
+        ParseInteger(benchmarkOptions.partsPerStep);
+      else
+      if (Param == QLatin1String("--benchmark-callouts"))
+        benchmarkOptions.callouts = true;
+      else
+      if (Param == QLatin1String("--benchmark-buffer-exchange"))
+        benchmarkOptions.bufferExchange = true;
+      else
+      if (Param == QLatin1String("--benchmark-mosaic"))
+        benchmarkOptions.mosaic = true;
+      else
+      if (Param == QLatin1String("--benchmark-iterations"))
+        ParseInteger(benchmarkOptions.iterations);
+      else
+      if (Param == QLatin1String("--benchmark-seed"))
+        ParseInteger(benchmarkSeed);
       else
         emit messageSig(LOG_INFO,QString("Unknown command line parameter: '%1'.").arg(Param));
     }
@@ -351,6 +400,14 @@ int Gui::processCommandLine()
       Preferences::highlightStepLineWidth = highlightLineWidth;
     }
 
+  if (pdfImageResolution != Preferences::pdfImageMaxResolution) {
+      message = QString("PDF Image Maximum Resolution changed from %1 to %2 DPI.")
+          .arg(Preferences::pdfImageMaxResolution)
+          .arg(pdfImageResolution);
+      emit messageSig(LOG_INFO,message);
+      Preferences::pdfImageMaxResolution = pdfImageResolution;
+    }
+
   if (resetSearchDirs) {
       message = QString("Reset search directories requested..");
       emit messageSig(LOG_INFO,message);
@@ -366,6 +423,17 @@ int Gui::processCommandLine()
       partWorkerLDSearchDirs.resetSearchDirSettings();
     }
 
+  if (runBenchmark) {
+      benchmarkOptions.seed = quint32(benchmarkSeed);
+      emit messageSig(LOG_INFO,QString("Benchmark %1 requested.")
+                      .arg(commandlineFile.isEmpty() ? "synthetic model" : QFileInfo(commandlineFile).fileName()));
+      if (benchmarkFile.isEmpty())
+          benchmarkFile = QString("%1_benchmark.json")
+                          .arg(commandlineFile.isEmpty() ? QString("lpub3d")
+                                                         : QFileInfo(commandlineFile).completeBaseName());
+      return Benchmark::run(QFileInfo(benchmarkFile).absoluteFilePath(), commandlineFile, benchmarkOptions);
+  }
+
   QElapsedTimer commandTimer;
   if (!commandlineFile.isEmpty()) {
       if(resetCache) {
@@ -410,6 +478,9 @@ int Gui::processCommandLine()
             else
             if (exportOption == "obj")
                exportAsObjDialog();
+            else
+            if (exportOption == "glb")
+               exportAsGltfDialog();
             else
                exportAsPdfDialog();
           } else {
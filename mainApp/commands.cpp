@@ -43,7 +43,7 @@ void InsertLineCommand::redo()
   ldrawFile->insertLine(here.modelName,here.lineNumber,line);
   gui->showLine(here);
   if (!isHeader(line))
-     gui->displayPage();
+     gui->requestDisplayPage();
 }
 
 AppendLineCommand::AppendLineCommand(
@@ -63,14 +63,14 @@ void AppendLineCommand::undo()
 {
   ldrawFile->deleteLine(here.modelName,here.lineNumber+1);
   gui->showLine(here);
-  gui->displayPage();
+  gui->requestDisplayPage();
 }
 
 void AppendLineCommand::redo()
 {
   ldrawFile->insertLine(here.modelName,here.lineNumber+1,line);
   gui->showLine(here);
-  gui->displayPage();
+  gui->requestDisplayPage();
 }
 
 DeleteLineCommand::DeleteLineCommand(
@@ -88,7 +88,7 @@ void DeleteLineCommand::undo()
 {
   ldrawFile->insertLine(here.modelName,here.lineNumber,deletedLine);
   gui->showLine(here);
-  gui->displayPage();
+  gui->requestDisplayPage();
 }
 
 void DeleteLineCommand::redo()
@@ -96,7 +96,7 @@ void DeleteLineCommand::redo()
   deletedLine = ldrawFile->readLine(here.modelName, here.lineNumber);
   ldrawFile->deleteLine(here.modelName,here.lineNumber);
   gui->showLine(here);
-  gui->displayPage();
+  gui->requestDisplayPage();
 }
 
 ReplaceLineCommand::ReplaceLineCommand(
@@ -117,7 +117,7 @@ void ReplaceLineCommand::undo()
 {
   ldrawFile->replaceLine(here.modelName,here.lineNumber,oldLine);
   gui->showLine(here);
-  gui->displayPage();
+  gui->requestDisplayPage();
 }
 
 void ReplaceLineCommand::redo()
@@ -126,7 +126,7 @@ void ReplaceLineCommand::redo()
                          here.lineNumber,
                          newLine);
   gui->showLine(here);
-  gui->displayPage();
+  gui->requestDisplayPage();
 }
 
 ContentsChangeCommand::ContentsChangeCommand(
@@ -159,7 +159,7 @@ void ContentsChangeCommand::redo()
     isRedo = true;
   } else {
     gui->maxPages = -1;
-    gui->displayPage();
+    gui->requestDisplayPage();
   }
 }
 
@@ -173,5 +173,41 @@ void ContentsChangeCommand::undo()
     position,
     addedChars.size(),
     removedChars);
-  gui->displayPage();
+  gui->requestDisplayPage();
+}
+
+/*
+ * Coalesce consecutive typing or deleting in the editor
+ * into a single undo step.
+ */
+bool ContentsChangeCommand::mergeWith(const QUndoCommand *command)
+{
+  const ContentsChangeCommand *change = static_cast<const ContentsChangeCommand *>(command);
+
+  if (change->modelName != modelName)
+    return false;
+
+  // characters typed at the end of this change
+  if (change->removedChars.isEmpty() &&
+      change->position == position + addedChars.size()) {
+    addedChars += change->addedChars;
+    return true;
+  }
+
+  // characters deleted just before this deletion
+  if (addedChars.isEmpty() && change->addedChars.isEmpty() &&
+      change->position + change->removedChars.size() == position) {
+    removedChars.prepend(change->removedChars);
+    position = change->position;
+    return true;
+  }
+
+  // characters deleted just after this deletion
+  if (addedChars.isEmpty() && change->addedChars.isEmpty() &&
+      change->position == position) {
+    removedChars += change->removedChars;
+    return true;
+  }
+
+  return false;
 }
@@ -185,9 +185,13 @@ public:
 
   void undo();
   void redo();
+  int  id() const { return ContentsChangeId; }
+  bool mergeWith(const QUndoCommand *command);
 
 private:
 
+  enum { ContentsChangeId = 1 };
+
   LDrawFile *ldrawFile;
   QString    modelName;
   int        position;
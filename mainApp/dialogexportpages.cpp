@@ -113,6 +113,13 @@ DialogExportPages::DialogExportPages(QWidget *parent) :
         ui->checkBoxResetCache->setToolTip(tr("Check to reset all caches before export to OBJ"));
         break;
 
+    case EXPORT_GLTF:
+        setWindowTitle(tr("Export as GLB"));
+        ui->groupBoxPrintOptions->setTitle("Export as GLB options");
+        ui->checkBoxResetCache->setText(tr("Reset all caches before content export to GLB"));
+        ui->checkBoxResetCache->setToolTip(tr("Check to reset all caches before export to GLB"));
+        break;
+
     case EXPORT_STL:
         setWindowTitle(tr("Export as STL"));
         ui->groupBoxPrintOptions->setTitle("Export as STL options");
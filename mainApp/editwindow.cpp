@@ -314,12 +314,19 @@ void EditWindow::contentsChange(
   QString addedChars;
 
   if (charsAdded) {
-    addedChars = _textEdit->toPlainText();
-    if (addedChars.size() == 0) {
+    if (_textEdit->document()->isEmpty()) {
       return;
     }
 
-    addedChars = addedChars.mid(position,charsAdded);
+    // read only the added characters rather than the whole document
+    QTextCursor cursor(_textEdit->document());
+    cursor.setPosition(position);
+    cursor.setPosition(qMin(position + charsAdded, _textEdit->document()->characterCount() - 1),
+                       QTextCursor::KeepAnchor);
+    addedChars = cursor.selectedText();
+    addedChars.replace(QChar::ParagraphSeparator,'\n');
+    addedChars.replace(QChar::LineSeparator,'\n');
+    addedChars.replace(QChar::Nbsp,' ');
   }
 
   contentsChange(fileName, position, charsRemoved, addedChars);
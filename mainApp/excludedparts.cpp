@@ -26,7 +26,7 @@
 
 bool            ExcludedParts::result;
 QString         ExcludedParts::empty;
-QList<QString>  ExcludedParts::excludedParts;
+QSet<QString>   ExcludedParts::excludedParts;
 
 ExcludedParts::ExcludedParts()
 {
@@ -60,7 +60,7 @@ ExcludedParts::ExcludedParts()
                 QString sLine = in.readLine(0);
                 if (sLine.contains(rx)) {
                     QString excludedPartID = rx.cap(1);
-                    excludedParts.append(excludedPartID.toLower().trimmed());
+                    excludedParts.insert(excludedPartID.toLower().trimmed());
                     //logDebug() << "** ExcludedPartID: " << excludedPartID.toLower();
                 }
             }
@@ -76,7 +76,7 @@ ExcludedParts::ExcludedParts()
                     continue;
                 if (sLine.contains(rx)) {
                     QString excludedPartID = rx.cap(1);
-                    excludedParts.append(excludedPartID.toLower().trimmed());
+                    excludedParts.insert(excludedPartID.toLower().trimmed());
                 }
             }
         }
@@ -95,11 +95,35 @@ const bool &ExcludedParts::hasExcludedPart(QString part)
 }
 
 const bool &ExcludedParts::lineHasExcludedPart(const QString &line)
+{
+    // skip the 14 type, colour and matrix tokens without splitting the line
+    const int length = line.size();
+    int p = 0;
+    for (int t = 0; t < 14; t++) {
+        while (p < length && line[p] == ' ')
+            p++;
+        while (p < length && line[p] != ' ')
+            p++;
+    }
+    while (p < length && line[p] == ' ')
+        p++;
+
+    QString part = line.mid(p);
+    if (part.contains("  ")) // treat spaces
+        part = part.split(" ",QString::SkipEmptyParts).join(" ");
+
+    return hasExcludedPart(part);
+}
+
+// tokens of a type 1 line as returned by split(), matched like the line overload
+const bool &ExcludedParts::lineHasExcludedPart(const QStringList &tokens)
 {
     QString part;
-    QStringList tt = line.split(" ",QString::SkipEmptyParts);
-    for (int t = 14; t < tt.size(); t++) // treat spaces
-        part += (tt[t]+" ");
+    if (tokens.size() > 14) {
+        part = tokens.mid(14).join(" ");
+        if (part.contains("  ")) // treat spaces
+            part = part.split(" ",QString::SkipEmptyParts).join(" ");
+    }
 
     return hasExcludedPart(part);
 }
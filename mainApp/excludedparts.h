@@ -15,6 +15,7 @@
 #ifndef EXCLUDEDPARTS_H
 #define EXCLUDEDPARTS_H
 
+#include <QSet>
 #include <QString>
 #include <QStringList>
 
@@ -23,7 +24,7 @@ class ExcludedParts
   private:
     static bool     				result;
     static QString     				empty;
-    static QList<QString>           excludedParts;
+    static QSet<QString>            excludedParts;
   public:
     ExcludedParts();
     static void loadExcludedParts(QByteArray &Buffer);
@@ -31,6 +32,7 @@ class ExcludedParts
     static bool overwriteFile(const QString &file);
     static const bool &hasExcludedPart(QString part);
     static const bool &lineHasExcludedPart(const QString &line);
+    static const bool &lineHasExcludedPart(const QStringList &tokens);
 };
 
 #endif // EXCLUDEDPARTS_H
@@ -44,6 +44,7 @@
 #include "pageattributetextitem.h"
 #include "pageattributepixmapitem.h"
 #include "csiitem.h"
+#include "imagecache.h"
 #include "calloutbackgrounditem.h"
 #include "textitem.h"
 #include "rotateiconitem.h"
@@ -596,7 +597,7 @@ int Gui::addGraphicsPageItems(
               break;
             case InsertData::InsertBom:
               {
-                Where where(insert.where.modelName, insert.where.lineNumber);
+                Where where = insert.where;
                 Where current(ldrawFile.topLevelFile(),0);
                 QList<PliPartGroupMeta> bomPartGroups;
                 QStringList bomParts;
@@ -1053,7 +1054,7 @@ int Gui::addGraphicsPageItems(
  */
 int Gui::addStepImageGraphics(Step *step) {
   int retVal = 0;
-  step->csiPixmap.load(step->pngName);
+  ImageCache::load(step->pngName, step->csiPixmap);
   step->csiPlacement.size[0] = step->csiPixmap.width();
   step->csiPlacement.size[1] = step->csiPixmap.height();
   step->viewerOptions.ImageWidth = step->csiPixmap.width();
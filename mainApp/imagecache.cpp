@@ -0,0 +1,289 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Trevor SANDY. All rights reserved.
+**
+** This file may be used under the terms of the
+** GNU General Public License (GPL) version 3.0
+** which accompanies this distribution, and is
+** available at http://www.gnu.org/licenses/gpl.html
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include "imagecache.h"
+
+#include <QCache>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <cstring>
+
+#include "lpub_preferences.h"
+#include "tracer.h"
+
+namespace {
+
+struct CachedImage
+{
+  QImage    image;
+  QDateTime lastModified;
+  qint64    fileSize;
+};
+
+// Cost is counted in KB so a large budget still fits QCache's int cost
+QCache<QString, CachedImage> imageCache;
+QMutex                       imageCacheMutex;
+
+int imageCost(const QSize &size)
+{
+  return qMax(1, int((qint64(size.width()) * size.height() * 4) / 1024));
+}
+
+void updateBudget()
+{
+  const int maxCost = qMax(0, Preferences::imageCacheSize) * 1024;
+  if (imageCache.maxCost() != maxCost)
+    imageCache.setMaxCost(maxCost);
+}
+
+/*
+ * Read width and height from the IHDR chunk, which the PNG specification
+ * requires to follow the 8 byte signature directly.
+ */
+QSize pngHeaderSize(const QString &fileName)
+{
+  static const uchar signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+  QFile file(fileName);
+  if (!file.open(QIODevice::ReadOnly))
+    return QSize();
+
+  uchar header[24];
+  if (file.read(reinterpret_cast<char *>(header), sizeof(header)) != qint64(sizeof(header)))
+    return QSize();
+
+  if (memcmp(header, signature, sizeof(signature)) != 0 ||
+      memcmp(header + 12, "IHDR", 4) != 0)
+    return QSize();
+
+  const int width  = int(quint32(header[16]) << 24 | quint32(header[17]) << 16 |
+                         quint32(header[18]) << 8  | quint32(header[19]));
+  const int height = int(quint32(header[20]) << 24 | quint32(header[21]) << 16 |
+                         quint32(header[22]) << 8  | quint32(header[23]));
+
+  return width > 0 && height > 0 ? QSize(width, height) : QSize();
+}
+
+// PDF export state, only used from the thread running the export
+struct PdfExport
+{
+  bool   active        = false;
+  float  resolution    = 0.0f;
+  int    maxResolution = 0;
+  int    images        = 0;
+  int    shared        = 0;
+  QCache<QByteArray, QPixmap> pixmaps;
+};
+
+PdfExport pdfExport;
+
+/*
+ * Key a pixmap by a digest of its pixels and the size it is embedded at.
+ * Only the used bytes of each scan line are hashed since line padding is
+ * not guaranteed to be initialised.
+ */
+QByteArray pdfPixmapKey(const QImage &image, const QSize &size, qreal devicePixelRatio)
+{
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  const int lineBytes = (image.width() * image.depth() + 7) / 8;
+  for (int y = 0; y < image.height(); y++)
+    hash.addData(reinterpret_cast<const char *>(image.constScanLine(y)), lineBytes);
+
+  const QVector<QRgb> colorTable = image.colorTable();
+  if (!colorTable.isEmpty())
+    hash.addData(reinterpret_cast<const char *>(colorTable.constData()), colorTable.size() * int(sizeof(QRgb)));
+
+  return hash.result() + QString("_%1_%2x%3_%4x%5_%6")
+                         .arg(int(image.format()))
+                         .arg(image.width()).arg(image.height())
+                         .arg(size.width()).arg(size.height())
+                         .arg(devicePixelRatio).toLatin1();
+}
+
+} // namespace
+
+QImage ImageCache::image(const QString &fileName)
+{
+  LPUB_TRACE_SPAN("ImageCache::image");
+
+  // Qt resources never change on disk
+  const bool resource = fileName.startsWith(':');
+  QFileInfo fileInfo(fileName);
+  if (!resource && !fileInfo.exists())
+    return QImage();
+
+  const QString key = resource ? fileName : fileInfo.absoluteFilePath();
+  const QDateTime lastModified = resource ? QDateTime() : fileInfo.lastModified();
+  const qint64 fileSize = resource ? 0 : fileInfo.size();
+
+  {
+    QMutexLocker locker(&imageCacheMutex);
+    if (CachedImage *cached = imageCache.object(key)) {
+      if (cached->lastModified == lastModified && cached->fileSize == fileSize)
+        return cached->image;
+      imageCache.remove(key);
+    }
+  }
+
+  QImage image(fileName);
+  if (image.isNull())
+    return image;
+
+  QMutexLocker locker(&imageCacheMutex);
+  updateBudget();
+
+  // Keep one oversize image, such as a cover page logo, from flushing
+  // every step and part image out of the cache
+  const int cost = imageCost(image.size());
+  if (cost <= imageCache.maxCost() / 4)
+    imageCache.insert(key, new CachedImage{ image, lastModified, fileSize }, cost);
+
+  return image;
+}
+
+bool ImageCache::load(const QString &fileName, QPixmap &pixmap)
+{
+  const QImage image = ImageCache::image(fileName);
+  if (image.isNull())
+    return false;
+
+  pixmap = QPixmap::fromImage(image);
+  return !pixmap.isNull();
+}
+
+QSize ImageCache::size(const QString &fileName)
+{
+  QFileInfo fileInfo(fileName);
+  if (!fileName.startsWith(':')) {
+    if (!fileInfo.exists())
+      return QSize();
+
+    QMutexLocker locker(&imageCacheMutex);
+    if (CachedImage *cached = imageCache.object(fileInfo.absoluteFilePath()))
+      if (cached->lastModified == fileInfo.lastModified() && cached->fileSize == fileInfo.size())
+        return cached->image.size();
+  }
+
+  QSize size = pngHeaderSize(fileName);
+  if (!size.isValid())
+    size = QImageReader(fileName).size();
+
+  return size;
+}
+
+void ImageCache::remove(const QString &fileName)
+{
+  QMutexLocker locker(&imageCacheMutex);
+  imageCache.remove(fileName.startsWith(':') ? fileName : QFileInfo(fileName).absoluteFilePath());
+}
+
+void ImageCache::clear()
+{
+  QMutexLocker locker(&imageCacheMutex);
+  imageCache.clear();
+}
+
+void ImageCache::beginPdfExport(float resolutionDpi, int maxResolutionDpi)
+{
+  pdfExport.pixmaps.clear();
+  // shared pixmaps live until the export ends, keep at least a small budget
+  // when the decoded image cache is disabled
+  pdfExport.pixmaps.setMaxCost(qMax(64, Preferences::imageCacheSize) * 1024);
+  pdfExport.active        = true;
+  pdfExport.resolution    = resolutionDpi;
+  pdfExport.maxResolution = qMax(0, maxResolutionDpi);
+  pdfExport.images        = 0;
+  pdfExport.shared        = 0;
+}
+
+/*
+ * Return the shared pixmap for the pixels of pixmap. scale is the item to
+ * page scale it is drawn at; together with the export resolution it gives
+ * the pixmap's resolution on the page, which is capped at the maximum
+ * resolution. Outside an export the pixmap is returned unchanged.
+ */
+QPixmap ImageCache::pdfPixmap(const QPixmap &pixmap, qreal scale)
+{
+  if (!pdfExport.active || pixmap.isNull())
+    return pixmap;
+
+  LPUB_TRACE_SPAN("ImageCache::pdfPixmap");
+
+  pdfExport.images++;
+
+  const qreal devicePixelRatio = pixmap.devicePixelRatio();
+  QSize size = pixmap.size();
+  if (pdfExport.maxResolution > 0 && scale > 0.0) {
+    const qreal pageResolution = qreal(pdfExport.resolution) * devicePixelRatio / scale;
+    if (pageResolution > pdfExport.maxResolution) {
+      const qreal factor = pdfExport.maxResolution / pageResolution;
+      size = QSize(qMax(1, qRound(size.width() * factor)), qMax(1, qRound(size.height() * factor)));
+    }
+  }
+
+  const QImage image = pixmap.toImage();
+  const QByteArray key = pdfPixmapKey(image, size, devicePixelRatio);
+  if (QPixmap *shared = pdfExport.pixmaps.object(key)) {
+    pdfExport.shared++;
+    return *shared;
+  }
+
+  QPixmap result = pixmap;
+  if (size != pixmap.size()) {
+    // keep the drawn size by raising the device pixel ratio
+    result = QPixmap::fromImage(image.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+    result.setDevicePixelRatio(devicePixelRatio * pixmap.width() / size.width());
+  }
+
+  pdfExport.pixmaps.insert(key, new QPixmap(result), imageCost(result.size()));
+  return result;
+}
+
+/*
+ * Return a whole page image capped at the maximum resolution for the
+ * width it is drawn at, in inches. Page images are unique to their page,
+ * so they are neither hashed nor kept for sharing.
+ */
+QPixmap ImageCache::pdfPageImage(const QPixmap &pixmap, qreal widthInches)
+{
+  if (!pdfExport.active || pixmap.isNull() || pdfExport.maxResolution <= 0 || widthInches <= 0.0)
+    return pixmap;
+
+  const qreal pageResolution = pixmap.width() / widthInches;
+  if (pageResolution <= pdfExport.maxResolution)
+    return pixmap;
+
+  LPUB_TRACE_SPAN("ImageCache::pdfPageImage");
+
+  const qreal factor = pdfExport.maxResolution / pageResolution;
+  return pixmap.scaled(qMax(1, qRound(pixmap.width() * factor)), qMax(1, qRound(pixmap.height() * factor)),
+                       Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+}
+
+void ImageCache::endPdfExport(int *images, int *shared)
+{
+  if (images)
+    *images = pdfExport.images;
+  if (shared)
+    *shared = pdfExport.shared;
+
+  pdfExport.active = false;
+  pdfExport.pixmaps.clear();
+}
@@ -0,0 +1,62 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Trevor SANDY. All rights reserved.
+**
+** This file may be used under the terms of the
+** GNU General Public License (GPL) version 3.0
+** which accompanies this distribution, and is
+** available at http://www.gnu.org/licenses/gpl.html
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+/****************************************************************************
+ *
+ * Process wide cache of decoded CSI, PLI and submodel images.
+ *
+ * Entries are keyed by absolute file path and are only served while the
+ * file's modification time and size match what was decoded, so an image
+ * that is re-rendered is picked up on the next load. The least recently
+ * used entries are evicted once the decoded bytes exceed the budget set by
+ * Preferences::imageCacheSize (in MB, 0 disables the cache).
+ *
+ * size() reads image dimensions from the PNG header without decoding
+ * pixels, for callers that only need to lay out an image.
+ *
+ * During a PDF export pdfPixmap() maps pixmaps with identical pixels to
+ * one shared QPixmap. The PDF writer keys embedded images by
+ * QPixmap::cacheKey(), so a part image, icon, logo or background that
+ * recurs on many pages is written once and referenced from each page.
+ * Pixmaps drawn above the export's maximum resolution are downscaled
+ * before they are shared. Whole page images only get the resolution cap
+ * from pdfPageImage(); they are not shared.
+ *
+ ***************************************************************************/
+
+#ifndef IMAGECACHE_H
+#define IMAGECACHE_H
+
+#include <QString>
+#include <QImage>
+#include <QPixmap>
+#include <QSize>
+
+class ImageCache
+{
+public:
+  static bool load(const QString &fileName, QPixmap &pixmap);
+  static QImage image(const QString &fileName);
+  static QSize size(const QString &fileName);
+
+  static void remove(const QString &fileName);
+  static void clear();
+
+  static void beginPdfExport(float resolutionDpi, int maxResolutionDpi);
+  static QPixmap pdfPixmap(const QPixmap &pixmap, qreal scale = 1.0);
+  static QPixmap pdfPageImage(const QPixmap &pixmap, qreal widthInches);
+  static void endPdfExport(int *images = nullptr, int *shared = nullptr);
+};
+
+#endif // IMAGECACHE_H
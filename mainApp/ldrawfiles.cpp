@@ -39,7 +39,11 @@
 #include <QFile>
 #include <QRegExp>
 #include <QHash>
+#include <QDataStream>
+#include <QCryptographicHash>
+#include <QElapsedTimer>
 #include <functional>
+#include <cstring>
 
 #include "paths.h"
 
@@ -57,10 +61,12 @@ QString LDrawFile::_author         = "";
 QString LDrawFile::_description    = "";
 QString LDrawFile::_category       = "";
 int     LDrawFile::_emptyInt;
+int     LDrawFile::_modelStamps    = 0;
 int     LDrawFile::_partCount      = 0;
 bool    LDrawFile::_currFileIsUTF8 = false;
 bool    LDrawFile::_showLoadMessages = false;
 bool    LDrawFile::_loadAborted    = false;
+bool    LDrawFile::_loadMissing    = false;
 
 LDrawSubFile::LDrawSubFile(
   const QStringList &contents,
@@ -104,9 +110,12 @@ ViewerStep::ViewerStep(const QStringList &rotatedContents,
 void LDrawFile::empty()
 {
   _subFiles.clear();
+  _subFileIds.clear();
+  _modelStamp = ++_modelStamps;
   _subFileOrder.clear();
   _viewerSteps.clear();
   _loadedParts.clear();
+  _loadMissing = false;
   _mpd = false;
   _partCount = 0;
 }
@@ -121,16 +130,54 @@ void LDrawFile::insert(const QString &mcFileName,
                       const QString  &subFilePath)
 {
   QString    fileName = mcFileName.toLower();
-  QMap<QString, LDrawSubFile>::iterator i = _subFiles.find(fileName);
+  LDrawSubFile subFile(contents,datetime,unofficialPart,generated,subFilePath);
+  subFile._fileName = fileName;
 
-  if (i != _subFiles.end()) {
-    _subFiles.erase(i);
+  // a reloaded subfile keeps its id so ids held by Where stay valid
+  QHash<QString, int>::const_iterator i = _subFileIds.constFind(fileName);
+  if (i != _subFileIds.constEnd()) {
+    _subFiles[i.value()] = subFile;
+  } else {
+    _subFileIds.insert(fileName,_subFiles.size());
+    _subFiles.append(subFile);
   }
-  LDrawSubFile subFile(contents,datetime,unofficialPart,generated,subFilePath);
-  _subFiles.insert(fileName,subFile);
   _subFileOrder << fileName;
 }
 
+/* return the subfile for an already lower case file name */
+
+LDrawSubFile *LDrawFile::subFile(const QString &fileName)
+{
+  int id = _subFileIds.value(fileName,-1);
+  return id < 0 ? nullptr : &_subFiles[id];
+}
+
+/*
+ * Where remembers the id of the last subfile it resolved to and the
+ * stamp of the ids at that time. Ids are only reassigned when the
+ * file is emptied or restored from a snapshot, which renews the stamp,
+ * so a hint with the current stamp is used without comparing names.
+ * A Where is retargeted by constructing or assigning a whole Where,
+ * never by setting modelName alone, so the hint follows the name.
+ */
+
+LDrawSubFile *LDrawFile::subFile(const Where &here)
+{
+  int id = here.modelIndex;
+  if (here.modelStamp == _modelStamp && id >= 0 && id < _subFiles.size())
+    return &_subFiles[id];
+
+  id = _subFileIds.value(here.modelName.toLower(),-1);
+  here.modelIndex = id;
+  here.modelStamp = _modelStamp;
+  return id < 0 ? nullptr : &_subFiles[id];
+}
+
+int LDrawFile::modelIndex(const QString &fileName)
+{
+  return _subFileIds.value(fileName.toLower(),-1);
+}
+
 /* return the number of lines in the file */
 
 int LDrawFile::size(const QString &mcFileName)
@@ -138,16 +185,22 @@ int LDrawFile::size(const QString &mcFileName)
   QString fileName = mcFileName.toLower();
   int mySize;
       
-  QMap<QString, LDrawSubFile>::iterator i = _subFiles.find(fileName);
+  LDrawSubFile *i = subFile(fileName);
 
-  if (i == _subFiles.end()) {
+  if (!i) {
     mySize = 0;
   } else {
-    mySize = i.value()._contents.size();
+    mySize = i->_contents.size();
   }
   return mySize;
 }
 
+int LDrawFile::size(const Where &here)
+{
+  LDrawSubFile *i = subFile(here);
+  return i ? i->_contents.size() : 0;
+}
+
 bool LDrawFile::isMpd()
 {
   return _mpd;
@@ -156,9 +209,9 @@ bool LDrawFile::isMpd()
 int LDrawFile::isUnofficialPart(const QString &name)
 {
   QString fileName = name.toLower();
-  QMap<QString, LDrawSubFile>::iterator i = _subFiles.find(fileName);
-  if (i != _subFiles.end()) {
-    int _unofficialPart = i.value()._unofficialPart;
+  LDrawSubFile *i = subFile(fileName);
+  if (i) {
+    int _unofficialPart = i->_unofficialPart;
     return _unofficialPart;
   }
   return 0;
@@ -177,12 +230,7 @@ QString LDrawFile::topLevelFile()
 
 int LDrawFile::fileOrderIndex(const QString &file)
 {
-  for (int i = 0; i < _subFileOrder.size(); i++) {
-    if (_subFileOrder[i].toLower() == file.toLower()) {
-      return i;
-    }
-  }
-  return -1;
+  return _subFileOrder.indexOf(file.toLower());
 }
 
 /* return the number of steps within the file */
@@ -190,9 +238,9 @@ int LDrawFile::fileOrderIndex(const QString &file)
 int LDrawFile::numSteps(const QString &mcFileName)
 {
   QString fileName = mcFileName.toLower();
-  QMap<QString, LDrawSubFile>::iterator i = _subFiles.find(fileName);
-  if (i != _subFiles.end()) {
-    return i.value()._numSteps;
+  LDrawSubFile *i = subFile(fileName);
+  if (i) {
+    return i->_numSteps;
   }
   return 0;
 }
@@ -202,9 +250,9 @@ int LDrawFile::numSteps(const QString &mcFileName)
 int LDrawFile::getModelStartPageNumber(const QString &mcFileName)
 {
   QString fileName = mcFileName.toLower();
-  QMap<QString, LDrawSubFile>::iterator i = _subFiles.find(fileName);
-  if (i != _subFiles.end()) {
-    return i.value()._startPageNumber;
+  LDrawSubFile *i = subFile(fileName);
+  if (i) {
+    return i->_startPageNumber;
   }
   return 0;
 }
@@ -212,40 +260,34 @@ int LDrawFile::getModelStartPageNumber(const QString &mcFileName)
 QDateTime LDrawFile::lastModified(const QString &mcFileName)
 {
   QString fileName = mcFileName.toLower();
-  QMap<QString, LDrawSubFile>::iterator i = _subFiles.find(fileName);
-  if (i != _subFiles.end()) {
-    return i.value()._datetime;
+  LDrawSubFile *i = subFile(fileName);
+  if (i) {
+    return i->_datetime;
   }
   return QDateTime();
 }
 
 bool LDrawFile::contains(const QString &file)
 {
-  for (int i = 0; i < _subFileOrder.size(); i++) {
-    if (_subFileOrder[i].toLower() == file.toLower()) {
-      return true;
-    }
-  }
-  return false;
+  return _subFileIds.contains(file.toLower());
 }
 
 bool LDrawFile::isSubmodel(const QString &file)
 {
   QString fileName = file.toLower();
-  QMap<QString, LDrawSubFile>::iterator i = _subFiles.find(fileName);
-  if (i != _subFiles.end()) {
-      return ! i.value()._unofficialPart && ! i.value()._generated;
-      //return ! i.value()._generated; // added on revision 368 - to generate csiSubModels for 3D render
+  LDrawSubFile *i = subFile(fileName);
+  if (i) {
+      return ! i->_unofficialPart && ! i->_generated;
+      //return ! i->_generated; // added on revision 368 - to generate csiSubModels for 3D render
   }
   return false;
 }
 
 bool LDrawFile::modified()
 {
-  QString key;
   bool    modified = false;
-  foreach(key,_subFiles.keys()) {
-    modified |= _subFiles[key]._modified;
+  for (int i = 0; i < _subFiles.size(); i++) {
+    modified |= _subFiles[i]._modified;
   }
   return modified;
 }
@@ -253,9 +295,9 @@ bool LDrawFile::modified()
 bool LDrawFile::modified(const QString &mcFileName)
 {
   QString fileName = mcFileName.toLower();
-  QMap<QString, LDrawSubFile>::iterator i = _subFiles.find(fileName);
-  if (i != _subFiles.end()) {
-    return i.value()._modified;
+  LDrawSubFile *i = subFile(fileName);
+  if (i) {
+    return i->_modified;
   } else {
     return false;
   }
@@ -264,10 +306,10 @@ bool LDrawFile::modified(const QString &mcFileName)
 QStringList LDrawFile::contents(const QString &mcFileName)
 {
   QString fileName = mcFileName.toLower();
-  QMap<QString, LDrawSubFile>::iterator i = _subFiles.find(fileName);
+  LDrawSubFile *i = subFile(fileName);
 
-  if (i != _subFiles.end()) {
-    return i.value()._contents;
+  if (i) {
+    return i->_contents;
   } else {
     return _emptyList;
   }
@@ -277,13 +319,13 @@ void LDrawFile::setContents(const QString     &mcFileName,
                  const QStringList &contents)
 {
   QString fileName = mcFileName.toLower();
-  QMap<QString, LDrawSubFile>::iterator i = _subFiles.find(fileName);
+  LDrawSubFile *i = subFile(fileName);
 
-  if (i != _subFiles.end()) {
-    i.value()._modified = true;
-    //i.value()._datetime = QDateTime::currentDateTime();
-    i.value()._contents = contents;
-    i.value()._changedSinceLastWrite = true;
+  if (i) {
+    i->_modified = true;
+    //i->_datetime = QDateTime::currentDateTime();
+    i->_contents = contents;
+    i->_changedSinceLastWrite = true;
   }
 }
 
@@ -291,10 +333,10 @@ void LDrawFile::setSubFilePath(const QString     &mcFileName,
                  const QString &subFilePath)
 {
   QString fileName = mcFileName.toLower();
-  QMap<QString, LDrawSubFile>::iterator i = _subFiles.find(fileName);
+  LDrawSubFile *i = subFile(fileName);
 
-  if (i != _subFiles.end()) {
-    i.value()._subFilePath = subFilePath;
+  if (i) {
+    i->_subFilePath = subFilePath;
   }
 }
 
@@ -302,10 +344,10 @@ QStringList LDrawFile::getSubFilePaths()
 {
   QStringList subFiles;
   for (int i = 0; i < _subFileOrder.size(); i++) {
-    QMap<QString, LDrawSubFile>::iterator f = _subFiles.find(_subFileOrder[i]);
-    if (f != _subFiles.end()) {
-        if (!f.value()._subFilePath.isEmpty()) {
-            subFiles << f.value()._subFilePath;
+    LDrawSubFile *f = subFile(_subFileOrder[i]);
+    if (f) {
+        if (!f->_subFilePath.isEmpty()) {
+            subFiles << f->_subFilePath;
         }
     }
   }
@@ -316,13 +358,13 @@ void LDrawFile::setModelStartPageNumber(const QString     &mcFileName,
                  const int &startPageNumber)
 {
   QString fileName = mcFileName.toLower();
-  QMap<QString, LDrawSubFile>::iterator i = _subFiles.find(fileName);
+  LDrawSubFile *i = subFile(fileName);
 
-  if (i != _subFiles.end()) {
-    i.value()._modified = true;
-    //i.value()._datetime = QDateTime::currentDateTime();
-    i.value()._startPageNumber = startPageNumber;
-    //i.value()._changedSinceLastWrite = true; // remarked on build 491 28/12/2015
+  if (i) {
+    i->_modified = true;
+    //i->_datetime = QDateTime::currentDateTime();
+    i->_startPageNumber = startPageNumber;
+    //i->_changedSinceLastWrite = true; // remarked on build 491 28/12/2015
   }
 }
 
@@ -331,9 +373,9 @@ void LDrawFile::setModelStartPageNumber(const QString     &mcFileName,
 int LDrawFile::getPrevStepPosition(const QString &mcFileName)
 {
   QString fileName = mcFileName.toLower();
-  QMap<QString, LDrawSubFile>::iterator i = _subFiles.find(fileName);
-  if (i != _subFiles.end()) {
-    return i.value()._prevStepPosition;
+  LDrawSubFile *i = subFile(fileName);
+  if (i) {
+    return i->_prevStepPosition;
   }
   return 0;
 }
@@ -342,13 +384,13 @@ void LDrawFile::setPrevStepPosition(const QString     &mcFileName,
                  const int &prevStepPosition)
 {
   QString fileName = mcFileName.toLower();
-  QMap<QString, LDrawSubFile>::iterator i = _subFiles.find(fileName);
+  LDrawSubFile *i = subFile(fileName);
 
-  if (i != _subFiles.end()) {
-    i.value()._modified = true;
-    //i.value()._datetime = QDateTime::currentDateTime();
-    i.value()._prevStepPosition = prevStepPosition;
-    //i.value()._changedSinceLastWrite = true;  // remarked on build 491 28/12/2015
+  if (i) {
+    i->_modified = true;
+    //i->_datetime = QDateTime::currentDateTime();
+    i->_prevStepPosition = prevStepPosition;
+    //i->_changedSinceLastWrite = true;  // remarked on build 491 28/12/2015
   }
 }
 
@@ -356,9 +398,8 @@ void LDrawFile::setPrevStepPosition(const QString     &mcFileName,
 
 void LDrawFile::clearPrevStepPositions()
 {
-  QString key;
-  foreach(key,_subFiles.keys()) {
-    _subFiles[key]._prevStepPosition = 0;
+  for (int i = 0; i < _subFiles.size(); i++) {
+    _subFiles[i]._prevStepPosition = 0;
   }
 }
 
@@ -368,9 +409,9 @@ bool LDrawFile::older(const QStringList &parsedStack,
 {
   QString fileName;
   foreach (fileName, parsedStack) {
-    QMap<QString, LDrawSubFile>::iterator i = _subFiles.find(fileName);
-    if (i != _subFiles.end()) {
-      QDateTime fileDatetime = i.value()._datetime;
+    LDrawSubFile *i = subFile(fileName);
+    if (i) {
+      QDateTime fileDatetime = i->_datetime;
       if (fileDatetime > lastModified) {
         return false;
       }
@@ -386,11 +427,22 @@ QStringList LDrawFile::subFileOrder() {
 QString LDrawFile::readLine(const QString &mcFileName, int lineNumber)
 {
   QString fileName = mcFileName.toLower();
-  QMap<QString, LDrawSubFile>::iterator i = _subFiles.find(fileName);
+  LDrawSubFile *i = subFile(fileName);
 
-  if (i != _subFiles.end()) {
-      if (lineNumber < i.value()._contents.size())
-          return i.value()._contents[lineNumber];
+  if (i) {
+      if (lineNumber < i->_contents.size())
+          return i->_contents[lineNumber];
+  }
+  return QString();
+}
+
+QString LDrawFile::readLine(const Where &here)
+{
+  LDrawSubFile *i = subFile(here);
+
+  if (i) {
+      if (here.lineNumber >= 0 && here.lineNumber < i->_contents.size())
+          return i->_contents[here.lineNumber];
   }
   return QString();
 }
@@ -398,42 +450,62 @@ QString LDrawFile::readLine(const QString &mcFileName, int lineNumber)
 void LDrawFile::insertLine(const QString &mcFileName, int lineNumber, const QString &line)
 {  
   QString fileName = mcFileName.toLower();
-  QMap<QString, LDrawSubFile>::iterator i = _subFiles.find(fileName);
+  LDrawSubFile *i = subFile(fileName);
 
-  if (i != _subFiles.end()) {
-    i.value()._contents.insert(lineNumber,line);
-    i.value()._modified = true;
- //   i.value()._datetime = QDateTime::currentDateTime();
-    i.value()._changedSinceLastWrite = true;
+  if (i) {
+    i->_contents.insert(lineNumber,line);
+    i->_modified = true;
+ //   i->_datetime = QDateTime::currentDateTime();
+    i->_changedSinceLastWrite = true;
   }
 }
   
 void LDrawFile::replaceLine(const QString &mcFileName, int lineNumber, const QString &line)
 {
   QString fileName = mcFileName.toLower();
-  QMap<QString, LDrawSubFile>::iterator i = _subFiles.find(fileName);
+  LDrawSubFile *i = subFile(fileName);
 
-  if (i != _subFiles.end()) {
-    i.value()._contents[lineNumber] = line;
-    i.value()._modified = true;
-//    i.value()._datetime = QDateTime::currentDateTime();
-    i.value()._changedSinceLastWrite = true;
+  if (i) {
+    i->_contents[lineNumber] = line;
+    i->_modified = true;
+//    i->_datetime = QDateTime::currentDateTime();
+    i->_changedSinceLastWrite = true;
   }
 }
 
 void LDrawFile::deleteLine(const QString &mcFileName, int lineNumber)
 {
   QString fileName = mcFileName.toLower();
-  QMap<QString, LDrawSubFile>::iterator i = _subFiles.find(fileName);
+  LDrawSubFile *i = subFile(fileName);
 
-  if (i != _subFiles.end()) {
-    i.value()._contents.removeAt(lineNumber);
-    i.value()._modified = true;
-//    i.value()._datetime = QDateTime::currentDateTime();
-    i.value()._changedSinceLastWrite = true;
+  if (i) {
+    i->_contents.removeAt(lineNumber);
+    i->_modified = true;
+//    i->_datetime = QDateTime::currentDateTime();
+    i->_changedSinceLastWrite = true;
   }
 }
 
+/*
+ * Map a character position in the newline joined contents
+ * to a line number and offset within that line.
+ */
+static bool contentsPosition(const QStringList &contents, int position, int &line, int &offset)
+{
+  offset = position;
+  for (line = 0; line < contents.size(); line++) {
+    if (offset <= contents[line].size())
+      return offset >= 0;
+    offset -= contents[line].size() + 1;
+  }
+  return false;
+}
+
+/*
+ * Editor changes only touch the lines spanned by the change so
+ * splice those lines instead of joining and splitting the whole
+ * submodel on every keystroke.
+ */
 void LDrawFile::changeContents(const QString &mcFileName, 
                           int      position, 
                           int      charsRemoved, 
@@ -441,21 +513,59 @@ void LDrawFile::changeContents(const QString &mcFileName,
 {
   QString fileName = mcFileName.toLower();
   if (charsRemoved || charsAdded.size()) {
-    QString all = contents(fileName).join("\n");
-    all.remove(position,charsRemoved);
-    all.insert(position,charsAdded);
-    setContents(fileName,all.split("\n"));
+    LDrawSubFile *i = subFile(fileName);
+    if (!i)
+      return;
+
+    QStringList &contents = i->_contents;
+    int startLine, startOffset, endLine, endOffset;
+    if (contentsPosition(contents, position, startLine, startOffset) &&
+        contentsPosition(contents, position + charsRemoved, endLine, endOffset)) {
+      QString changed = contents[startLine].left(startOffset) + charsAdded + contents[endLine].mid(endOffset);
+      QStringList changedLines = changed.split("\n");
+      contents.erase(contents.begin() + startLine, contents.begin() + endLine + 1);
+      for (int n = 0; n < changedLines.size(); n++)
+        contents.insert(startLine + n, changedLines[n]);
+      i->_modified = true;
+      i->_changedSinceLastWrite = true;
+    } else {
+      QString all = contents.join("\n");
+      all.remove(position,charsRemoved);
+      all.insert(position,charsAdded);
+      setContents(fileName,all.split("\n"));
+    }
   }
 }
 
+QString LDrawFile::readContents(const QString &mcFileName,
+                                int      position,
+                                int      count)
+{
+  QString fileName = mcFileName.toLower();
+  LDrawSubFile *i = subFile(fileName);
+  if (!i || count <= 0)
+    return QString();
+
+  const QStringList &contents = i->_contents;
+  int line, offset;
+  if ( ! contentsPosition(contents, position, line, offset))
+    return contents.join("\n").mid(position,count);
+
+  QString chars = contents[line].mid(offset,count);
+  while (chars.size() < count && ++line < contents.size()) {
+    chars += "\n";
+    chars += contents[line].left(count - chars.size());
+  }
+  return chars;
+}
+
 void LDrawFile::unrendered()
 {
-  QString key;
-  foreach(key,_subFiles.keys()) {
-    _subFiles[key]._rendered = false;
-    _subFiles[key]._mirrorRendered = false;
-    _subFiles[key]._renderedKeys.clear();
-    _subFiles[key]._mirrorRenderedKeys.clear();
+  for (int i = 0; i < _subFiles.size(); i++) {
+    _subFiles[i]._rendered = false;
+    _subFiles[i]._mirrorRendered = false;
+    _subFiles[i]._renderedKeys.clear();
+    _subFiles[i]._mirrorRenderedKeys.clear();
   }
 }
 
@@ -467,22 +577,22 @@ void LDrawFile::setRendered(
         int            howCounted)
 {
   QString fileName = mcFileName.toLower();
-  QMap<QString, LDrawSubFile>::iterator i = _subFiles.find(fileName);
-  if (i != _subFiles.end()) {
+  LDrawSubFile *i = subFile(fileName);
+  if (i) {
       QString key =
         howCounted == CountAtStep ?
           QString("%1 %2").arg(renderParentModel).arg(renderStepNumber) :
         howCounted > CountFalse && howCounted < CountAtStep ?
           renderParentModel : QString();
     if (mirrored) {
-      i.value()._mirrorRendered = true;
-      if (!key.isEmpty() && !i.value()._mirrorRenderedKeys.contains(key)) {
-        i.value()._mirrorRenderedKeys.append(key);
+      i->_mirrorRendered = true;
+      if (!key.isEmpty() && !i->_mirrorRenderedKeys.contains(key)) {
+        i->_mirrorRenderedKeys.append(key);
       }
     } else {
-      i.value()._rendered = true;
-      if (!key.isEmpty() && !i.value()._renderedKeys.contains(key)) {
-        i.value()._renderedKeys.append(key);
+      i->_rendered = true;
+      if (!key.isEmpty() && !i->_renderedKeys.contains(key)) {
+        i->_renderedKeys.append(key);
       }
     }
   }
@@ -501,8 +611,8 @@ bool LDrawFile::rendered(
   bool haveKey  = false;
 
   QString fileName = mcFileName.toLower();
-  QMap<QString, LDrawSubFile>::iterator i = _subFiles.find(fileName);
-  if (i != _subFiles.end()) {
+  LDrawSubFile *i = subFile(fileName);
+  if (i) {
     QString key =
         howCounted == CountAtStep ?
           QString("%1 %2").arg(renderParentModel).arg(renderStepNumber) :
@@ -510,12 +620,12 @@ bool LDrawFile::rendered(
           renderParentModel : QString() ;
     if (mirrored) {
       haveKey = key.isEmpty() ? howCounted == CountAtTop ? true : false :
-                  i.value()._mirrorRenderedKeys.contains(key);
-      rendered  = i.value()._mirrorRendered;
+                  i->_mirrorRenderedKeys.contains(key);
+      rendered  = i->_mirrorRendered;
     } else {
       haveKey = key.isEmpty() ? howCounted == CountAtTop ? true : false :
-                  i.value()._renderedKeys.contains(key);
-      rendered  = i.value()._rendered;
+                  i->_renderedKeys.contains(key);
+      rendered  = i->_rendered;
     }
     return rendered && haveKey;
   }
@@ -525,15 +635,15 @@ bool LDrawFile::rendered(
 int LDrawFile::instances(const QString &mcFileName, bool mirrored)
 {
   QString fileName = mcFileName.toLower();
-  QMap<QString, LDrawSubFile>::iterator i = _subFiles.find(fileName);
+  LDrawSubFile *i = subFile(fileName);
   
   int instances = 0;
 
-  if (i != _subFiles.end()) {
+  if (i) {
     if (mirrored) {
-      instances = i.value()._mirrorInstances;
+      instances = i->_mirrorInstances;
     } else {
-      instances = i.value()._instances;
+      instances = i->_instances;
     }
   }
   return instances;
@@ -568,42 +678,60 @@ int LDrawFile::loadFile(const QString &fileName)
 
     bool mpd = false;
 
-    QTextStream in(&qba);
+    QFileInfo fileInfo(fileName);
 
-    QRegExp sof("^0\\s+FILE\\s+(.*)$",Qt::CaseInsensitive);
-    QRegExp part("^\\s*1\\s+.*$",Qt::CaseInsensitive);
+    // reuse the parsed state of an unchanged model if we have it
 
-    QFileInfo fileInfo(fileName);
+    QByteArray fileHash = QCryptographicHash::hash(qba, QCryptographicHash::Md5);
 
-    while ( ! in.atEnd()) {
-        QString line = in.readLine(0);
-        if (line.contains(sof)) {
-            emit gui->messageSig(LOG_INFO_STATUS, QString("Model file %1 identified as Multi-Part LDraw System (MPD) Document").arg(fileInfo.fileName()));
-            mpd = true;
-            break;
+    if (Preferences::modelSnapshotCache && loadSnapshot(fileName, fileHash)) {
+        mpd = _mpd;
+        emit gui->messageSig(LOG_INFO_STATUS, QString("Model file %1 restored from snapshot").arg(fileInfo.fileName()));
+    } else {
+        QTextStream in(&qba);
+
+        QRegExp sof("^0\\s+FILE\\s+(.*)$",Qt::CaseInsensitive);
+        QRegExp part("^\\s*1\\s+.*$",Qt::CaseInsensitive);
+
+        while ( ! in.atEnd()) {
+            QString line = in.readLine(0);
+            if (line.contains(sof)) {
+                emit gui->messageSig(LOG_INFO_STATUS, QString("Model file %1 identified as Multi-Part LDraw System (MPD) Document").arg(fileInfo.fileName()));
+                mpd = true;
+                break;
+            }
+            if (line.contains(part)) {
+                emit gui->messageSig(LOG_INFO_STATUS, QString("Model file %1 identified as LDraw Sytem (LDR) Document").arg(fileInfo.fileName()));
+                mpd = false;
+                break;
+            }
         }
-        if (line.contains(part)) {
-            emit gui->messageSig(LOG_INFO_STATUS, QString("Model file %1 identified as LDraw Sytem (LDR) Document").arg(fileInfo.fileName()));
-            mpd = false;
-            break;
+
+        QApplication::setOverrideCursor(Qt::WaitCursor);
+
+        ldcadGroupsLoaded = false;
+
+        if (mpd) {
+          QDateTime datetime = QFileInfo(fileName).lastModified();
+          loadMPDFile(QDir::toNativeSeparators(fileName),datetime);
+        } else {
+          topLevelModel = true;
+          loadLDRFile(QDir::toNativeSeparators(fileInfo.absolutePath()),fileInfo.fileName());
         }
-    }
 
-    QApplication::setOverrideCursor(Qt::WaitCursor);
+        QApplication::restoreOverrideCursor();
 
-    ldcadGroupsLoaded = false;
+        countParts(topLevelFile());
 
-    if (mpd) {
-      QDateTime datetime = QFileInfo(fileName).lastModified();
-      loadMPDFile(QDir::toNativeSeparators(fileName),datetime);
-    } else {
-      topLevelModel = true;
-      loadLDRFile(QDir::toNativeSeparators(fileInfo.absolutePath()),fileInfo.fileName());
+        // a snapshot would keep reporting missing parts and subfiles
+        // after they are added to the library or a search directory
+        if (Preferences::modelSnapshotCache) {
+            if (_loadMissing)
+                QFile::remove(snapshotFileName(fileName));
+            else
+                saveSnapshot(fileName, fileHash);
+        }
     }
-    
-    QApplication::restoreOverrideCursor();
-
-    countParts(topLevelFile());
 
     auto getCount = [] (const LoadMsgType lmt)
     {
@@ -695,25 +823,259 @@ int LDrawFile::loadFile(const QString &fileName)
     return 0;
 }
 
+/*
+ * Model snapshots
+ *
+ * The parsed state of a model file (subfile order, contents, unofficial part
+ * flags, LDCad groups and part count) is written to the user data cache after
+ * a full load. The snapshot is keyed on the model path and the library
+ * settings that influence subfile resolution, and each input file is checked
+ * against its recorded content hash before the snapshot is reused. Loads
+ * that reported a missing part or subfile are not snapshotted. Only the
+ * most recently written snapshots are kept, and resetting the caches
+ * removes them all.
+ */
+
+#define LDRAW_SNAPSHOT_MAGIC   0x4c505353 // LPSS
+#define LDRAW_SNAPSHOT_VERSION 1
+#define LDRAW_SNAPSHOT_LIMIT   50
+
+QString LDrawFile::snapshotFileName(const QString &fileName)
+{
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    hash.addData(QFileInfo(fileName).absoluteFilePath().toUtf8());
+    hash.addData(Preferences::ldrawLibPath.toUtf8());
+    hash.addData(Preferences::lpub3dLibFile.toUtf8());
+    hash.addData(QFileInfo(Preferences::lpub3dLibFile).lastModified().toString(Qt::ISODate).toUtf8());
+    QFileInfo unofficialArchive(QFileInfo(Preferences::lpub3dLibFile).dir(), Preferences::validLDrawCustomArchive);
+    hash.addData(unofficialArchive.absoluteFilePath().toUtf8());
+    hash.addData(unofficialArchive.lastModified().toString(Qt::ISODate).toUtf8());
+    hash.addData(Preferences::ldSearchDirs.join("|").toUtf8());
+    hash.addData(Preferences::extendedSubfileSearch ? "1" : "0");
+
+    return QDir::toNativeSeparators(QString("%1/%2/%3.lps")
+                                    .arg(Preferences::lpubDataPath)
+                                    .arg(Paths::snapshotsDir)
+                                    .arg(QString(hash.result().toHex())));
+}
+
+bool LDrawFile::loadSnapshot(const QString &fileName, const QByteArray &fileHash)
+{
+    QFile file(snapshotFileName(fileName));
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_4_8);
+
+    quint32 magic, version;
+    in >> magic >> version;
+    if (magic != LDRAW_SNAPSHOT_MAGIC || version != LDRAW_SNAPSHOT_VERSION)
+        return false;
+
+    QByteArray snapshotHash;
+    QStringList dependencies;
+    QList<QByteArray> dependencyHashes;
+    in >> snapshotHash >> dependencies >> dependencyHashes;
+    if (in.status() != QDataStream::Ok || snapshotHash != fileHash ||
+        dependencies.size() != dependencyHashes.size())
+        return false;
+
+    // external subfiles must be unchanged as well
+    for (int i = 0; i < dependencies.size(); i++) {
+        QFile dependency(dependencies.at(i));
+        if (!dependency.open(QIODevice::ReadOnly))
+            return false;
+        if (QCryptographicHash::hash(dependency.readAll(), QCryptographicHash::Md5) != dependencyHashes.at(i))
+            return false;
+    }
+
+    bool mpd;
+    QString topFile, name, author, description, category;
+    qint32 partCount, subFileCount;
+    QStringList loadedParts, subFileOrder;
+    QMultiHash<QString, int> ldcadGroups;
+    QVector<LDrawSubFile> subFiles;
+    QHash<QString, int> subFileIds;
+
+    in >> mpd >> topFile >> name >> author >> description >> category
+       >> partCount >> loadedParts >> ldcadGroups >> subFileOrder >> subFileCount;
+
+    for (int i = 0; i < subFileCount && in.status() == QDataStream::Ok; i++) {
+        QString key, subFilePath;
+        QStringList contents;
+        QDateTime datetime;
+        qint32 unofficialPart, numSteps, instances, mirrorInstances;
+        in >> key >> contents >> subFilePath >> datetime
+           >> unofficialPart >> numSteps >> instances >> mirrorInstances;
+
+        LDrawSubFile subFile(contents,datetime,unofficialPart,false,subFilePath);
+        subFile._numSteps        = numSteps;
+        subFile._instances       = instances;
+        subFile._mirrorInstances = mirrorInstances;
+        subFile._fileName        = key;
+        subFileIds.insert(key,subFiles.size());
+        subFiles.append(subFile);
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        emit gui->messageSig(LOG_NOTICE, QString("Model snapshot %1 is invalid and will be rebuilt.").arg(file.fileName()));
+        return false;
+    }
+
+    _subFiles     = subFiles;
+    _subFileIds   = subFileIds;
+    _modelStamp   = ++_modelStamps;
+    _subFileOrder = subFileOrder;
+    _ldcadGroups  = ldcadGroups;
+    _loadedParts  = loadedParts;
+    _partCount    = partCount;
+    _mpd          = mpd;
+    _file         = topFile;
+    _name         = name;
+    _author       = author;
+    _description  = description;
+    _category     = category;
+
+    if (_mpd) {
+        Preferences::defaultAuthor      = _author;
+        Preferences::publishDescription = _description;
+    }
+
+    return true;
+}
+
+void LDrawFile::saveSnapshot(const QString &fileName, const QByteArray &fileHash)
+{
+    if (_subFileOrder.isEmpty())
+        return;
+
+    QString snapshotFile = snapshotFileName(fileName);
+    QDir().mkpath(QFileInfo(snapshotFile).absolutePath());
+
+    QString topLevelPath = QFileInfo(fileName).absoluteFilePath();
+    QStringList dependencies;
+    QList<QByteArray> dependencyHashes;
+
+    for (const QString &subFilePath : getSubFilePaths()) {
+        QString dependency = QFileInfo(subFilePath).absoluteFilePath();
+        if (dependency == topLevelPath || dependencies.contains(dependency))
+            continue;
+        QFile file(dependency);
+        if (!file.open(QIODevice::ReadOnly))
+            return;
+        dependencies << dependency;
+        dependencyHashes << QCryptographicHash::hash(file.readAll(), QCryptographicHash::Md5);
+    }
+
+    QFile file(snapshotFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        emit gui->messageSig(LOG_NOTICE, QString("Cannot write model snapshot %1:\n%2.")
+                             .arg(snapshotFile)
+                             .arg(file.errorString()));
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_4_8);
+
+    out << quint32(LDRAW_SNAPSHOT_MAGIC) << quint32(LDRAW_SNAPSHOT_VERSION)
+        << fileHash << dependencies << dependencyHashes
+        << _mpd << _file << _name << _author << _description << _category
+        << qint32(_partCount) << _loadedParts << _ldcadGroups << _subFileOrder
+        << qint32(_subFiles.size());
+
+    for (const LDrawSubFile &subFile : _subFiles) {
+        out << subFile._fileName << subFile._contents << subFile._subFilePath << subFile._datetime
+            << qint32(subFile._unofficialPart) << qint32(subFile._numSteps)
+            << qint32(subFile._instances) << qint32(subFile._mirrorInstances);
+    }
+    file.close();
+
+    pruneSnapshots(LDRAW_SNAPSHOT_LIMIT);
+}
+
+/* remove all but the keep most recently written snapshots */
+
+void LDrawFile::pruneSnapshots(int keep)
+{
+    QDir snapshotDir(QString("%1/%2").arg(Preferences::lpubDataPath).arg(Paths::snapshotsDir));
+    const QFileInfoList snapshots = snapshotDir.entryInfoList(QStringList() << "*.lps", QDir::Files, QDir::Time);
+
+    for (int i = keep; i < snapshots.size(); i++)
+        QFile::remove(snapshots.at(i).absoluteFilePath());
+}
+
 void LDrawFile::showLoadMessages()
 {
     if (_showLoadMessages && Preferences::modeGUI)
         LdrawFilesLoad::showLoadMessages(_loadedParts);
 }
 
+/*
+ * Append the trimmed lines of an open file to lines.
+ * The file is memory mapped where possible and split in place on \n, \r\n
+ * or a lone \r, as QTextStream::readLine does, so each line is decoded
+ * straight into its final QString.
+ * Returns the number of bytes read.
+ */
+static qint64 readTrimmedLines(QFile &file, bool utf8, QStringList &lines)
+{
+    const qint64 size = file.size();
+    QByteArray buffer;
+    const char *data = nullptr;
+
+    if (size > 0)
+        data = reinterpret_cast<const char *>(file.map(0, size));
+    const bool mapped = data != nullptr;
+    if (!mapped) {
+        buffer = file.readAll();
+        data = buffer.constData();
+    }
+
+    const char *pos = data;
+    const char *end = data + (mapped ? size : buffer.size());
+
+    // skip UTF-8 byte order mark
+    if (utf8 && end - pos >= 3 && pos[0] == '\xEF' && pos[1] == '\xBB' && pos[2] == '\xBF')
+        pos += 3;
+
+    lines.reserve(lines.size() + int((end - pos) / 40));
+
+    while (pos < end) {
+        const char *eol = pos;
+        while (eol < end && *eol != '\n' && *eol != '\r')
+            ++eol;
+        const char *next = eol < end ? eol + 1 : end;
+        if (next < end && *eol == '\r' && *next == '\n')
+            ++next;
+        const int length = int(eol - pos);
+        lines << (utf8 ? QString::fromUtf8(pos, length) : QString::fromLocal8Bit(pos, length)).trimmed();
+        pos = next;
+    }
+
+    const qint64 bytes = end - data;
+    if (mapped)
+        file.unmap(reinterpret_cast<uchar *>(const_cast<char *>(data)));
+    file.close();
+
+    return bytes;
+}
+
 void LDrawFile::loadMPDFile(const QString &fileName, QDateTime &datetime)
 {    
     QFile file(fileName);
-    if (!file.open(QFile::ReadOnly | QFile::Text)) {
+    if (!file.open(QFile::ReadOnly)) {
         emit gui->messageSig(LOG_ERROR, QString("Cannot read file %1:\n%2.")
                              .arg(fileName)
                              .arg(file.errorString()));
         return;
     }
 
+    QElapsedTimer timer;
+    timer.start();
+
     QFileInfo   fileInfo(fileName);
-    QTextStream in(&file);
-    in.setCodec(_currFileIsUTF8 ? QTextCodec::codecForName("UTF-8") : QTextCodec::codecForName("System"));
 
     QStringList stageContents;
     QStringList stageSubfiles;
@@ -721,11 +1083,7 @@ void LDrawFile::loadMPDFile(const QString &fileName, QDateTime &datetime)
     /* Read it in the first time to put into fileList in order of
      appearance */
 
-    while ( ! in.atEnd()) {
-        QString sLine = in.readLine(0);
-        stageContents << sLine.trimmed();
-    }
-    file.close();
+    qint64 stageBytes = readTrimmedLines(file, _currFileIsUTF8, stageContents);
 
     topLevelFileNotCaptured        = true;
     topLevelNameNotCaptured        = true;
@@ -755,6 +1113,16 @@ void LDrawFile::loadMPDFile(const QString &fileName, QDateTime &datetime)
         return topLevelModel ? "model" : "submodel";
     };
 
+    // compiled once for the whole load, including recursive subfile passes
+    QRegExp sofRE("^0\\s+FILE\\s+(.*)$",Qt::CaseInsensitive);
+    QRegExp eofRE("^0\\s+NOFILE\\s*$",Qt::CaseInsensitive);
+
+    QRegExp upAUT("^0\\s+Author:?\\s+(.*)$",Qt::CaseInsensitive);
+    QRegExp upNAM("^0\\s+Name:?\\s+(.*)$",Qt::CaseInsensitive);
+    QRegExp upCAT("^0\\s+!?CATEGORY\\s+(.*)$",Qt::CaseInsensitive);
+
+    QRegExp ldcGRP( "^\\s*0\\s+!?LDCAD\\s+GROUP_DEF.*\\s+\\[LID=(\\d+)\\]\\s+\\[GID=([\\d\\w]+)\\]\\s+\\[name=(.[^\\]]+)\\].*$");
+
     std::function<void(int)> loadMPDContents;
     loadMPDContents = [
             this,
@@ -763,20 +1131,19 @@ void LDrawFile::loadMPDFile(const QString &fileName, QDateTime &datetime)
             &loadMPDContents,
             &stageContents,
             &stageSubfiles,
+            &stageBytes,
             &fileInfo,
             &searchPaths,
-            &datetime] (int i) {
+            &datetime,
+            &sofRE,
+            &eofRE,
+            &upAUT,
+            &upNAM,
+            &upCAT,
+            &ldcGRP] (int i) {
         bool alreadyLoaded;
         QStringList contents;
         QString     subfileName;
-        QRegExp sofRE("^0\\s+FILE\\s+(.*)$",Qt::CaseInsensitive);
-        QRegExp eofRE("^0\\s+NOFILE\\s*$",Qt::CaseInsensitive);
-
-        QRegExp upAUT("^0\\s+Author:?\\s+(.*)$",Qt::CaseInsensitive);
-        QRegExp upNAM("^0\\s+Name:?\\s+(.*)$",Qt::CaseInsensitive);
-        QRegExp upCAT("^0\\s+!?CATEGORY\\s+(.*)$",Qt::CaseInsensitive);
-
-        QRegExp ldcGRP( "^\\s*0\\s+!?LDCAD\\s+GROUP_DEF.*\\s+\\[LID=(\\d+)\\]\\s+\\[GID=([\\d\\w]+)\\]\\s+\\[name=(.[^\\]]+)\\].*$");
 
         emit gui->progressBarPermInitSig();
         emit gui->progressPermRangeSig(1, stageContents.size());
@@ -792,26 +1159,32 @@ void LDrawFile::loadMPDFile(const QString &fileName, QDateTime &datetime)
 
             emit gui->progressPermSetValueSig(i);
 
-            bool sof = smLine.contains(sofRE);  //start of file
-            bool eof = smLine.contains(eofRE);  //end of file
+            // classify by line type so only meta lines go through the patterns
+            const QChar lineType = smLine.isEmpty() ? QChar() : smLine.at(0);
+            const bool metaLine  = lineType == '0';
+
+            bool sof = metaLine && smLine.contains(sofRE);  //start of file
+            bool eof = metaLine && smLine.contains(eofRE);  //end of file
 
             // load LDCad groups
-            if (!ldcadGroupsLoaded && smLine.contains(ldcGRP)){
-               insertLDCadGroup(ldcGRP.cap(3),ldcGRP.cap(1).toInt());
-               insertLDCadGroup(ldcGRP.cap(2),ldcGRP.cap(1).toInt());
-            } else if (smLine.contains("0 STEP")) {
-               ldcadGroupsLoaded = true;
+            if (metaLine) {
+                if (!ldcadGroupsLoaded && smLine.contains(ldcGRP)){
+                   insertLDCadGroup(ldcGRP.cap(3),ldcGRP.cap(1).toInt());
+                   insertLDCadGroup(ldcGRP.cap(2),ldcGRP.cap(1).toInt());
+                } else if (smLine.contains("0 STEP")) {
+                   ldcadGroupsLoaded = true;
+                }
             }
 
-            QStringList tokens;
-            split(smLine,tokens);
-
             // subfile check;
             QString stageSubfileName;
             bool subFileFound = false;
-            if ((subFileFound = tokens.size() == 15 && tokens.at(0) == "1")) {
-                stageSubfileName = tokens.at(14).toLower();
-            } else if (isSubstitute(smLine,stageSubfileName)) {
+            if (lineType == '1') {
+                LDrawTokens tokens(smLine);
+                if ((subFileFound = tokens.size() == 15 && tokens.at(0) == "1")) {
+                    stageSubfileName = tokens.at(14).toString().toLower();
+                }
+            } else if (metaLine && isSubstitute(smLine,stageSubfileName)) {
                 subFileFound = !stageSubfileName.isEmpty();
             }
             if (subFileFound) {
@@ -829,7 +1202,7 @@ void LDrawFile::loadMPDFile(const QString &fileName, QDateTime &datetime)
                 }
             }
 
-            if (topLevelAuthorNotCaptured) {
+            if (topLevelAuthorNotCaptured && metaLine) {
                 if (smLine.contains(upAUT)) {
                     _author = upAUT.cap(1).replace(": ","");
                     Preferences::defaultAuthor = _author;
@@ -837,14 +1210,14 @@ void LDrawFile::loadMPDFile(const QString &fileName, QDateTime &datetime)
                 }
             }
 
-            if (topLevelNameNotCaptured) {
+            if (topLevelNameNotCaptured && metaLine) {
                 if (smLine.contains(upNAM)) {
                     _name = upNAM.cap(1).replace(": ","");
                     topLevelNameNotCaptured = false;
                 }
             }
 
-            if (topLevelCategoryNotCaptured && subfileName == topLevelFile()) {
+            if (topLevelCategoryNotCaptured && metaLine && subfileName == topLevelFile()) {
                 if (smLine.contains(upCAT)) {
                         _category = upCAT.cap(1);
                     topLevelCategoryNotCaptured = false;
@@ -961,25 +1334,21 @@ void LDrawFile::loadMPDFile(const QString &fileName, QDateTime &datetime)
                 }
 
                 if (!subFileFound) {
+                    _loadMissing = true;
                     emit gui->messageSig(LOG_NOTICE, QString("Subfile %1 not found.")
                                          .arg(subfile));
                 } else {
                     setSubFilePath(subfile,fileInfo.absoluteFilePath());
                     stageSubfiles.removeAt(stageSubfiles.indexOf(subfile));
                     file.setFileName(fileInfo.absoluteFilePath());
-                    if (!file.open(QFile::ReadOnly | QFile::Text)) {
+                    if (!file.open(QFile::ReadOnly)) {
                         emit gui->messageSig(LOG_NOTICE, QString("Cannot read file %1:\n%2.")
                                              .arg(fileInfo.absoluteFilePath())
                                              .arg(file.errorString()));
                         return;
                     }
 
-                    QTextStream in(&file);
-                    in.setCodec(_currFileIsUTF8 ? QTextCodec::codecForName("UTF-8") : QTextCodec::codecForName("System"));
-                    while ( ! in.atEnd()) {
-                        QString sLine = in.readLine(0);
-                        stageContents << sLine.trimmed();
-                    }
+                    stageBytes += readTrimmedLines(file, _currFileIsUTF8, stageContents);
                 }
             }
             if (subFileFound) {
@@ -1004,13 +1373,22 @@ void LDrawFile::loadMPDFile(const QString &fileName, QDateTime &datetime)
 
     _mpd = true;
 
+    qint64 elapsed = timer.elapsed();
+    emit gui->messageSig(LOG_INFO, QString("MPD file %1 parsed: %2 lines, %3 MB in %4 ms (%5 MB/s).")
+                         .arg(QFileInfo(fileName).fileName())
+                         .arg(stageContents.size())
+                         .arg(double(stageBytes) / 1048576.0, 0, 'f', 2)
+                         .arg(elapsed)
+                         .arg(elapsed ? (double(stageBytes) / 1048576.0) / (double(elapsed) / 1000.0) : 0.0, 0, 'f', 1));
+
     emit gui->progressPermSetValueSig(stageContents.size());
     emit gui->progressPermStatusRemoveSig();
 }
 
 void LDrawFile::loadLDRFile(const QString &path, const QString &fileName)
 {
-    if (_subFiles[fileName]._contents.isEmpty()) {
+    LDrawSubFile *f = subFile(fileName);
+    if (!f || f->_contents.isEmpty()) {
 
         QString fullName(path + QDir::separator() + fileName);
 
@@ -1108,8 +1486,7 @@ void LDrawFile::loadLDRFile(const QString &path, const QString &fileName)
                ldcadGroupsLoaded = true;
             }
 
-            QStringList tokens;
-            split(line,tokens);
+            LDrawTokens tokens(line);
 
             if (topLevelModel) {
 
@@ -1144,7 +1521,7 @@ void LDrawFile::loadLDRFile(const QString &path, const QString &fileName)
             QString subfileName;
             bool subFileFound = false;
             if ((subFileFound = tokens.size() == 15 && tokens.at(0) == "1")) {
-                subfileName = tokens.at(14);
+                subfileName = tokens.toString(14);
             } else if (isSubstitute(line,subfileName)) {
                 subFileFound = !subfileName.isEmpty();
             }
@@ -1179,6 +1556,7 @@ void LDrawFile::loadLDRFile(const QString &path, const QString &fileName)
                         topLevelModel = false;
                         loadLDRFile(subFileInfo.absolutePath(),subFileInfo.fileName());
                     } else {
+                        _loadMissing = true;
                         emit gui->messageSig(LOG_NOTICE, QString("Subfile %1 not found.")
                                              .arg(subFileInfo.fileName()));
                     }
@@ -1208,8 +1586,8 @@ bool LDrawFile::saveFile(const QString &fileName)
     return rc;
 }
  
-bool LDrawFile::mirrored(
-  const QStringList &tokens)
+template <class Tokens>
+static bool isMirrored(const Tokens &tokens)
 {
   if (tokens.size() != 15) {
     return false;
@@ -1238,6 +1616,18 @@ bool LDrawFile::mirrored(
   //return a*(e*i - f*h) - b*(d*i - f*g) + c*(d*h - e*g) < 0;
 }
 
+bool LDrawFile::mirrored(
+  const QStringList &tokens)
+{
+  return isMirrored(tokens);
+}
+
+bool LDrawFile::mirrored(
+  const LDrawTokens &tokens)
+{
+  return isMirrored(tokens);
+}
+
 void LDrawFile::countInstances(const QString &mcFileName, bool isMirrored, bool callout)
 {
   //logTrace() << QString("countInstances, File: %1, Mirrored: %2, Callout: %3").arg(mcFileName,(isMirrored?"Yes":"No"),(callout?"Yes":"No"));
@@ -1247,8 +1637,8 @@ void LDrawFile::countInstances(const QString &mcFileName, bool isMirrored, bool
   bool noStep = false;
   bool stepIgnore = false;
   
-  QMap<QString, LDrawSubFile>::iterator f = _subFiles.find(fileName);
-  if (f != _subFiles.end()) {
+  LDrawSubFile *f = subFile(fileName);
+  if (f) {
     // count mirrored instance automatically
     if (f->_beenCounted) {
       if (isMirrored) {
@@ -1263,10 +1653,9 @@ void LDrawFile::countInstances(const QString &mcFileName, bool isMirrored, bool
     f->_numSteps = 0;
 
     // process submodel content...
+    LDrawTokens tokens;
     for (int i = 0; i < j; i++) {
-      QStringList tokens;
-      QString line = f->_contents[i];
-      split(line,tokens);
+      tokens.tokenize(f->_contents[i]);
       
       /* Sorry, but models that are callouts are not counted as instances */
           // called out
@@ -1278,10 +1667,11 @@ void LDrawFile::countInstances(const QString &mcFileName, bool isMirrored, bool
         partsAdded = true;
            //process callout content
         for (++i; i < j; i++) {
-          split(f->_contents[i],tokens);
+          tokens.tokenize(f->_contents[i]);
           if (tokens.size() == 15 && tokens[0] == "1") {
-            if (contains(tokens[14]) && ! stepIgnore) {
-              countInstances(tokens[14],mirrored(tokens),true);
+            QString type = tokens.toString(14);
+            if (contains(type) && ! stepIgnore) {
+              countInstances(type,mirrored(tokens),true);
             }
           } else if (tokens.size() == 4 &&
               tokens[0] == "0" && 
@@ -1329,9 +1719,10 @@ void LDrawFile::countInstances(const QString &mcFileName, bool isMirrored, bool
                                      && tokens[1] == "BUFEXCHG") {
         // check if subfile and process...
       } else if (tokens.size() == 15 && tokens[0] == "1") {
-        bool containsSubFile = contains(tokens[14]);
+        QString type = tokens.toString(14);
+        bool containsSubFile = contains(type);
         if (containsSubFile && ! stepIgnore) {
-          countInstances(tokens[14],mirrored(tokens),false);
+          countInstances(type,mirrored(tokens),false);
         }
         partsAdded = true;
       }
@@ -1357,7 +1748,7 @@ void LDrawFile::countInstances()
 {
   for (int i = 0; i < _subFileOrder.size(); i++) {
     QString fileName = _subFileOrder[i].toLower();
-    QMap<QString, LDrawSubFile>::iterator it = _subFiles.find(fileName);
+    LDrawSubFile *it = subFile(fileName);
     it->_instances = 0;
     it->_mirrorInstances = 0;
     it->_beenCounted = false;
@@ -1380,11 +1771,11 @@ bool LDrawFile::saveMPDFile(const QString &fileName)
     out.setCodec(_currFileIsUTF8 ? QTextCodec::codecForName("UTF-8") : QTextCodec::codecForName("System"));
     for (int i = 0; i < _subFileOrder.size(); i++) {
       QString subFileName = _subFileOrder[i];
-      QMap<QString, LDrawSubFile>::iterator f = _subFiles.find(subFileName);
-      if (f != _subFiles.end() && ! f.value()._generated) {
-        if (!f.value()._subFilePath.isEmpty()) {
+      LDrawSubFile *f = subFile(subFileName);
+      if (f && ! f->_generated) {
+        if (!f->_subFilePath.isEmpty()) {
             file.close();
-            writeFileName = f.value()._subFilePath;
+            writeFileName = f->_subFilePath;
             file.setFileName(writeFileName);
             if (!file.open(QFile::WriteOnly | QFile::Text)) {
                 emit gui->messageSig(LOG_ERROR,QString("Cannot write file %1:\n%2.")
@@ -1397,8 +1788,8 @@ bool LDrawFile::saveMPDFile(const QString &fileName)
             out.setCodec(_currFileIsUTF8 ? QTextCodec::codecForName("UTF-8") : QTextCodec::codecForName("System"));
         }
         out << "0 FILE " << subFileName << endl;
-        for (int j = 0; j < f.value()._contents.size(); j++) {
-          out << f.value()._contents[j] << endl;
+        for (int j = 0; j < f->_contents.size(); j++) {
+          out << f->_contents[j] << endl;
         }
         out << "0 NOFILE " << endl;
       }
@@ -1415,17 +1806,17 @@ void LDrawFile::countParts(const QString &fileName){
 
     QRegExp validExtRx("\\.DAT|\\.LDR|\\.MPD$",Qt::CaseInsensitive);
 
-    QMap<QString, LDrawSubFile>::iterator f = _subFiles.find(fileName.toLower());
-    if (f != _subFiles.end()) {
+    LDrawSubFile *f = subFile(fileName.toLower());
+    if (f) {
         // get content size and reset numSteps
         int j = f->_contents.size();
 
         // process submodel content...
+        LDrawTokens tokens;
         for (int i = 0; i < j; i++) {
-            QStringList tokens;
             QString line = f->_contents[i];
 
-            split(line,tokens);
+            tokens.tokenize(line);
 
             bool doCountPart = true;
 
@@ -1451,8 +1842,8 @@ void LDrawFile::countParts(const QString &fileName){
             }
 
             QString partToken;
-            if (doCountPart && tokens.size() == 15 && tokens[0] == "1" && (tokens[14].contains(validExtRx))) {
-                partToken = tokens[14];
+            if (doCountPart && tokens.size() == 15 && tokens[0] == "1" && (tokens.toString(14).contains(validExtRx))) {
+                partToken = tokens.toString(14);
             } else if ((doCountPart = isSubstitute(line,partToken))) {
                 doCountPart = !partToken.isEmpty() && partToken.contains(validExtRx);
             }
@@ -1529,6 +1920,7 @@ void LDrawFile::countParts(const QString &fileName){
                             }
                         } else {
                             partString += QString("Part not found");
+                            _loadMissing = true;
                             if (!_loadedParts.contains(QString(MISSING_LOAD_MSG) + partString)) {
                                 _loadedParts.append(QString(MISSING_LOAD_MSG) + partString);
                                 emit gui->messageSig(LOG_NOTICE,QString("Part [%1] not excluded, not a submodel and not found in the %2 library archives.")
@@ -1556,11 +1948,11 @@ bool LDrawFile::saveLDRFile(const QString &fileName)
         writeFileName = path + QDir::separator() + _subFileOrder[i];
       }
       file.setFileName(writeFileName);
-      QMap<QString, LDrawSubFile>::iterator f = _subFiles.find(_subFileOrder[i]);
-      if (f != _subFiles.end() && ! f.value()._generated) {
-        if (f.value()._modified) {
-          if (!f.value()._subFilePath.isEmpty()) {
-              writeFileName = f.value()._subFilePath;
+      LDrawSubFile *f = subFile(_subFileOrder[i]);
+      if (f && ! f->_generated) {
+        if (f->_modified) {
+          if (!f->_subFilePath.isEmpty()) {
+              writeFileName = f->_subFilePath;
               file.setFileName(writeFileName);
           }
           if (!file.open(QFile::WriteOnly | QFile::Text)) {
@@ -1571,8 +1963,8 @@ bool LDrawFile::saveLDRFile(const QString &fileName)
           }
           QTextStream out(&file);
           out.setCodec(_currFileIsUTF8 ? QTextCodec::codecForName("UTF-8") : QTextCodec::codecForName("System"));
-          for (int j = 0; j < f.value()._contents.size(); j++) {
-            out << f.value()._contents[j] << endl;
+          for (int j = 0; j < f->_contents.size(); j++) {
+            out << f->_contents[j] << endl;
           }
           file.close();
         }
@@ -1585,10 +1977,10 @@ bool LDrawFile::saveLDRFile(const QString &fileName)
 bool LDrawFile::changedSinceLastWrite(const QString &fileName)
 {
   QString mcFileName = fileName.toLower();
-  QMap<QString, LDrawSubFile>::iterator i = _subFiles.find(mcFileName);
-  if (i != _subFiles.end()) {
-    bool value = i.value()._changedSinceLastWrite;
-    i.value()._changedSinceLastWrite = false;
+  LDrawSubFile *i = subFile(mcFileName);
+  if (i) {
+    bool value = i->_changedSinceLastWrite;
+    i->_changedSinceLastWrite = false;
     return value;
   }
   return false;
@@ -1596,9 +1988,8 @@ bool LDrawFile::changedSinceLastWrite(const QString &fileName)
 
 void LDrawFile::tempCacheCleared()
 {
-  QString key;
-  foreach(key,_subFiles.keys()) {
-    _subFiles[key]._changedSinceLastWrite = true;
+  for (int i = 0; i < _subFiles.size(); i++) {
+    _subFiles[i]._changedSinceLastWrite = true;
   }
 }
 
@@ -1755,109 +2146,149 @@ void LDrawFile::clearViewerSteps()
 
 // -- -- Utility Functions -- -- //
 
-int split(const QString &line, QStringList &argv)
+// Index of the next unescaped quote at or after from, -1 if there is none
+static int unescapedQuote(const QString &line, int from)
 {
-  QString     chopped = line;
-  int         p = 0;
-  int         length = chopped.length();
+  int soq = line.indexOf('"', from);
+  while (soq > from && line.at(soq - 1) == '\\')
+      soq = line.indexOf('"', soq + 1);
+  return soq;
+}
+
+void LDrawTokens::splitSpaces(int from, int to)
+{
+  int p = from;
+  while (p < to) {
+      while (p < to && _line.at(p) == ' ')
+          p++;
+      int start = p;
+      while (p < to && _line.at(p) != ' ')
+          p++;
+      if (p > start)
+          append(start, p - start);
+    }
+}
+
+int LDrawTokens::tokenize(const QString &line)
+{
+  _line = line;
+  _tokens.clear();
+  _blank = true;
+  _rc = 0;
+
+  int p = 0;
+  const int length = _line.length();
 
   // line length check
   if (p == length) {
-      return 0;
+      return _rc;
     }
   // eol check
-  while (chopped[p] == ' ') {
+  while (_line.at(p) == ' ') {
       if (++p == length) {
-          return -1;
+          return _rc = -1;
         }
     }
 
-  argv.clear();
+  _blank = false;
 
   // if line starts with 1 (part line)
-  if (chopped[p] == '1') {
+  if (_line.at(p) == '1') {
 
       // line length check
-      argv << "1";
+      append(p, 1);
       p += 2;
       if (p >= length) {
-          return -1;
+          return _rc = -1;
         }
       // eol check
-      while (chopped[p] == ' ') {
+      while (_line.at(p) == ' ') {
           if (++p >= length) {
-              return -1;
+              return _rc = -1;
             }
         }
 
       // color x y z a b c d e f g h i //
 
-      // populate argv with part line tokens
+      // populate tokens with part line tokens
       for (int i = 0; i < 13; i++) {
-          QString token;
-
-          while (chopped[p] != ' ') {
-              token += chopped[p];
+          int start = p;
+          while (_line.at(p) != ' ') {
               if (++p >= length) {
-                  return -1;
+                  return _rc = -1;
                 }
             }
-          argv << token;
-          while (chopped[p] == ' ') {
+          append(start, p - start);
+          while (_line.at(p) == ' ') {
               if (++p >= length) {
-                  return -1;
+                  return _rc = -1;
                 }
             }
         }
 
-      argv << chopped.mid(p);
+      // the type name may contain spaces
+      append(p, length - p);
 
-      if (argv.size() > 1 && argv[1] == "WRITE") {
-          argv.removeAt(1);
+      if (_tokens.size() > 1 && at(1) == "WRITE") {
+          _tokens.remove(1);
         }
 
-    } else if (chopped[p] >= '2' && chopped[p] <= '5') {
-      chopped = chopped.mid(p);
-      argv << chopped.split(" ",QString::SkipEmptyParts);
-    } else if (chopped[p] == '0') {
+    } else if (_line.at(p) >= '2' && _line.at(p) <= '5') {
+      splitSpaces(p, length);
+    } else if (_line.at(p) == '0') {
 
-      /* Parse the input line into argv[] */
+      /* Parse the line into tokens, a quoted string is a single token */
 
-      int soq = validSoQ(chopped,chopped.indexOf("\""));
-      if (soq == -1) {
-          argv << chopped.split(" ",QString::SkipEmptyParts);
-        } else {
-          // quotes found
-          while (chopped.size()) {
-              soq = validSoQ(chopped,chopped.indexOf("\""));
-              if (soq == -1) {
-                  argv << chopped.split(" ",QString::SkipEmptyParts);
-                  chopped.clear();
-                } else {
-                  QString left = chopped.left(soq);
-                  left = left.trimmed();
-                  argv << left.split(" ",QString::SkipEmptyParts);
-                  chopped = chopped.mid(soq+1);
-                  soq = validSoQ(chopped,chopped.indexOf("\""));
-                  if (soq == -1) {
-                      argv << left;
-                      return -1;
-                    }
-                  argv << chopped.left(soq);
-                  chopped = chopped.mid(soq+1);
-                  if (chopped == "\"") {
-                    }
-                }
+      int from = 0;
+      while (from < length) {
+          int soq = unescapedQuote(_line, from);
+          if (soq == -1) {
+              splitSpaces(from, length);
+              break;
+            }
+          // trimmed text before the quote
+          int left = from, right = soq;
+          while (left < right && _line.at(left).isSpace())
+              left++;
+          while (right > left && _line.at(right - 1).isSpace())
+              right--;
+          splitSpaces(left, right);
+          from = soq + 1;
+          soq = unescapedQuote(_line, from);
+          if (soq == -1) {
+              append(left, right - left);
+              return _rc = -1;
             }
+          append(from, soq - from);
+          from = soq + 1;
         }
 
-      if (argv.size() > 1 && argv[0] == "0" && argv[1] == "GHOST") {
-          argv.removeFirst();
-          argv.removeFirst();
+      if (_tokens.size() > 1 && at(0) == "0" && at(1) == "GHOST") {
+          _tokens.remove(0, 2);
         }
     }
 
-  return 0;
+  return _rc;
+}
+
+QStringList LDrawTokens::toStringList() const
+{
+  QStringList list;
+  list.reserve(_tokens.size());
+  for (int i = 0; i < _tokens.size(); i++)
+      list << toString(i);
+  return list;
+}
+
+int split(const QString &line, QStringList &argv)
+{
+  LDrawTokens tokens(line);
+
+  // blank lines leave argv untouched
+  if (! tokens.isBlank())
+      argv = tokens.toStringList();
+
+  return tokens.rc();
 }
 
 // check for escaped quotes
@@ -1884,6 +2315,7 @@ QList<QRegExp> LDrawUnofficialOtherRegExp;
 
 LDrawFile::LDrawFile()
 {
+    _modelStamp = ++_modelStamps;
     _loadedParts.clear();
   {
     LDrawHeaderRegExp
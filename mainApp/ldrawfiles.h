@@ -33,10 +33,14 @@
 #include <QStringList>
 #include <QString>
 #include <QMap>
+#include <QHash>
+#include <QVector>
 #include <QDateTime>
 #include <QList>
+#include <QVarLengthArray>
 
 #include "excludedparts.h"
+#include "where.h"
 #include "QsLog.h"
 
 extern QList<QRegExp> LDrawHeaderRegExp;
@@ -45,9 +49,87 @@ extern QList<QRegExp> LDrawUnofficialSubPartRegExp;
 extern QList<QRegExp> LDrawUnofficialPrimitiveRegExp;
 extern QList<QRegExp> LDrawUnofficialOtherRegExp;
 
+/*
+ * Tokenize an LDraw line the same way split() does, but record each token
+ * as an offset into the line instead of copying it. Up to 15 tokens, a
+ * full type 1 line, are kept inline so scanning a line does not allocate.
+ * The line is held by implicit sharing, so the tokens stay valid for the
+ * life of this object.
+ */
+class LDrawTokens
+{
+  public:
+    enum { InlineTokens = 15 };
+
+    LDrawTokens() : _rc(0), _blank(true) {}
+    explicit LDrawTokens(const QString &line)
+    {
+      tokenize(line);
+    }
+
+    int tokenize(const QString &line);
+
+    int size() const
+    {
+      return _tokens.size();
+    }
+    bool isEmpty() const
+    {
+      return _tokens.isEmpty();
+    }
+    // true when the line holds nothing but spaces, in which case split() leaves argv as is
+    bool isBlank() const
+    {
+      return _blank;
+    }
+    // same return code as split()
+    int rc() const
+    {
+      return _rc;
+    }
+
+    QStringRef at(int i) const
+    {
+      return QStringRef(&_line, _tokens[i].pos, _tokens[i].length);
+    }
+    QStringRef operator[](int i) const
+    {
+      return at(i);
+    }
+    QStringRef last() const
+    {
+      return at(_tokens.size() - 1);
+    }
+    QString toString(int i) const
+    {
+      return _line.mid(_tokens[i].pos, _tokens[i].length);
+    }
+    QStringList toStringList() const;
+
+  private:
+    struct Token
+    {
+      int pos;
+      int length;
+    };
+
+    void append(int pos, int length)
+    {
+      const Token token = { pos, length };
+      _tokens.append(token);
+    }
+    void splitSpaces(int from, int to);
+
+    QString _line;
+    QVarLengthArray<Token, InlineTokens> _tokens;
+    int  _rc;
+    bool _blank;
+};
+
 class LDrawSubFile {
   public:
     QStringList _contents;
+    QString     _fileName;
     QString     _subFilePath;
     bool        _modified;
     QDateTime   _datetime;
@@ -111,13 +193,16 @@ class ViewerStep {
 
 class LDrawFile {
   private:
-    QMap<QString, LDrawSubFile> _subFiles;
+    QVector<LDrawSubFile>       _subFiles;   // indexed by model id
+    QHash<QString, int>         _subFileIds; // lower case name to model id
+    int                         _modelStamp; // renewed whenever model ids are reassigned
     QMap<QString, ViewerStep>   _viewerSteps;
     QMultiHash<QString, int>    _ldcadGroups;
     QStringList                 _emptyList;
     QString                     _emptyString;
     bool                        _mpd;
     static int                  _emptyInt;
+    static int                  _modelStamps;
 
     ExcludedParts               excludedParts; // internal list of part count excluded parts
 
@@ -131,6 +216,13 @@ class LDrawFile {
     bool ldcadGroupsLoaded;
     int  descriptionLine;
 
+    QString snapshotFileName(const QString &fileName);
+    bool loadSnapshot(const QString &fileName, const QByteArray &fileHash);
+    void saveSnapshot(const QString &fileName, const QByteArray &fileHash);
+
+    LDrawSubFile *subFile(const QString &fileName);
+    LDrawSubFile *subFile(const Where &here);
+
   public:
     LDrawFile();
     ~LDrawFile()
@@ -151,12 +243,14 @@ class LDrawFile {
     static int                  _partCount;
     static bool                 _showLoadMessages;
     static bool                 _loadAborted;
+    static bool                 _loadMissing;
 
     int getPartCount(){
       return _partCount;
     }
 
     static void showLoadMessages();
+    static void pruneSnapshots(int keep);
 
     bool saveFile(const QString &fileName);
     bool saveMPDFile(const QString &filename);
@@ -170,6 +264,8 @@ class LDrawFile {
                       const QString &subFilePath = QString());
 
     int  size(const QString &fileName);
+    int  size(const Where &here);
+    int  modelIndex(const QString &fileName);
     void empty();
 
     QStringList getSubFilePaths();
@@ -192,6 +288,7 @@ class LDrawFile {
     QStringList subFileOrder();
     
     QString readLine(const QString &fileName, int lineNumber);
+    QString readLine(const Where &here);
     void insertLine( const QString &fileName, int lineNumber, const QString &line);
     void replaceLine(const QString &fileName, int lineNumber, const QString &line);
     void deleteLine( const QString &fileName, int lineNumber);
@@ -199,6 +296,9 @@ class LDrawFile {
                               int      position, 
                               int      charsRemoved, 
                         const QString &charsAdded);
+    QString readContents(const QString &fileName,
+                               int      position,
+                               int      count);
 
     bool isMpd();
     QString topLevelFile();
@@ -213,6 +313,7 @@ class LDrawFile {
     bool older(const QStringList &parsedStack,
                const QDateTime &lastModified);
     static bool mirrored(const QStringList &tokens);
+    static bool mirrored(const LDrawTokens &tokens);
     void unrendered();
     void setRendered(
             const QString &fileName,
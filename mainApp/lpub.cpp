@@ -50,6 +50,7 @@
 #include "ranges_element.h"
 #include "updatecheck.h"
 #include "step.h"
+#include "imagecache.h"
 #include "messageboxresizable.h"
 
 #include "aboutdialog.h"
@@ -306,6 +307,9 @@ void Gui::displayPage()
 
   timer.start();
   if (macroNesting == 0) {
+      // this redraw covers any pending deferred re-layout
+      displayPageTimer->stop();
+
       clearPage(KpageView,KpageScene);
       page.coverPage = false;
       drawPage(KpageView,KpageScene,false);
@@ -1320,6 +1324,11 @@ bool Gui::installExportBanner(const int &type, const QString &printFile, const Q
         bannerData << "1 73 -2 -4 -32 1 0 0 0 0.423 -0.906 0 0.906 0.423 3070bptb.dat";
         bannerData << "1 73 18 -4 -32 1 0 0 0 0.423 -0.906 0 0.906 0.423 3070bptj.dat";
         break;
+    case EXPORT_GLTF:
+        bannerData << "1 73 -22 -4 -32 1 0 0 0 0.423 -0.906 0 0.906 0.423 3070bptg.dat";
+        bannerData << "1 73 -2 -4 -32 1 0 0 0 0.423 -0.906 0 0.906 0.423 3070bptl.dat";
+        bannerData << "1 73 18 -4 -32 1 0 0 0 0.423 -0.906 0 0.906 0.423 3070bptb.dat";
+        break;
     case EXPORT_COLLADA:
         bannerData << "1 73 -22 -4 -32 1 0 0 0 0.423 -0.906 0 0.906 0.423 3070bptd.dat";
         bannerData << "1 73 -2 -4 -32 1 0 0 0 0.423 -0.906 0 0.906 0.423 3070bpta.dat";
@@ -1499,10 +1508,10 @@ void Gui::reloadCurrentModelFile(){
 void Gui::resetModelCache(QString file)
 {
     if (resetCache && !file.isEmpty()) {
-        emit messageSig(LOG_TRACE, QString("Reset parts cache is destructive!"));
+        emitMessage(LOG_TRACE, QString("Reset parts cache is destructive!"));
         curFile = file;
         QString fileDir = QFileInfo(file).absolutePath();
-        emit messageSig(LOG_INFO, QString("Reset parts cache directory %1").arg(fileDir));
+        emitMessage(LOG_INFO, QString("Reset parts cache directory %1").arg(fileDir));
         QString saveCurrentDir = QDir::currentPath();
         if (! QDir::setCurrent(fileDir))
             emit messageSig(LOG_ERROR, QString("Reset cache failed to set current directory %1").arg(fileDir));
@@ -1578,6 +1587,8 @@ void Gui::clearAllCaches()
         clearCSICache();
         clearSubmodelCache();
         clearTempCache();
+        ImageCache::clear();
+        LDrawFile::pruneSnapshots(0);
 
         //reload current model file
         int savePage = displayPageNum;
@@ -1603,7 +1614,7 @@ void Gui::clearCustomPartCache(bool silent)
                             .arg(Paths::customDir)
                             .arg(Preferences::validLDrawCustomArchive);
   if (silent || !Preferences::modeGUI) {
-      emit messageSig(LOG_INFO,message);
+      emitMessage(LOG_INFO,message);
   } else {
       ret = QMessageBox::warning(this, tr(VER_PRODUCTNAME_STR),
                                  tr("%1 Do you want to delete the custom file cache?").arg(message),
@@ -1616,7 +1627,7 @@ void Gui::clearCustomPartCache(bool silent)
   QString dirName = QDir::toNativeSeparators(QString("%1/%2").arg(Preferences::lpubDataPath).arg(Paths::customDir));
 
   int count = 0;
-  emit messageSig(LOG_INFO,QString("-Removing folder %1").arg(dirName));
+  emitMessage(LOG_INFO,QString("-Removing folder %1").arg(dirName));
   if (removeDir(count, dirName)){
       emit messageSig(LOG_INFO_STATUS,QString("Custom parts cache cleaned.  %1 %2 removed.")
                                               .arg(count)
@@ -1656,7 +1667,7 @@ void Gui::clearPLICache()
                             .arg(fileInfo.absoluteFilePath()));
         } else {
 #ifdef QT_DEBUG_MODE
-            emit messageSig(LOG_TRACE,QString("-File %1 removed").arg(fileInfo.absoluteFilePath()));
+            emitMessage(LOG_TRACE,QString("-File %1 removed").arg(fileInfo.absoluteFilePath()));
 #endif
             count++;
         }
@@ -1684,7 +1695,7 @@ void Gui::clearCSICache()
                             .arg(fileInfo.absoluteFilePath()));
         } else {
 #ifdef QT_DEBUG_MODE
-            emit messageSig(LOG_TRACE,QString("-File %1 removed").arg(fileInfo.absoluteFilePath()));
+            emitMessage(LOG_TRACE,QString("-File %1 removed").arg(fileInfo.absoluteFilePath()));
 #endif
             count++;
         }
@@ -1715,7 +1726,7 @@ void Gui::clearSubmodelCache(const QString &key)
                                 .arg(fileInfo.absoluteFilePath()));
             } else {
 #ifdef QT_DEBUG_MODE
-                emit messageSig(LOG_TRACE,QString("-File %1 removed").arg(fileInfo.absoluteFilePath()));
+                emitMessage(LOG_TRACE,QString("-File %1 removed").arg(fileInfo.absoluteFilePath()));
 #endif
                 count++;
                 if (deleteSpecificFile)
@@ -1747,13 +1758,14 @@ void Gui::clearTempCache()
                                               .arg(fileInfo.absoluteFilePath()));
           } else {
 #ifdef QT_DEBUG_MODE
-            emit messageSig(LOG_TRACE,QString("-File %1 removed").arg(fileInfo.absoluteFilePath()));
+            emitMessage(LOG_TRACE,QString("-File %1 removed").arg(fileInfo.absoluteFilePath()));
 #endif
             count1++;
         }
       }
 
     ldrawFile.tempCacheCleared();
+    Render::clearNativeSubModels();
 
     emit messageSig(LOG_INFO_STATUS,QString("Temporary model file cache cleaned. %1 items removed.").arg(count1));
 }
@@ -1774,7 +1786,7 @@ bool Gui::removeDir(int &count, const QString & dirName)
             if (fileInfo.isFile()){
                 if ((result = QFile::remove(fileInfo.absoluteFilePath()))) {
 #ifdef QT_DEBUG_MODE
-                    emit messageSig(LOG_TRACE,QString("-File %1 removed").arg(fileInfo.absoluteFilePath()));
+                    emitMessage(LOG_TRACE,QString("-File %1 removed").arg(fileInfo.absoluteFilePath()));
 #endif
                     count++;
                 }
@@ -1784,7 +1796,7 @@ bool Gui::removeDir(int &count, const QString & dirName)
             }
         }
         if ((result = dir.rmdir(dir.absolutePath())))
-            emit messageSig(LOG_TRACE,QString("-Folder %1 cleaned").arg(dir.absolutePath()));
+            emitMessage(LOG_TRACE,QString("-Folder %1 cleaned").arg(dir.absolutePath()));
     }
     return result;
 }
@@ -2288,17 +2300,17 @@ void Gui::preferences()
         bool ldSearchDirsChanged           = Preferences::ldSearchDirs                           != ldSearchDirsCompare;
 
         if (defaultUnitsChanged     )
-                    emit messageSig(LOG_INFO,QString("Default units changed to %1").arg(Preferences::preferCentimeters? "Centimetres" : "Inches"));
+                    emitMessage(LOG_INFO,QString("Default units changed to %1").arg(Preferences::preferCentimeters? "Centimetres" : "Inches"));
 
         if (ldrawPathChanged) {
-            emit messageSig(LOG_INFO,QString("LDraw Library path changed from %1 to %2")
-                            .arg(ldrawPathCompare)
-                            .arg(Preferences::ldrawLibPath));
+            emitMessage(LOG_INFO,QString("LDraw Library path changed from %1 to %2")
+                        .arg(ldrawPathCompare)
+                        .arg(Preferences::ldrawLibPath));
             if (Preferences::validLDrawLibrary != Preferences::validLDrawLibraryChange) {
                 libraryChangeRestart = true;
-                emit messageSig(LOG_INFO,QString("LDraw parts library changed from %1 to %2")
-                                .arg(Preferences::validLDrawLibrary)
-                                .arg(Preferences::validLDrawLibraryChange));
+                emitMessage(LOG_INFO,QString("LDraw parts library changed from %1 to %2")
+                            .arg(Preferences::validLDrawLibrary)
+                            .arg(Preferences::validLDrawLibraryChange));
                 box.setText (QString("%1 will restart to properly load the %2 parts library.")
                                      .arg(VER_PRODUCTNAME_STR).arg(Preferences::validLDrawLibraryChange));
                 box.exec();
@@ -2306,7 +2318,7 @@ void Gui::preferences()
         }
 
         if (ldrawFilesLoadMsgsChanged     )
-                    emit messageSig(LOG_INFO,QString("LdrawFiles Load message dialogue set to %1").arg(
+                    emitMessage(LOG_INFO,QString("LdrawFiles Load message dialogue set to %1").arg(
                         Preferences::ldrawFilesLoadMsgs == NEVER_SHOW ? "Never Show" :
                         Preferences::ldrawFilesLoadMsgs == SHOW_ERROR ? "Show Error" :
                         Preferences::ldrawFilesLoadMsgs == SHOW_WARNING ? "Show Warning" :
@@ -2314,48 +2326,48 @@ void Gui::preferences()
                         "Always Show"));
 
         if (ldSearchDirsChanged) {
-            emit messageSig(LOG_INFO,QString("LDraw search directories has changed"));
-            emit messageSig(LOG_INFO,QString("Previous Directories:"));
+            emitMessage(LOG_INFO,QString("LDraw search directories has changed"));
+            emitMessage(LOG_INFO,QString("Previous Directories:"));
             for(int i =0; i < ldSearchDirsCompare.size(); i++) {
-                emit messageSig(LOG_INFO,QString("    - %1. %2").arg(i).arg(QDir::toNativeSeparators(ldSearchDirsCompare.at(i))));
+                emitMessage(LOG_INFO,QString("    - %1. %2").arg(i).arg(QDir::toNativeSeparators(ldSearchDirsCompare.at(i))));
             }
-            emit messageSig(LOG_INFO,QString("Updated Directories:"));
+            emitMessage(LOG_INFO,QString("Updated Directories:"));
             for(int i =0; i < Preferences::ldSearchDirs.size(); i++) {
-                emit messageSig(LOG_INFO,QString("    - %1. %2").arg(i).arg(QDir::toNativeSeparators(Preferences::ldSearchDirs.at(i))));
+                emitMessage(LOG_INFO,QString("    - %1. %2").arg(i).arg(QDir::toNativeSeparators(Preferences::ldSearchDirs.at(i))));
             }
             gui->partWorkerLDSearchDirs.updateLDSearchDirs(true);
         }
 
         if (lgeoPathChanged && !ldrawPathChanged)
-            emit messageSig(LOG_INFO,QString("LGEO path preference changed from %1 to %2")
-                            .arg(lgeoPathCompare)
-                            .arg(Preferences::lgeoPath));
+            emitMessage(LOG_INFO,QString("LGEO path preference changed from %1 to %2")
+                        .arg(lgeoPathCompare)
+                        .arg(Preferences::lgeoPath));
 
         if (sceneBackgroundColorChanged)
-            emit messageSig(LOG_INFO,QString("Scene Background Color changed from %1 to %2")
-                            .arg(sceneBackgroundColorCompare)
-                            .arg(Preferences::sceneBackgroundColor));
+            emitMessage(LOG_INFO,QString("Scene Background Color changed from %1 to %2")
+                        .arg(sceneBackgroundColorCompare)
+                        .arg(Preferences::sceneBackgroundColor));
 
         if (sceneRulerTickColorChanged)
-            emit messageSig(LOG_INFO,QString("Scene Ruler Tick Color changed from %1 to %2")
-                            .arg(sceneRulerTickColorCompare)
-                            .arg(Preferences::sceneRulerTickColor));
+            emitMessage(LOG_INFO,QString("Scene Ruler Tick Color changed from %1 to %2")
+                        .arg(sceneRulerTickColorCompare)
+                        .arg(Preferences::sceneRulerTickColor));
 
         if (sceneGridColorChanged)
-            emit messageSig(LOG_INFO,QString("Scene Grid Color changed from %1 to %2")
-                            .arg(sceneGridColorCompare)
-                            .arg(Preferences::sceneGridColor));
+            emitMessage(LOG_INFO,QString("Scene Grid Color changed from %1 to %2")
+                        .arg(sceneGridColorCompare)
+                        .arg(Preferences::sceneGridColor));
 
         if (showDownloadRedirectsChanged)
-                    emit messageSig(LOG_INFO,QString("Show download redirects is %1").arg(Preferences::showDownloadRedirects? "ON" : "OFF"));
+                    emitMessage(LOG_INFO,QString("Show download redirects is %1").arg(Preferences::showDownloadRedirects? "ON" : "OFF"));
 
         if (sceneGuideColorChanged && !ldrawPathChanged)
-            emit messageSig(LOG_INFO,QString("Scene Guide Color changed from %1 to %2")
-                            .arg(sceneGuideColorCompare)
-                            .arg(Preferences::sceneGuideColor));
+            emitMessage(LOG_INFO,QString("Scene Guide Color changed from %1 to %2")
+                        .arg(sceneGuideColorCompare)
+                        .arg(Preferences::sceneGuideColor));
 
         if (enableFadeStepsChanged) {
-            emit messageSig(LOG_INFO,QString("Fade Previous Steps is %1.").arg(Preferences::enableFadeSteps ? "ON" : "OFF"));
+            emitMessage(LOG_INFO,QString("Fade Previous Steps is %1.").arg(Preferences::enableFadeSteps ? "ON" : "OFF"));
             if (Preferences::enableFadeSteps && !ldrawColourParts.ldrawColorPartsIsLoaded()) {
                 QString result;
                 if (!LDrawColourParts::LDrawColorPartsLoad(result)){
@@ -2367,82 +2379,82 @@ void Gui::preferences()
         }
 
         if (fadeStepsUseColourChanged && Preferences::enableFadeSteps)
-            emit messageSig(LOG_INFO,QString("Use Global Fade Color is %1").arg(Preferences::fadeStepsUseColour ? "ON" : "OFF"));
+            emitMessage(LOG_INFO,QString("Use Global Fade Color is %1").arg(Preferences::fadeStepsUseColour ? "ON" : "OFF"));
 
         if (fadeStepsOpacityChanged && Preferences::enableFadeSteps)
-            emit messageSig(LOG_INFO,QString("Fade Step Transparency changed from %1 to %2 percent")
-                            .arg(fadeStepsOpacityCompare)
-                            .arg(Preferences::fadeStepsOpacity));
+            emitMessage(LOG_INFO,QString("Fade Step Transparency changed from %1 to %2 percent")
+                        .arg(fadeStepsOpacityCompare)
+                        .arg(Preferences::fadeStepsOpacity));
 
         if (fadeStepsColourChanged && Preferences::enableFadeSteps && Preferences::fadeStepsUseColour)
-            emit messageSig(LOG_INFO,QString("Fade Step Color preference changed from %1 to %2")
-                            .arg(fadeStepsColourCompare.replace("_"," "))
-                            .arg(QString(Preferences::validFadeStepsColour).replace("_"," ")));
+            emitMessage(LOG_INFO,QString("Fade Step Color preference changed from %1 to %2")
+                        .arg(fadeStepsColourCompare.replace("_"," "))
+                        .arg(QString(Preferences::validFadeStepsColour).replace("_"," ")));
 
         if (enableHighlightStepChanged)
-            emit messageSig(LOG_INFO,QString("Highlight Current Step is %1.").arg(Preferences::enableHighlightStep ? "ON" : "OFF"));
+            emitMessage(LOG_INFO,QString("Highlight Current Step is %1.").arg(Preferences::enableHighlightStep ? "ON" : "OFF"));
 
         if (highlightFirstStepChanged     )
-                    emit messageSig(LOG_INFO,QString("Highlight First Step is %1").arg(Preferences::highlightFirstStep ? "ON" : "OFF"));
+                    emitMessage(LOG_INFO,QString("Highlight First Step is %1").arg(Preferences::highlightFirstStep ? "ON" : "OFF"));
 
         if (loadLastOpenedFileChanged)
-                    emit messageSig(LOG_INFO,QString("Load Last Opened File is %1").arg(Preferences::loadLastOpenedFile ? "ON" : "OFF"));
+                    emitMessage(LOG_INFO,QString("Load Last Opened File is %1").arg(Preferences::loadLastOpenedFile ? "ON" : "OFF"));
 
         if (extendedSubfileSearchChanged     )
-                    emit messageSig(LOG_INFO,QString("Extended Subfile Search is %1").arg(Preferences::extendedSubfileSearch ? "ON" : "OFF"));
+                    emitMessage(LOG_INFO,QString("Extended Subfile Search is %1").arg(Preferences::extendedSubfileSearch ? "ON" : "OFF"));
 
         if (povrayRenderQualityChanged)
-                    emit messageSig(LOG_INFO,QString("Povray Render Quality changed from %1 to %2")
-                                    .arg(povrayRenderQualityCompare == 0 ? "High" :
-                                         povrayRenderQualityCompare == 1 ? "Medium" : "Low")
-                                    .arg(Preferences::povrayRenderQuality == 0 ? "High" :
-                                         Preferences::povrayRenderQuality == 1 ? "Medium" : "Low"));
+                    emitMessage(LOG_INFO,QString("Povray Render Quality changed from %1 to %2")
+                                .arg(povrayRenderQualityCompare == 0 ? "High" :
+                                     povrayRenderQualityCompare == 1 ? "Medium" : "Low")
+                                .arg(Preferences::povrayRenderQuality == 0 ? "High" :
+                                     Preferences::povrayRenderQuality == 1 ? "Medium" : "Low"));
         povrayRenderQualityChanged = (povrayRenderQualityChanged && Preferences::preferredRenderer == RENDERER_POVRAY);
 
         if (povrayAutoCropChanged)
-                    emit messageSig(LOG_INFO,QString("Povray AutoCrop is %1").arg(Preferences::povrayAutoCrop ? "ON" : "OFF"));
+                    emitMessage(LOG_INFO,QString("Povray AutoCrop is %1").arg(Preferences::povrayAutoCrop ? "ON" : "OFF"));
 
         if (highlightStepLineWidthChanged && Preferences::enableHighlightStep)
-            emit messageSig(LOG_INFO,QString("Highlight Step line width changed from %1 to %2")
-                            .arg(highlightStepLineWidthCompare)
-                            .arg(Preferences::highlightStepLineWidth));
+            emitMessage(LOG_INFO,QString("Highlight Step line width changed from %1 to %2")
+                        .arg(highlightStepLineWidthCompare)
+                        .arg(Preferences::highlightStepLineWidth));
 
         if (highlightStepColorChanged && Preferences::enableHighlightStep)
-            emit messageSig(LOG_INFO,QString("Highlight Step Color preference changed from %1 to %2")
-                            .arg(highlightStepColourCompare)
-                            .arg(Preferences::highlightStepColour));
+            emitMessage(LOG_INFO,QString("Highlight Step Color preference changed from %1 to %2")
+                        .arg(highlightStepColourCompare)
+                        .arg(Preferences::highlightStepColour));
 
         if (generateCoverPagesChanged)
-            emit messageSig(LOG_INFO,QString("Generate Cover Pages preference is %1").arg(Preferences::generateCoverPages ? "ON" : "OFF"));
+            emitMessage(LOG_INFO,QString("Generate Cover Pages preference is %1").arg(Preferences::generateCoverPages ? "ON" : "OFF"));
 
         if (perspectiveProjectionChanged) {
            lcSetProfileInt(LC_PROFILE_NATIVE_PROJECTION, Preferences::perspectiveProjection ? 0 : 1);
            gApplication->mPreferences.LoadDefaults();
-           emit messageSig(LOG_INFO,QString("Projection set to %1").arg(Preferences::perspectiveProjection ? "Perspective" : "Orthographic"));
+           emitMessage(LOG_INFO,QString("Projection set to %1").arg(Preferences::perspectiveProjection ? "Perspective" : "Orthographic"));
         }
 
         if (saveOnRedrawChanged     )
-                    emit messageSig(LOG_INFO,QString("Save On Redraw is %1").arg(Preferences::saveOnRedraw? "ON" : "OFF"));
+                    emitMessage(LOG_INFO,QString("Save On Redraw is %1").arg(Preferences::saveOnRedraw? "ON" : "OFF"));
 
         if (saveOnUpdateChanged     )
-                    emit messageSig(LOG_INFO,QString("Save On Update is %1").arg(Preferences::saveOnUpdate? "ON" : "OFF"));
+                    emitMessage(LOG_INFO,QString("Save On Update is %1").arg(Preferences::saveOnUpdate? "ON" : "OFF"));
 
         if (pageDisplayPauseChanged)
-            emit messageSig(LOG_INFO,QString("Continuous process page display pause changed from %1 to %2")
-                            .arg(highlightStepLineWidthCompare)
-                            .arg(Preferences::pageDisplayPause));
+            emitMessage(LOG_INFO,QString("Continuous process page display pause changed from %1 to %2")
+                        .arg(highlightStepLineWidthCompare)
+                        .arg(Preferences::pageDisplayPause));
 
         if (addLSynthSearchDirChanged)
-                    emit messageSig(LOG_INFO,QString("Add LSynth Search Directory is %1").arg(Preferences::addLSynthSearchDir? "ON" : "OFF"));
+                    emitMessage(LOG_INFO,QString("Add LSynth Search Directory is %1").arg(Preferences::addLSynthSearchDir? "ON" : "OFF"));
 
         if (archiveLSynthPartsChanged)
-                    emit messageSig(LOG_INFO,QString("Archive LSynth Parts is %1").arg(Preferences::archiveLSynthParts? "ON" : "OFF"));
+                    emitMessage(LOG_INFO,QString("Archive LSynth Parts is %1").arg(Preferences::archiveLSynthParts? "ON" : "OFF"));
 
         if ((addLSynthSearchDirChanged || archiveLSynthPartsChanged) && Preferences::archiveLSynthParts)
                 loadLDSearchDirParts();
 
         if (doNotShowPageProcessDlgChanged)
-            emit messageSig(LOG_INFO,QString("Show continuous page process options dialog is %1.").arg(Preferences::doNotShowPageProcessDlg ? "ON" : "OFF"));
+            emitMessage(LOG_INFO,QString("Show continuous page process options dialog is %1.").arg(Preferences::doNotShowPageProcessDlg ? "ON" : "OFF"));
 
         if ((((fadeStepsColourChanged && Preferences::fadeStepsUseColour) ||
               fadeStepsUseColourChanged || fadeStepsOpacityChanged) &&
@@ -2452,23 +2464,23 @@ void Gui::preferences()
             clearCustomPartCache(true);    // true = silent
 
         if (enableImageMattingChanged && Preferences::enableImageMatting)
-            emit messageSig(LOG_INFO,QString("Enable image matting is %1").arg(Preferences::enableImageMatting ? "ON" : "OFF"));
+            emitMessage(LOG_INFO,QString("Enable image matting is %1").arg(Preferences::enableImageMatting ? "ON" : "OFF"));
 
         if (applyCALocallyChanged)
-            emit messageSig(LOG_INFO,QString("Apply camera angles locally is %1").arg(Preferences::applyCALocally ? "ON" : "OFF"));
+            emitMessage(LOG_INFO,QString("Apply camera angles locally is %1").arg(Preferences::applyCALocally ? "ON" : "OFF"));
 
         if (enableLDViewSCallChanged)
-            emit messageSig(LOG_INFO,QString("Enable LDView Single Call is %1").arg(Preferences::enableLDViewSingleCall ? "ON" : "OFF"));
+            emitMessage(LOG_INFO,QString("Enable LDView Single Call is %1").arg(Preferences::enableLDViewSingleCall ? "ON" : "OFF"));
 
         if (enableLDViewSListChanged)
-            emit messageSig(LOG_INFO,QString("Enable LDView Snapshots List is %1").arg(Preferences::enableLDViewSnaphsotList ? "ON" : "OFF"));
+            emitMessage(LOG_INFO,QString("Enable LDView Snapshots List is %1").arg(Preferences::enableLDViewSnaphsotList ? "ON" : "OFF"));
 
         if (rendererChanged) {
-            emit messageSig(LOG_INFO,QString("Renderer preference changed from %1 to %2")
-                            .arg(preferredRendererCompare)
-                            .arg(QString("%1%2").arg(Preferences::preferredRenderer)
-                                                .arg(Preferences::preferredRenderer == RENDERER_POVRAY ? QString("(POV file generator is %1)").arg(Preferences::povFileGenerator) :
-                                                     Preferences::preferredRenderer == RENDERER_LDVIEW ? Preferences::enableLDViewSingleCall ? "(Single Call)" : "" : "")));
+            emitMessage(LOG_INFO,QString("Renderer preference changed from %1 to %2")
+                        .arg(preferredRendererCompare)
+                        .arg(QString("%1%2").arg(Preferences::preferredRenderer)
+                                            .arg(Preferences::preferredRenderer == RENDERER_POVRAY ? QString("(POV file generator is %1)").arg(Preferences::povFileGenerator) :
+                                                 Preferences::preferredRenderer == RENDERER_LDVIEW ? Preferences::enableLDViewSingleCall ? "(Single Call)" : "" : "")));
 
             Render::setRenderer(Preferences::preferredRenderer);
             if (Preferences::preferredRenderer == RENDERER_LDGLITE)
@@ -2476,12 +2488,12 @@ void Gui::preferences()
         }
 
         if (povFileGeneratorChanged)
-            emit messageSig(LOG_INFO,QString("POV file generation renderer changed from %1 to %2")
-                            .arg(povFileGeneratorCompare)
-                            .arg(Preferences::povFileGenerator));
+            emitMessage(LOG_INFO,QString("POV file generation renderer changed from %1 to %2")
+                        .arg(povFileGeneratorCompare)
+                        .arg(Preferences::povFileGenerator));
 
         if (altLDConfigPathChanged) {
-            emit messageSig(LOG_INFO,QString("Use Alternate LDConfig (Restart Required) %1.").arg(Preferences::altLDConfigPath));
+            emitMessage(LOG_INFO,QString("Use Alternate LDConfig (Restart Required) %1.").arg(Preferences::altLDConfigPath));
             box.setText (QString("%1 will restart to properly load the alternate LDConfig file.").arg(VER_PRODUCTNAME_STR));
             box.exec();
         }
@@ -2572,6 +2584,8 @@ void Gui::preferences()
             logger.setLoggingLevel(OffLevel);
         }
 
+        setMessageLogging();
+
         if (displayThemeRestart || altLDConfigPathChanged || libraryChangeRestart) {
             restartApplication(libraryChangeRestart);
         }
@@ -2669,6 +2683,12 @@ Gui::Gui()
     undoStack = new QUndoStack();
     macroNesting = 0;
 
+    displayPageTimer = new QTimer(this);
+    displayPageTimer->setSingleShot(true);
+    displayPageTimer->setInterval(DISPLAY_PAGE_DELAY);
+    connect(displayPageTimer, SIGNAL(timeout()),
+            this,             SLOT(deferredDisplayPage()));
+
     lpubAlert = new LPubAlert();
 
     connect(lpubAlert,      SIGNAL(messageSig(LogType,QString)),
@@ -2922,7 +2942,7 @@ void Gui::ldrawColorPartsLoad()
         if (!LDrawColourParts::LDrawColorPartsLoad(result)){
             QString message = QString("Could not open the %1 LDraw color parts file [%2], Error: %3")
                     .arg(Preferences::validLDrawLibrary).arg(Preferences::ldrawColourPartsFile).arg(result);
-            emit messageSig(LOG_NOTICE, message);
+            emitMessage(LOG_NOTICE, message);
             bool prompt = false;
             if (Preferences::modeGUI) {
                 QPixmap _icon = QPixmap(":/icons/lpub96.png");
@@ -2985,7 +3005,7 @@ void Gui::generateCustomColourPartsList(bool prompt)
     }
 
     if (ret == QMessageBox::Yes || ! prompt || !Preferences::lpub3dLoaded) {
-        emit messageSig(LOG_INFO,message);
+        emitMessage(LOG_INFO,message);
 
         QThread *listThread   = new QThread();
         colourPartListWorker  = new ColourPartListWorker();
@@ -3244,7 +3264,7 @@ void Gui::refreshLDrawUnoffParts() {
                      .arg(m_workerJobResult)
                      .arg(items.count())
                      .arg(destination);
-        emit messageSig(LOG_INFO,message);
+        emitMessage(LOG_INFO,message);
     } else {
         message = tr("Failed to extract %1 library files")
                      .arg(QFileInfo(newarchive).fileName());
@@ -3297,7 +3317,7 @@ void Gui::refreshLDrawUnoffParts() {
                      .arg(m_workerJobResult)
                      .arg(partsLabel)
                      .arg(QFileInfo(newarchive).fileName());
-        emit messageSig(LOG_INFO,message);
+        emitMessage(LOG_INFO,message);
 
         if (m_workerJobResult) {
             QSettings Settings;
@@ -3408,7 +3428,7 @@ void Gui::refreshLDrawOfficialParts() {
                      .arg(m_workerJobResult)
                      .arg(items.count())
                      .arg(destination);
-        emit messageSig(LOG_INFO,message);
+        emitMessage(LOG_INFO,message);
     } else {
         message = tr("Failed to extract %1 library files")
                      .arg(QFileInfo(newarchive).fileName());
@@ -3580,6 +3600,11 @@ void Gui::createActions()
     exportObjAct->setEnabled(false);
     connect(exportObjAct, SIGNAL(triggered()), this, SLOT(exportAsObjDialog()));
 
+    exportGltfAct = new QAction(tr("Export As &glTF Binary Objects"), this);
+    exportGltfAct->setStatusTip(tr("Export your document as a sequence of instanced glTF binary (GLB) objects"));
+    exportGltfAct->setEnabled(false);
+    connect(exportGltfAct, SIGNAL(triggered()), this, SLOT(exportAsGltfDialog()));
+
     export3dsAct = new QAction(QIcon(":/resources/3ds32.png"),tr("Export As &3DStudio Objects"), this);
     export3dsAct->setShortcut(tr("Alt+5"));
     export3dsAct->setStatusTip(tr("Export your document as a sequence of 3DStudio objects - Alt+5"));
@@ -4302,6 +4327,7 @@ void Gui::enableActions()
   exportStlAct->setEnabled(true);
   export3dsAct->setEnabled(true);
   exportObjAct->setEnabled(true);
+  exportGltfAct->setEnabled(true);
   exportColladaAct->setEnabled(true);
   exportHtmlAct->setEnabled(true);
 
@@ -4390,6 +4416,7 @@ void Gui::disableActions()
   exportStlAct->setEnabled(false);
   export3dsAct->setEnabled(false);
   exportObjAct->setEnabled(false);
+  exportGltfAct->setEnabled(false);
   exportColladaAct->setEnabled(false);
   exportHtmlAct->setEnabled(false);
 
@@ -4486,6 +4513,7 @@ void Gui::createMenus()
     exportMenu->addAction(exportStlAct);
     exportMenu->addAction(exportPovAct);
     exportMenu->addAction(exportColladaAct);
+    exportMenu->addAction(exportGltfAct);
     exportMenu->addAction(export3dsAct);
     exportMenu->addSeparator();
     exportMenu->addAction(exportHtmlAct);
@@ -5130,6 +5158,83 @@ void Gui::writeSettings()
     gApplication->SaveTabLayout();
 }
 
+bool Gui::messageEnabled(LogType logType) {
+    if (!Preferences::logging)
+        return false;
+
+    const bool stdOut = !(Preferences::modeGUI && Preferences::lpub3dLoaded) &&
+                        !Preferences::suppressStdOutToLog;
+
+    QsLogging::Logger& logger = QsLogging::Logger::instance();
+    switch (logType) {
+    case LOG_STATUS:
+    case LOG_INFO_STATUS:
+    case LOG_ERROR:
+        return true;
+    case LOG_INFO:
+        return stdOut || logger.messageLevel(QsLogging::InfoLevel);
+    case LOG_NOTICE:
+        return stdOut || logger.messageLevel(QsLogging::NoticeLevel);
+    case LOG_TRACE:
+        return stdOut || logger.messageLevel(QsLogging::TraceLevel);
+    case LOG_DEBUG:
+#ifdef QT_DEBUG_MODE
+        return stdOut || logger.messageLevel(QsLogging::DebugLevel);
+#else
+        return false;
+#endif
+    default:
+        return false;
+    }
+}
+
+void Gui::setMessageLogging() {
+    using namespace QsLogging;
+    Logger& logger = Logger::instance();
+    if (Preferences::logging) {
+        bool ok;
+        Level logLevel = logger.fromLevelString(Preferences::loggingLevel,&ok);
+        if (!ok)
+        {
+            QString Message = QString("Failed to set log level %1.\n"
+                                              "Logging is off - level set to OffLevel")
+                    .arg(Preferences::loggingLevel);
+            fprintf(stderr, "%s", Message.toLatin1().constData());
+        }
+        logger.setMessageLevel(logLevel);
+        logger.setMessageIncludeLogLevel(Preferences::includeLogLevel);
+    } else {
+        logger.setMessageLevel(OffLevel);
+    }
+}
+
+/*
+ * Console messages are collected and written to stdout when a page is
+ * drawn, a status or error is reported, or the oldest buffered message
+ * is more than STDOUT_FLUSH_INTERVAL ms old, instead of being flushed
+ * line by line.
+ */
+#define STDOUT_FLUSH_INTERVAL 250
+
+static QByteArray stdOutBuffer;
+static QElapsedTimer stdOutTimer;
+
+static void bufferStdOut(const QString &message, bool flush = false) {
+    if (stdOutBuffer.isEmpty())
+        stdOutTimer.start();
+    stdOutBuffer.append(message.toLatin1()).append('\n');
+    if (flush || stdOutBuffer.size() > 64 * 1024 || stdOutTimer.elapsed() > STDOUT_FLUSH_INTERVAL)
+        Gui::flushStdOut();
+}
+
+void Gui::flushStdOut() {
+    if (stdOutBuffer.isEmpty())
+        return;
+    fwrite(stdOutBuffer.constData(), 1, size_t(stdOutBuffer.size()), stdout);
+    fflush(stdout);
+    stdOutBuffer.clear();
+}
+
 void Gui::statusMessage(LogType logType, QString message) {
     /* logTypes
      * LOG_STATUS:   - same as INFO but writes to log file also
@@ -5143,81 +5248,56 @@ void Gui::statusMessage(LogType logType, QString message) {
      * LOG_QDEBUG:   - visible in Qt debug mode
      */
 
-    // Set StatusMessage Logging options
+    // The logger is configured once by setMessageLogging(); logMessage()
+    // uses the message level and options set there.
     using namespace QsLogging;
-    Logger& logger = Logger::instance();
     if (Preferences::logging) {
 
-        // Set logging Level
-        bool ok;
-        Level logLevel = logger.fromLevelString(Preferences::loggingLevel,&ok);
-        if (!ok)
-        {
-            QString Message = QString("Failed to set log level %1.\n"
-                                              "Logging is off - level set to OffLevel")
-                    .arg(Preferences::loggingLevel);
-            fprintf(stderr, "%s", Message.toLatin1().constData());
-        }
-        logger.setLoggingLevel(logLevel);
-
-        logger.setIncludeLogLevel(Preferences::includeLogLevel);
-        logger.setIncludeTimestamp(Preferences::includeTimestamp);
-        logger.setIncludeLineNumber(false);
-        logger.setIncludeTimestamp(true);
-        logger.setIncludeFileName(false);
-        logger.setColorizeFunctionInfo(false);
-        logger.setIncludeFunctionInfo(false);
-
         bool guiEnabled = (Preferences::modeGUI && Preferences::lpub3dLoaded);
         if (logType == LOG_STATUS ){
 
-            logStatus() << message;
+            logMessage(StatusLevel) << message;
 
             if (guiEnabled) {
                 statusBarMsg(message);
             } else {
-                fprintf(stdout,"%s",QString(message).append("\n").toLatin1().constData());
-                fflush(stdout);
+                bufferStdOut(message, true);
             }
         } else
             if (logType == LOG_INFO) {
 
-                logInfo() << message;
+                logMessage(InfoLevel) << message;
 
                 if (!guiEnabled && !Preferences::suppressStdOutToLog) {
-                    fprintf(stdout,"%s",QString(message).append("\n").toLatin1().constData());
-                    fflush(stdout);
+                    bufferStdOut(message);
                 }
 
             } else
               if (logType == LOG_NOTICE) {
 
-                  logNotice() << message;
+                  logMessage(NoticeLevel) << message;
 
                   if (!guiEnabled && !Preferences::suppressStdOutToLog) {
-                      fprintf(stdout,"%s",QString(message).append("\n").toLatin1().constData());
-                      fflush(stdout);
+                      bufferStdOut(message);
                   }
 
             } else
               if (logType == LOG_TRACE) {
 
-                  logTrace() << message;
+                  logMessage(TraceLevel) << message;
 
                   if (!guiEnabled && !Preferences::suppressStdOutToLog) {
-                      fprintf(stdout,"%s",QString(message).append("\n").toLatin1().constData());
-                      fflush(stdout);
+                      bufferStdOut(message);
                   }
 
             } else
               if (logType == LOG_DEBUG) {
 #ifdef QT_DEBUG_MODE
-                  logDebug() << message;
+                  logMessage(DebugLevel) << message;
 
 
                   if (!guiEnabled && !Preferences::suppressStdOutToLog) {
-                      fprintf(stdout,"%s",QString(message).append("\n").toLatin1().constData());
-                      fflush(stdout);
+                      bufferStdOut(message);
                   }
 #endif
                 } else
@@ -5225,16 +5305,15 @@ void Gui::statusMessage(LogType logType, QString message) {
 
                   statusBarMsg(message);
 
-                  logInfo() << message;
+                  logMessage(InfoLevel) << message;
 
                   if (!guiEnabled && !Preferences::suppressStdOutToLog) {
-                      fprintf(stdout,"%s",QString(message).append("\n").toLatin1().constData());
-                      fflush(stdout);
+                      bufferStdOut(message);
                   }
             } else
               if (logType == LOG_ERROR) {
 
-                  logError() << message;
+                  logMessage(ErrorLevel) << message;
 
                   if (guiEnabled) {
                       if (ContinuousPage()) {
@@ -5243,31 +5322,9 @@ void Gui::statusMessage(LogType logType, QString message) {
                           QMessageBox::warning(this,tr(VER_PRODUCTNAME_STR),tr(message.toLatin1()));
                       }
                   } else if (!Preferences::suppressStdOutToLog) {
-                      fprintf(stdout,"%s",QString(message).append("\n").toLatin1().constData());
-                      fflush(stdout);
+                      bufferStdOut(message, true);
                   }
             }
-
-        // Reset Logging to default settings
-        if (Preferences::logLevels){
-
-            logger.setLoggingLevels();
-            logger.setDebugLevel(Preferences::debugLevel);
-            logger.setTraceLevel(Preferences::traceLevel);
-            logger.setNoticeLevel(Preferences::noticeLevel);
-            logger.setInfoLevel(Preferences::infoLevel);
-            logger.setStatusLevel(Preferences::statusLevel);
-            logger.setErrorLevel(Preferences::errorLevel);
-            logger.setFatalLevel(Preferences::fatalLevel);
-        }
-
-        logger.setIncludeLineNumber(Preferences::includeLineNumber);
-        logger.setIncludeFileName(Preferences::includeFileName);
-        logger.setIncludeFunctionInfo(Preferences::includeFunction);
-        logger.setColorizeFunctionInfo(true);
-
-    } else {
-        logger.setLoggingLevel(OffLevel);
     }
 }
 
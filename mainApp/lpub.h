@@ -343,6 +343,7 @@
 #include <QFile>
 #include <QProgressBar>
 #include <QElapsedTimer>
+#include <QTimer>
 #include <QPdfWriter>
 
 #include "lgraphicsview.h"
@@ -376,6 +377,11 @@
 #define DEF_SIZE 0
 #endif
 
+// Milliseconds to wait for further edits before re-layout of the page
+#ifndef DISPLAY_PAGE_DELAY
+#define DISPLAY_PAGE_DELAY 150
+#endif
+
 class QString;
 class QSplitter;
 class QFrame;
@@ -439,6 +445,8 @@ class Render;
 class Steps;
 class Where;
 
+struct BOMSubModelParts;
+
 enum traverseRc { HitEndOfPage = 1 };
 enum Dimensions {Pixels = 0, Inches };
 enum PAction { SET_DEFAULT_ACTION, SET_STOP_ACTION };
@@ -459,7 +467,8 @@ enum ExportMode { EXPORT_NONE  = -1,//-1
                   EXPORT_CSV,       // 11
                   EXPORT_ELEMENT,   // 12
                   EXPORT_HTML,      // 13
-                  POVRAY_RENDER};   // 14
+                  POVRAY_RENDER,    // 14
+                  EXPORT_GLTF};     // 15
 
 const QString nativeExportNames[] =
 {
@@ -477,7 +486,8 @@ const QString nativeExportNames[] =
   "CSV",           // EXPORT_CSV
   "ELEMENT",       // EXPORT_ELEMENT
   "HTML",          // EXPORT_HTML
-  "POV-RAY RENDER" // RENDER_POVRAY
+  "POV-RAY RENDER", // RENDER_POVRAY
+  "GLTF"            // EXPORT_GLTF
 };
 
 class Gui : public QMainWindow
@@ -537,6 +547,7 @@ public:
     displayPageNum += offset;
   }
   void  displayPage();
+  void  requestDisplayPage();
 
   bool continuousPageDialog(Direction d);
 
@@ -1083,6 +1094,14 @@ public:
   Preferences            lpub3dPreferences;           // lpub3D Preferences
   LDrawColourParts       ldrawColourParts;            // load the LDraw color parts list
 
+  // true if statusMessage would use a message of this type, so callers on
+  // hot paths can skip formatting messages that would be dropped
+  static bool messageEnabled(LogType logType);
+  // configure the logger for statusMessage from the logging preferences
+  static void setMessageLogging();
+  // write console messages collected by statusMessage to stdout
+  static void flushStdOut();
+
 protected:
   // capture camera rotation from 3DViewer module
   lcVector3              mStepRotation;
@@ -1147,6 +1166,7 @@ private:
 
   QUndoStack     *undoStack;                 // the undo/redo stack
   int             macroNesting;
+  QTimer         *displayPageTimer;          // coalesce re-layout after edits
   bool            previousPageContinuousIsRunning;// stop the continuous previous page action
   bool            nextPageContinuousIsRunning;    // stop the continuous next page action
 
@@ -1239,6 +1259,14 @@ private:
     QStringList             &csiParts,
     QList<PliPartGroupMeta> &bomPartGroups);
 
+  int getBOMParts(
+    Where                    current,
+    QString                 &addLine,
+    QStringList             &csiParts,
+    QList<PliPartGroupMeta> &bomPartGroups,
+    QHash<QString, BOMSubModelParts> &subModelParts,
+    bool                    &cacheable);
+
   int getBOMOccurrence(
           Where  current);
 
@@ -1272,6 +1300,8 @@ private:
   void setSelectedItemZValue(SceneObjectDirection direction);
 
 private slots:
+    void deferredDisplayPage();
+
     void open();
     void save();
     void saveAs();
@@ -1367,6 +1397,7 @@ private slots:
     void exportAs3dsDialog();
     void exportAsColladaDialog();
     void exportAsObjDialog();
+    void exportAsGltfDialog();
 
     OrientationEnc getPageOrientation(bool nextPage = false);
     QPageLayout getPageLayout(bool nextPage = false);
@@ -1483,6 +1514,7 @@ private:
   QAction  *export3dsAct;
   QAction  *exportColladaAct;
   QAction  *exportObjAct;
+  QAction  *exportGltfAct;
   QAction  *exportCsvAct;
   QAction  *exportBricklinkAct;
   QAction  *exportHtmlAct;
@@ -1635,6 +1667,7 @@ private:
 
   friend class PartWorker;
   friend class DialogExportPages;
+  friend class Benchmark;
 };
 
 class GlobalFadeStep
@@ -1672,6 +1705,11 @@ public:
 };
 
 extern class Gui *gui;
+
+// Emit a message only if statusMessage would use it, so the message
+// text is not built for a message that is dropped
+#define emitMessage(logType, message) \
+    if (!Gui::messageEnabled(logType)) {} else emit gui->messageSig(logType, message)
 extern QHash<SceneObject, QString> soMap;
 
 inline Preferences& lpub3DGetPreferences()
@@ -174,8 +174,10 @@ bool    Preferences::usingNativeRenderer        = false;
 bool    Preferences::skipPartsArchive           = false;
 bool    Preferences::loadLastOpenedFile         = false;
 bool    Preferences::extendedSubfileSearch      = false;
+bool    Preferences::modelSnapshotCache         = true;
 
 bool    Preferences::pdfPageImage               = false;
+int     Preferences::pdfImageMaxResolution      = PDF_IMAGE_MAX_RESOLUTION_DEFAULT;  // measured in DPI
 bool    Preferences::ignoreMixedPageSizesMsg    = false;
 
 bool    Preferences::debugLevel                 = false;
@@ -249,6 +251,7 @@ int     Preferences::pageHeight                 = PAGE_HEIGHT_DEFAULT;
 int     Preferences::pageWidth                  = PAGE_WIDTH_DEFAULT;
 int     Preferences::rendererTimeout            = RENDERER_TIMEOUT_DEFAULT;          // measured in seconds
 int     Preferences::pageDisplayPause           = PAGE_DISPLAY_PAUSE_DEFAULT;        // measured in seconds
+int     Preferences::imageCacheSize             = IMAGE_CACHE_SIZE_DEFAULT;          // measured in MB
 int     Preferences::cameraDistFactorNative     = CAMERA_DISTANCE_FACTOR_NATIVE_DEFAULT;
 
 // Native POV file generation settings
@@ -2982,6 +2985,15 @@ void Preferences::userInterfacePreferences()
       extendedSubfileSearch = Settings.value(QString("%1/%2").arg(SETTINGS,povrayFileGeneratorKey)).toBool();
   }
 
+  QString const modelSnapshotCacheKey("ModelSnapshotCache");
+  if ( ! Settings.contains(QString("%1/%2").arg(SETTINGS,modelSnapshotCacheKey))) {
+      QVariant uValue(true);
+      modelSnapshotCache = true;
+      Settings.setValue(QString("%1/%2").arg(SETTINGS,modelSnapshotCacheKey),uValue);
+  } else {
+      modelSnapshotCache = Settings.value(QString("%1/%2").arg(SETTINGS,modelSnapshotCacheKey)).toBool();
+  }
+
   QString const ldrawFilesLoadMsgsKey("LdrawFilesLoadMsgs");
   if ( ! Settings.contains(QString("%1/%2").arg(SETTINGS,ldrawFilesLoadMsgsKey))) {
       ldrawFilesLoadMsgs = NEVER_SHOW;
@@ -3503,6 +3515,13 @@ void Preferences::exportPreferences()
     } else {
       pdfPageImage = Settings.value(QString("%1/%2").arg(DEFAULTS,"PdfPageImage")).toBool();
     }
+
+    if ( ! Settings.contains(QString("%1/%2").arg(DEFAULTS,"PdfImageMaxResolution"))) {
+      pdfImageMaxResolution = PDF_IMAGE_MAX_RESOLUTION_DEFAULT;
+      Settings.setValue(QString("%1/%2").arg(DEFAULTS,"PdfImageMaxResolution"),pdfImageMaxResolution);
+    } else {
+      pdfImageMaxResolution = Settings.value(QString("%1/%2").arg(DEFAULTS,"PdfImageMaxResolution")).toInt();
+    }
 }
 
 void Preferences::publishingPreferences()
@@ -3517,6 +3536,14 @@ void Preferences::publishingPreferences()
         pageDisplayPause = Settings.value(QString("%1/%2").arg(SETTINGS,"PageDisplayPause")).toInt();
     }
 
+    //Decoded Image Cache Size
+    if ( ! Settings.contains(QString("%1/%2").arg(SETTINGS,"ImageCacheSize"))) {
+        imageCacheSize = IMAGE_CACHE_SIZE_DEFAULT;
+        Settings.setValue(QString("%1/%2").arg(SETTINGS,"ImageCacheSize"),imageCacheSize);
+    } else {
+        imageCacheSize = Settings.value(QString("%1/%2").arg(SETTINGS,"ImageCacheSize")).toInt();
+    }
+
     if ( ! Settings.contains(QString("%1/%2").arg(DEFAULTS,"DoNotShowPageProcessDlg"))) {
         QVariant pValue(false);
         doNotShowPageProcessDlg = false;
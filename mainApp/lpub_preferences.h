@@ -213,6 +213,7 @@ class Preferences
     static bool    skipPartsArchive;
     static bool    loadLastOpenedFile;
     static bool    extendedSubfileSearch;
+    static bool    modelSnapshotCache;
 
     static bool    enableFadeSteps;
     static bool    fadeStepsUseColour;
@@ -232,6 +233,7 @@ class Preferences
     static bool    includeFunction;
 
     static bool    pdfPageImage;
+    static int     pdfImageMaxResolution;
     static bool    ignoreMixedPageSizesMsg;
 
     static bool    debugLevel;
@@ -282,6 +284,7 @@ class Preferences
     static int     pageHeight;
     static int     gridSizeIndex;
     static int     pageDisplayPause;
+    static int     imageCacheSize;
     static int     rendererTimeout;
     static int     sceneGuidesLine;
     static int     sceneGuidesPosition;
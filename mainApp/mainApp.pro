@@ -354,6 +354,7 @@ HEADERS += \
     archiveparts.h \
     backgrounddialog.h \
     backgrounditem.h \
+    benchmark.h \
     borderdialog.h \
     callout.h \
     calloutbackgrounditem.h \
@@ -374,6 +375,7 @@ HEADERS += \
     highlighter.h \
     historylineedit.h \
     hoverpoints.h \
+    imagecache.h \
     ldrawcolourparts.h \
     ldrawfiles.h \
     ldsearchdirs.h \
@@ -432,6 +434,7 @@ HEADERS += \
     submodelcolordialog.h \
     textitem.h \
     threadworkers.h \
+    tracer.h \
     updatecheck.h \
     version.h \
     where.h \
@@ -454,6 +457,7 @@ SOURCES += \
     assemglobals.cpp \
     backgrounddialog.cpp \
     backgrounditem.cpp \
+    benchmark.cpp \
     borderdialog.cpp \
     callout.cpp \
     calloutbackgrounditem.cpp \
@@ -478,6 +482,7 @@ SOURCES += \
     highlightstepglobals.cpp \
     historylineedit.cpp \
     hoverpoints.cpp \
+    imagecache.cpp \
     ldrawcolourparts.cpp \
     ldrawfiles.cpp \
     ldsearchdirs.cpp \
@@ -539,6 +544,7 @@ SOURCES += \
     submodelcolordialog.cpp \
     textitem.cpp \
     threadworkers.cpp \
+    tracer.cpp \
     traverse.cpp \
     undoredo.cpp \
     updatecheck.cpp \
@@ -595,6 +601,10 @@ DISTFILES += \
 # CONFIG+=update_check
 update_check: DEFINES += DISABLE_UPDATE_CHECK
 
+# set config to compile out page build pipeline tracing
+# CONFIG+=notrace
+notrace: DEFINES += LPUB_NO_TRACE
+
 # Suppress warnings
 !win32-msvc* {
 QMAKE_CFLAGS_WARN_ON += \
@@ -2601,8 +2601,7 @@ Rc InsertMeta::parse(QStringList &argv, int index, Where &here)
 
     } else if (argv[index] == "BOM") {
       insertData.type = InsertData::InsertBom;
-      insertData.where.modelName = here.modelName;
-      insertData.where.lineNumber = here.lineNumber;
+      insertData.where = here;
       ++index;
     }
 
@@ -3463,8 +3462,7 @@ Rc PliPartGroupMeta::parse(QStringList &argv, int index, Where &here)
     }
 
     if (rc == OkRc) {
-      gd.group.modelName  = here.modelName;
-      gd.group.lineNumber = here.lineNumber;
+      gd.group            = here;
       _value   = gd;
       _here[0] = here;
 
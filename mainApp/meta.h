@@ -1357,8 +1357,7 @@ public:
            _result.lineData.thickness    = argv[index+3].toFloat();
            _result.lineData.hideArrows   = argv[index+4].toInt();        // used to show/hide arrow tip
            _result.lineData.useDefault   = false;
-           _result.lineWhere.modelName   = here.modelName;
-           _result.lineWhere.lineNumber  = here.lineNumber;
+           _result.lineWhere             = here;
         } else
           if (argv[index] == "BORDER") {
            _result.attribType            = PointerAttribData::Border;
@@ -1367,8 +1366,7 @@ public:
            _result.borderData.color      = argv[index+2];
            _result.borderData.thickness  = argv[index+3].toFloat();
            _result.borderData.useDefault = false;
-           _result.borderWhere.modelName = here.modelName;
-           _result.borderWhere.lineNumber= here.lineNumber;
+           _result.borderWhere           = here;
         }
         bool noParent                    = argv[index-2] == "CALLOUT" || argv[index-1] == "DIVIDER_POINTER_ATTRIBUTE";
         _result.id                       = argv[isLine ? index+5 : index+4].toInt();
@@ -34,6 +34,7 @@
 #include <QPointF>
 #include <QGradient>
 #include "lpub_preferences.h"
+#include "where.h"
 
 enum AllocEnc {
   Horizontal = 0,
@@ -443,11 +444,7 @@ public:
     InsertRotateIcon,
   } type;
 
-  struct InsertWhere {
-    QString   modelName  = "undefined";
-    int       lineNumber = 0;
-  };
-  InsertWhere where;
+  Where       where;
   QString     picName;
   qreal       picScale;
   QString     text;
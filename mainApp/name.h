@@ -328,6 +328,8 @@ static const SceneObject NoContextSceneObjects[] =
 #define RENDERER_TIMEOUT_DEFAULT                6    // measured in seconds
 
 #define PAGE_DISPLAY_PAUSE_DEFAULT              3    // measured in seconds
+#define IMAGE_CACHE_SIZE_DEFAULT                256  // decoded image cache budget in MB, 0 disables
+#define PDF_IMAGE_MAX_RESOLUTION_DEFAULT        0    // pdf embedded image resolution cap in DPI, 0 disables
 
 // Internal common material colours
 #define LDRAW_EDGE_MATERIAL_COLOUR              "24"
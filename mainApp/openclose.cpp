@@ -309,6 +309,7 @@ void Gui::closeFile()
   setPageLineEdit->clear();
   pageSizes.clear();
   undoStack->clear();
+  Render::clearNativeSubModels();
   submodelIconsLoaded = gMainWindow->mSubmodelIconsLoaded = false;
   if (!curFile.isEmpty())
       emit messageSig(LOG_DEBUG, QString("File closed - %1.").arg(curFile));
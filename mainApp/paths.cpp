@@ -46,6 +46,7 @@ QString Paths::povrayRenderDir = "LPub3D/povray";
 QString Paths::logsDir         = "logs";
 QString Paths::extrasDir       = "extras";
 QString Paths::libraryDir      = "libraries";
+QString Paths::snapshotsDir    = "cache/snapshots";
 
 QString Paths::customDir       = QString();
 QString Paths::customPartDir   = QString();
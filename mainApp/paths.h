@@ -35,6 +35,7 @@ public:
     static QString logsDir;
     static QString extrasDir;
     static QString libraryDir;
+    static QString snapshotsDir;
     static QString customDir;
     static QString customPartDir;
     static QString customSubDir;
@@ -34,6 +34,7 @@
 #include <QFileInfo>
 #include <QFile>
 #include <QTextStream>
+#include <QtConcurrent>
 
 #include "pli.h"
 #include "step.h"
@@ -41,6 +42,7 @@
 #include "callout.h"
 #include "resolution.h"
 #include "render.h"
+#include "imagecache.h"
 #include "paths.h"
 #include "ldrawfiles.h"
 #include "placementdialog.h"
@@ -49,6 +51,7 @@
 #include "lpub.h"
 #include "commonmenus.h"
 #include "lpub_preferences.h"
+#include "tracer.h"
 #include "ranges_element.h"
 #include "range_element.h"
 
@@ -112,6 +115,7 @@ Pli::Pli(bool _bom) : bom(_bom)
   tallestPart = 1;
   background = nullptr;
   splitBom = false;
+  renderJobs = nullptr;
 
   ptn.append( { FADE_PART, FADE_SFX } );
   ptn.append( { HIGHLIGHT_PART, HIGHLIGHT_SFX } );
@@ -314,8 +318,7 @@ void Pli::setParts(
                       which = 1; // LEGO
 
                   if (pliMeta.partElements.localLegoElements.value()) {
-                      QString elementKey = QString("%1%2").arg(_typeid).arg(_colorid);
-                      element = Annotations::getLEGOElement(elementKey.toLower());
+                      element = Annotations::getLEGOElement(_typeid,_colorid);
                   }
                   else
                   {
@@ -415,8 +418,7 @@ void Pli::setParts(
                   _gd.bom              = bom;
                   _gd.type             = baseName;
                   _gd.color            = color;
-                  _gd.group.modelName  = where.modelName;
-                  _gd.group.lineNumber = where.lineNumber;
+                  _gd.group            = where;
                   _gd.offset[0]        = 0.0;
                   _gd.offset[1]        = 0.0;
                   Where undefined;
@@ -689,17 +691,13 @@ QString Pli::orient(QString &color, QString type)
 
           while ( ! in.atEnd()) {
               QString line = in.readLine(0);
-              QStringList tokens;
-
-              split(line,tokens);
+              LDrawTokens tokens(line);
 
               if (tokens.size() != 15) {
                   continue;
                 }
 
-              QString token14 = tokens[14].toLower();
-
-              if (tokens.size() == 15 && tokens[0] == "1" && token14 == type) {
+              if (tokens.size() == 15 && tokens[0] == "1" && tokens[14].compare(type, Qt::CaseInsensitive) == 0) {
                   cached = new QString(line);
                   orientation.insert(type,cached);
                   break;
@@ -710,9 +708,7 @@ QString Pli::orient(QString &color, QString type)
     }
 
   if (cached) {
-      QStringList tokens;
-
-      split(*cached, tokens);
+      LDrawTokens tokens(*cached);
 
       if (tokens.size() == 15 && tokens[0] == "1") {
           a = tokens[5].toFloat();
@@ -837,6 +833,7 @@ int Pli::createPartImage(
     QPixmap  *pixmap,
     int       subType)
 {
+    LPUB_TRACE_SPAN("Pli::createPartImage");
 
     int rc = 0;
     fadeSteps = Preferences::enableFadeSteps ;
@@ -864,7 +861,8 @@ int Pli::createPartImage(
         for (int i = 9; i < nameKeys.size(); i++)
             subRotation.append(nameKeys.at(i)+"_");
         subRotation.chop(1);
-        emit gui->messageSig(LOG_DEBUG, QString("Substitute type ROTSTEP meta: %1").arg(subRotation));
+        if (Gui::messageEnabled(LOG_DEBUG))
+            emit gui->messageSig(LOG_DEBUG, QString("Substitute type ROTSTEP meta: %1").arg(subRotation));
     }
 
     PliType pliType = isSubModel ? SUBMODEL: bom ? BOM : PART;
@@ -885,7 +883,8 @@ int Pli::createPartImage(
         ia.baseName[pT] = QFileInfo(type).completeBaseName();
         ia.partColor[pT] = (pT == FADE_PART && fadeSteps && Preferences::fadeStepsUseColour) ? fadeColour : color;
 
-        emit gui->messageSig(LOG_INFO, QString("Render PLI image for [%1] parts...").arg(PartTypeNames[pT]));
+        if (Gui::messageEnabled(LOG_INFO))
+            emit gui->messageSig(LOG_INFO, QString("Render PLI image for [%1] parts...").arg(PartTypeNames[pT]));
 
         // assemble image name using nameKey - create unique file when a value that impacts the image changes
         QString imageDir = isSubModel ? Paths::submodelDir : Paths::partsDir;
@@ -896,6 +895,19 @@ int Pli::createPartImage(
 
         if ( ! part.exists()) {
 
+            // queued renders run concurrently so each needs its own DAT
+            if (renderJobs) {
+                bool queued = false;
+                for (const PliRenderJob &job : *renderJobs) {
+                    if ((queued = job.imageName == imageName))
+                        break;
+                }
+                if (queued)
+                    continue;
+                ldrNames = QStringList() << QDir::toNativeSeparators(QDir::currentPath() + QDir::separator() + Paths::tmpDir + QDir::separator() +
+                                                                     QString("pli_%1.ldr").arg(renderJobs->size()));
+            }
+
             showElapsedTime = true;
 
             // create a temporary DAT to feed the renderer
@@ -952,6 +964,13 @@ int Pli::createPartImage(
                 out << line << endl;
             part.close();
 
+            // defer to renderPartImages
+            if (renderJobs) {
+                renderJobs->append({ ldrNames, imageName, meta, pliType, keySub,
+                                     QSize(Gui::pageSize(meta->LPub.page, 0), Gui::pageSize(meta->LPub.page, 1)), 0 });
+                continue;
+            }
+
             // feed DAT to renderer
             if ((renderer->renderPli(ldrNames,imageName,*meta,pliType,keySub) != 0)) {
                 emit gui->messageSig(LOG_ERROR,QString("%1 PLI [%2] render failed for<br>[%3]")
@@ -960,6 +979,8 @@ int Pli::createPartImage(
                                                        .arg(imageName));
                 imageName = QString(":/resources/missingimage.png");
                 ptRc = -1;
+            } else {
+                ImageCache::remove(imageName);
             }
         }
 
@@ -982,7 +1003,7 @@ int Pli::createPartImage(
         emit gui->setPliIconPathSig(imageKey,imageName);
 
         if (pixmap && (pT == NORMAL_PART))
-            pixmap->load(imageName);
+            ImageCache::load(imageName, *pixmap);
 
         if (showElapsedTime) {
             if (!ptRc) {
@@ -1001,8 +1022,74 @@ int Pli::createPartImage(
   return rc;
 }
 
+static void renderPliJob(Pli::PliRenderJob &job)
+{
+    Render::setJobPageSize(job.pageSize);
+    job.rc = renderer->renderPli(job.ldrNames,job.imageName,*job.meta,job.pliType,job.keySub);
+    Render::setJobPageSize(QSize());
+}
+
+/*
+ * Render the queued part images on the global thread pool. LDView,
+ * LDGLite and POV-Ray run as separate processes; each job has its own
+ * DAT, image and log files and carries the page size computed here, so
+ * the jobs are independent. The Native renderer shares the application's
+ * GL context and project, so it renders on this thread and only the image
+ * encoding is queued to the thread pool. POV-Ray with the Native POV file
+ * generator creates an LDVWidget and changes the working directory for
+ * each image, so those jobs also run one after another on this thread.
+ */
+int Pli::renderPartImages(QList<PliRenderJob> &jobs)
+{
+    LPUB_TRACE_SPAN("Pli::renderPartImages");
+
+    int rc = 0;
+
+    if (jobs.isEmpty())
+        return rc;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    if (Preferences::usingNativeRenderer) {
+        Render::beginNativeImageQueue();
+        for (PliRenderJob &job : jobs)
+            renderPliJob(job);
+        const QStringList failedImages = Render::endNativeImageQueue();
+        for (PliRenderJob &job : jobs)
+            if (!job.rc && failedImages.contains(job.imageName))
+                job.rc = -1;
+    } else if (jobs.size() == 1 ||
+               (Preferences::preferredRenderer == RENDERER_POVRAY &&
+                Preferences::povFileGenerator == RENDERER_NATIVE)) {
+        for (PliRenderJob &job : jobs)
+            renderPliJob(job);
+    } else {
+        QtConcurrent::blockingMap(jobs, renderPliJob);
+    }
+
+    for (const PliRenderJob &job : jobs) {
+        if (job.rc) {
+            emit gui->messageSig(LOG_ERROR,QString("%1 PLI render failed for<br>[%2]")
+                                                   .arg(Render::getRenderer())
+                                                   .arg(job.imageName));
+            rc = job.rc;
+        } else {
+            ImageCache::remove(job.imageName);
+        }
+    }
+
+    emit gui->messageSig(LOG_INFO,QString("%1 PLI render took %2 milliseconds "
+                                          "to render %3 images.")
+                                          .arg(Render::getRenderer())
+                                          .arg(timer.elapsed())
+                                          .arg(jobs.size()));
+    return rc;
+}
+
 // LDView performance improvement
 int Pli::createPartImagesLDViewSCall(QStringList &ldrNames, bool isNormalPart, int sub) {
+    LPUB_TRACE_SPAN("Pli::createPartImagesLDViewSCall");
     int rc = 0;
 
     emit gui->messageSig(LOG_INFO, "Render PLI images using LDView Single Call...");
@@ -1024,28 +1111,21 @@ int Pli::createPartImagesLDViewSCall(QStringList &ldrNames, bool isNormalPart, i
             PliPart *part;
             // get part info
             part = parts[key];
-            // load image files into pixmap
-            // instantiate pixmps //ERROR
-            QPixmap *pixmap = new QPixmap();
-            if (pixmap == nullptr) {
-                rc = -1;
-                continue;
-            }
-
-            if (! pixmap->load(part->imageName)) {
+            // load decoded image from the image cache
+            QImage image = ImageCache::image(part->imageName);
+            if (image.isNull()) {
                 emit gui->messageSig(LOG_ERROR,QMessageBox::tr("Could not load PLI pixmap image.<br>%1 was not found.")
                                      .arg(part->imageName));
                 rc = -1;
-                if (! pixmap->load(QString(":/resources/missingimage.png")))
+                image = ImageCache::image(QString(":/resources/missingimage.png"));
+                if (image.isNull())
                     continue;
             }
 
             // transfer image info to part
-            QImage image = pixmap->toImage();
+            QPixmap pixmap = QPixmap::fromImage(image);
 
-            part->pixmap = new PGraphicsPixmapItem(this,part,*pixmap,parentRelativeType,part->type, part->color);
-
-            delete pixmap;
+            part->pixmap = new PGraphicsPixmapItem(this,part,pixmap,parentRelativeType,part->type, part->color);
 
             // size the PLI
             part->pixmapWidth  = image.width();
@@ -1902,6 +1982,29 @@ int Pli::partSize()
       widestPart = 0;
       tallestPart = 0;
 
+      // 1. queue every missing part image (normal, fade and highlight) and render them together
+      QList<PliRenderJob> jobs;
+      renderJobs = &jobs;
+      foreach(key,parts.keys()) {
+          PliPart *part = parts[key];
+          QFileInfo info(part->type);
+          PieceInfo* pieceInfo = lcGetPiecesLibrary()->FindPiece(info.fileName().toUpper().toLatin1().constData(), nullptr, false, false);
+
+          if (pieceInfo ||
+              gui->isUnofficialPart(part->type) ||
+              gui->isSubmodel(part->type)) {
+
+              if (part->color == "16") {
+                  part->color = "0";
+                }
+
+              createPartImage(part->nameKey,part->type,part->color,nullptr,part->subType);
+            }
+        }
+      renderJobs = nullptr;
+      renderPartImages(jobs);
+
+      // 2. lay out the parts from the finished images
       foreach(key,parts.keys()) {
           PliPart *part;
 
@@ -2170,10 +2273,12 @@ int Pli::partSizeLDViewSCall() {
                 for (int i = 9; i < nameKeys.size(); i++)
                     subRotation.append(nameKeys.at(i)+"_");
                 subRotation.chop(1);
-                emit gui->messageSig(LOG_TRACE, QString("Substitute type ROTSTEP meta: %1").arg(subRotation));
+                if (Gui::messageEnabled(LOG_TRACE))
+                    emit gui->messageSig(LOG_TRACE, QString("Substitute type ROTSTEP meta: %1").arg(subRotation));
             }
 
-            emit gui->messageSig(LOG_INFO, QString("Processing PLI part for nameKey [%1]").arg(nameKey));
+            if (Gui::messageEnabled(LOG_INFO))
+                emit gui->messageSig(LOG_INFO, QString("Processing PLI part for nameKey [%1]").arg(nameKey));
 
             for (int pT = 0; pT < ptn.size(); pT++ ) {
 
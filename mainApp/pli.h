@@ -165,6 +165,8 @@ class Pli : public Placement {
 
     int pageSizeP(Meta *, int which);
 
+    friend class Benchmark;
+
   public:
     PlacementType      parentRelativeType;
     bool               perStep;
@@ -209,6 +211,20 @@ class Pli : public Placement {
     QString imageName;
     QStringList ldrNames;
 
+    struct PliRenderJob
+    {
+        QStringList ldrNames;
+        QString     imageName;
+        Meta       *meta;
+        int         pliType;
+        int         keySub;
+        QSize       pageSize; // computed on the GUI thread
+        int         rc;
+    };
+
+    // when set, createPartImage queues missing images here instead of rendering them
+    QList<PliRenderJob> *renderJobs;
+
     ~Pli()
     {
       clear();
@@ -259,6 +275,7 @@ class Pli : public Placement {
     void partClass(QString &, QString &);
     int  createPartImage(QString &, QString &, QString &, QPixmap*,int = 0);
     int  createPartImagesLDViewSCall(QStringList &, bool, int);      //LDView performance improvement
+    int  renderPartImages(QList<PliRenderJob> &);
     QString orient(QString &color, QString part);
     QStringList configurePLIPart(int, QString &, QStringList &, int);
     int createSubModelIcons();
@@ -24,7 +24,7 @@
 
 bool                    PliSubstituteParts::result;
 QString                 PliSubstituteParts::empty;
-QMap<QString, QString>  PliSubstituteParts::substituteParts;
+QHash<QString, QString> PliSubstituteParts::substituteParts;
 
 PliSubstituteParts::PliSubstituteParts()
 {
@@ -76,8 +76,9 @@ const bool &PliSubstituteParts::hasSubstitutePart(QString part)
 }
 
 const bool &PliSubstituteParts::getSubstitutePart(QString &part){
-    if (substituteParts.contains(part.toLower().toLower().trimmed())) {
-        part = substituteParts.value(part.toLower());
+    QHash<QString, QString>::const_iterator i = substituteParts.constFind(part.toLower().trimmed());
+    if (i != substituteParts.constEnd()) {
+        part = i.value();
 #ifdef QT_DEBUG_MODE
         logError() <<  QString("Substitute Part: ").arg(part);
 #endif
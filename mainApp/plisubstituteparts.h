@@ -15,7 +15,7 @@
 #ifndef PLISUBSTITUTEPARTS_H
 #define PLISUBSTITUTEPARTS_H
 
-#include <QMap>
+#include <QHash>
 #include <QString>
 #include <QStringList>
 class LPubMessages;
@@ -25,7 +25,7 @@ class PliSubstituteParts
   private:
     static bool     				result;
     static QString     				empty;
-    static QMap<QString, QString>               substituteParts;
+    static QHash<QString, QString>              substituteParts;
   public:
     PliSubstituteParts();
     static const bool &hasSubstitutePart(QString part);
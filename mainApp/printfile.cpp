@@ -29,6 +29,9 @@
 #include <QUrl>
 #include <QProcess>
 #include <QErrorMessage>
+#include <QElapsedTimer>
+#include <QGraphicsPixmapItem>
+#include <QtMath>
 #include <algorithm>
 
 #include "paths.h"
@@ -36,6 +39,7 @@
 #include "progress_dialog.h"
 #include "dialogexportpages.h"
 #include "messageboxresizable.h"
+#include "imagecache.h"
 
 #include <TCFoundation/TCUserDefaults.h>
 #include <LDLib/LDUserDefaultsKeys.h>
@@ -51,6 +55,21 @@ bool lessThan(const int &v1, const int &v2)
     return v1 < v2;
 }
 
+// Replace the pixmaps of the page about to be rendered to pdf with the
+// pixmaps shared by all pages of the document
+static void sharePdfPixmaps(QGraphicsScene *scene)
+{
+    foreach (QGraphicsItem *item, scene->items()) {
+        QGraphicsPixmapItem *pixmapItem = dynamic_cast<QGraphicsPixmapItem *>(item);
+        if (! pixmapItem)
+            continue;
+        qreal scale = qSqrt(qAbs(pixmapItem->sceneTransform().determinant()));
+        QPixmap pixmap = ImageCache::pdfPixmap(pixmapItem->pixmap(), scale);
+        if (pixmap.cacheKey() != pixmapItem->pixmap().cacheKey())
+            pixmapItem->setPixmap(pixmap);
+    }
+}
+
 QPageLayout Gui::getPageLayout(bool nextPage){
 
   int pageNum = displayPageNum;
@@ -422,6 +441,10 @@ void Gui::exportAsObjDialog(){
   exportAsDialog(EXPORT_WAVEFRONT);
 }
 
+void Gui::exportAsGltfDialog(){
+  exportAsDialog(EXPORT_GLTF);
+}
+
 bool Gui::exportAsDialog(ExportMode m)
 {
   exportMode = m;
@@ -508,6 +531,10 @@ bool Gui::exportAsDialog(ExportMode m)
         emit setExportingObjectsSig(true);
         exportAs(".obj");
       break;
+      case EXPORT_GLTF:
+        emit setExportingObjectsSig(true);
+        exportAs(".glb");
+      break;
       case EXPORT_POVRAY:
         setExportingObjectsSig(true);
         exportAs(".pov");
@@ -800,6 +827,11 @@ void Gui::exportAsPdf()
   // set export page elements or image
   bool exportPdfElements = !Preferences::pdfPageImage && dpr == 1.0;
 
+  // write images that recur across pages once and cap their resolution
+  QElapsedTimer exportTimer;
+  exportTimer.start();
+  ImageCache::beginPdfExport(resolution(), Preferences::pdfImageMaxResolution);
+
   QString messageIntro = exportPdfElements ? "Exporting page " : "Step 1. Creating image for page ";
 
   // instantiate the scene and view
@@ -871,6 +903,7 @@ void Gui::exportAsPdf()
                   m_progressDialog->hide();
               displayPageNum = savePageNumber;
               drawPage(KpageView,KpageScene,false);
+              ImageCache::endPdfExport();
               emit messageSig(LOG_STATUS,QString("Export to pdf terminated before completion."));
               return;
             }
@@ -925,6 +958,8 @@ void Gui::exportAsPdf()
 
           // render this page
           drawPage(&view,&scene,true);
+          if (exportPdfElements)
+              sharePdfPixmaps(&scene);
           scene.setSceneRect(0.0,0.0,adjPageWidthPx,adjPageHeightPx);
           scene.render(&painter);
           clearPage(&view,&scene);
@@ -984,6 +1019,7 @@ void Gui::exportAsPdf()
                       painter.end();
                   if (Preferences::modeGUI)
                       m_progressDialog->hide();
+                  ImageCache::endPdfExport();
                   emit messageSig(LOG_STATUS,QString("Export to pdf terminated before completion."));
                   return;
                 }
@@ -992,7 +1028,7 @@ void Gui::exportAsPdf()
               painter.drawPixmap(QRect(0,0,
                                        int(pdfWriter.logicalDpiX()*pages[page].pageWidthIn),
                                        int(pdfWriter.logicalDpiY()*pages[page].pageHeightIn)),
-                                       pages[page].pixmap);
+                                       ImageCache::pdfPageImage(pages[page].pixmap, pages[page].pageWidthIn));
 
               // prepare to render next page
               if(page < pages.count()) {
@@ -1055,6 +1091,7 @@ void Gui::exportAsPdf()
                   m_progressDialog->hide();
               displayPageNum = savePageNumber;
               drawPage(KpageView,KpageScene,false);
+              ImageCache::endPdfExport();
               emit messageSig(LOG_STATUS,QString("Export to pdf terminated before completion."));
               return;
             }
@@ -1114,6 +1151,8 @@ void Gui::exportAsPdf()
 
           // render this page
           drawPage(&view,&scene,true);
+          if (exportPdfElements)
+              sharePdfPixmaps(&scene);
           scene.setSceneRect(0.0,0.0,adjPageWidthPx,adjPageHeightPx);
           scene.render(&painter);
           clearPage(&view,&scene);
@@ -1173,6 +1212,7 @@ void Gui::exportAsPdf()
                   painter.end();
                   if (Preferences::modeGUI)
                       m_progressDialog->hide();
+                  ImageCache::endPdfExport();
                   emit messageSig(LOG_STATUS,QString("Export to pdf terminated before completion."));
                   return;
               }
@@ -1181,7 +1221,7 @@ void Gui::exportAsPdf()
               painter.drawPixmap(QRect(0,0,
                                  int(pdfWriter.logicalDpiX()*pages[page].pageWidthIn),
                                  int(pdfWriter.logicalDpiY()*pages[page].pageHeightIn)),
-                                 pages[page].pixmap);
+                                 ImageCache::pdfPageImage(pages[page].pixmap, pages[page].pageWidthIn));
 
               // prepare to render next page
               if(page < pages.count()) {
@@ -1198,6 +1238,16 @@ void Gui::exportAsPdf()
       }
   }
 
+  // report what the shared images saved
+  int pdfImages = 0, pdfSharedImages = 0;
+  ImageCache::endPdfExport(&pdfImages, &pdfSharedImages);
+  emit messageSig(LOG_INFO,QString("Exported %1 to pdf in %2 ms, size %3 KB, %4 images drawn, %5 shared with earlier pages.")
+                                   .arg(QDir::toNativeSeparators(fileName))
+                                   .arg(exportTimer.elapsed())
+                                   .arg(QFileInfo(fileName).size() / 1024)
+                                   .arg(pdfImages)
+                                   .arg(pdfSharedImages));
+
   // hide progress bar
   if (Preferences::modeGUI)
       m_progressDialog->hide();
@@ -1262,7 +1312,8 @@ void Gui::exportAs(const QString &_suffix)
   else
   if (suffix == ".stl" ||
       suffix == ".3ds" ||
-      suffix == ".obj") {
+      suffix == ".obj" ||
+      suffix == ".glb") {
       type  = "objects";
   }
   else {
@@ -1703,6 +1754,11 @@ void Gui::PrintPdf(QPrinter* Printer)
   // set initial page layout using first page as default
   Printer->setPageLayout(getPageLayout());
 
+  // a pdf file gets the same shared, resolution capped images as exportAsPdf
+  bool sharePixmaps = Printer->outputFormat() == QPrinter::PdfFormat;
+  if (sharePixmaps)
+      ImageCache::beginPdfExport(resolution(), Preferences::pdfImageMaxResolution);
+
   // paint to the printer
   QPainter Painter(Printer);
 
@@ -1736,6 +1792,7 @@ void Gui::PrintPdf(QPrinter* Printer)
                 {
                   if (Preferences::modeGUI)
                       m_progressDialog->hide();
+                  ImageCache::endPdfExport();
                   displayPageNum = savePageNumber;
                   drawPage(KpageView,KpageScene,false);
                   emit messageSig(LOG_STATUS,QString("Export terminated before completion."));
@@ -1784,6 +1841,7 @@ void Gui::PrintPdf(QPrinter* Printer)
                     {
                       if (Preferences::modeGUI)
                           m_progressDialog->hide();
+                      ImageCache::endPdfExport();
                       displayPageNum = savePageNumber;
                       drawPage(KpageView,KpageScene,false);
                       emit messageSig(LOG_STATUS,QString("%1 terminated before completion.")
@@ -1796,6 +1854,8 @@ void Gui::PrintPdf(QPrinter* Printer)
 
                   // render this page
                   drawPage(&view,&scene,true);
+                  if (sharePixmaps)
+                      sharePdfPixmaps(&scene);
                   scene.setSceneRect(0.0,0.0,pageWidthPx,pageHeightPx);
                   scene.render(&Painter);
                   clearPage(&view,&scene);
@@ -1851,6 +1911,7 @@ void Gui::PrintPdf(QPrinter* Printer)
                 {
                   if (Preferences::modeGUI)
                       m_progressDialog->hide();
+                  ImageCache::endPdfExport();
                   displayPageNum = savePageNumber;
                   drawPage(KpageView,KpageScene,false);
                   emit messageSig(LOG_STATUS,QString("Export terminated before completion."));
@@ -1905,6 +1966,7 @@ void Gui::PrintPdf(QPrinter* Printer)
                     {
                       if (Preferences::modeGUI)
                           m_progressDialog->hide();
+                      ImageCache::endPdfExport();
                       displayPageNum = savePageNumber;
                       drawPage(KpageView,KpageScene,false);
                       emit messageSig(LOG_STATUS,QString("%1 terminated before completion.")
@@ -1917,6 +1979,8 @@ void Gui::PrintPdf(QPrinter* Printer)
 
                   // render this page
                   drawPage(&view,&scene,true);
+                  if (sharePixmaps)
+                      sharePdfPixmaps(&scene);
                   scene.setSceneRect(0.0,0.0,pageWidthPx,pageHeightPx);
                   scene.render(&Painter);
                   clearPage(&view,&scene);
@@ -1940,6 +2004,8 @@ void Gui::PrintPdf(QPrinter* Printer)
         }
     }
 
+  ImageCache::endPdfExport();
+
   // release 3D Viewer
   setExportingSig(false);
 
@@ -34,6 +34,7 @@
 #include <QDir>
 #include <QTextStream>
 #include <QImageReader>
+#include <QCryptographicHash>
 #include <QtConcurrent>
 
 #include "lpub.h"
@@ -42,6 +43,7 @@
 #include "meta.h"
 #include "math.h"
 #include "lpub_preferences.h"
+#include "tracer.h"
 #include "application.h"
 
 #include <LDVQt/LDVWidget.h>
@@ -55,6 +57,7 @@
 #include "lc_qhtmldialog.h"
 #include "view.h"
 #include "lc_partselectionwidget.h"
+#include "lc_imagewriter.h"
 
 #ifdef Q_OS_WIN
 #include <Windows.h>
@@ -78,6 +81,31 @@ static double pi = 4*atan(1.0);
 // the default camera distance for real size
 static float LduDistance = 10.0/tan(0.005*pi/180);
 
+// open native image queue, see Render::beginNativeImageQueue()
+static lcImageWriter *nativeImageWriter = nullptr;
+
+// page size of the PLI job on this thread, see Render::setJobPageSize()
+static thread_local QSize jobPageSize;
+
+void Render::setJobPageSize(const QSize &pageSize){
+    jobPageSize = pageSize;
+}
+
+// page size in pixels, taken from the running PLI job when there is one
+static int renderPageSize(Meta &meta, int which){
+    if (jobPageSize.isValid())
+        return which == 0 ? jobPageSize.width() : jobPageSize.height();
+    return Gui::pageSize(meta.LPub.page, which);
+}
+
+// renderer log file, one per image for PLI jobs that run concurrently
+static QString rendererLogFile(const QString &log, const QString &imageName = QString()){
+    QString fileName = QDir::currentPath() + "/" + log;
+    if (! imageName.isEmpty())
+        fileName += "-" + QFileInfo(imageName).completeBaseName();
+    return fileName;
+}
+
 // renderer timeout in milliseconds
 int Render::rendererTimeout(){
     if (Preferences::rendererTimeout == -1)
@@ -86,6 +114,12 @@ int Render::rendererTimeout(){
         return Preferences::rendererTimeout*60*1000;
 }
 
+// wait for an external renderer process, traced as its own span
+static bool waitForRenderer(QProcess &process, int msecs = 30000){
+    LPUB_TRACE_SPAN("Render::waitForRenderer");
+    return process.waitForFinished(msecs);
+}
+
 const QString Render::fixupDirname(const QString &dirNameIn) {
 #ifdef Q_OS_WIN
     long     length = 0;
@@ -102,7 +136,7 @@ const QString Render::fixupDirname(const QString &dirNameIn) {
 #ifdef QT_DEBUG_MODE
                 qDebug() << message << "\n";
 #else
-                emit gui->messageSig(LOG_INFO, message);
+                emitMessage(LOG_INFO, message);
 #endif
                 return dirNameIn;
      }
@@ -119,7 +153,7 @@ const QString Render::fixupDirname(const QString &dirNameIn) {
 #ifdef QT_DEBUG_MODE
                 qDebug() << message << "\n";
 #else
-                emit gui->messageSig(LOG_INFO, message);
+                emitMessage(LOG_INFO, message);
 #endif
         return dirNameIn;
     }
@@ -267,7 +301,7 @@ float stdCameraDistance(Meta &meta, float scale) {
     onexone  = 20*meta.LPub.resolution.ldu(); // size of 1x1 in units
     onexone *= meta.LPub.resolution.value();  // size of 1x1 in pixels
     onexone *= scale;
-    factor   = gui->pageSize(meta.LPub.page, 0)/onexone; // in pixels;
+    factor   = renderPageSize(meta, 0)/onexone; // in pixels;
 
 //    logDebug() << qPrintable(QString("LduDistance                      : %1").arg(double(LduDistance)));
 //    logDebug() << qPrintable(QString("Page Size (width in pixels)      : %1").arg(gui->pageSize(meta.LPub.page, 0)));
@@ -298,7 +332,7 @@ float Render::getPovrayRenderCameraDistance(const QString &cdKeys){
             .arg(cdKey.at(K_RESOLUTION).toDouble())
             .arg(cdKey.at(K_IMAGEWIDTH).toDouble()).arg(cdKey.at(K_IMAGEHEIGHT).toDouble())
             .arg(cdKey.at(K_MODELSCALE).toDouble());
-    emit gui->messageSig(LOG_TRACE, message);
+    emitMessage(LOG_TRACE, message);
 #endif
 
     float scale = cdKey.at(K_MODELSCALE).toFloat();
@@ -313,7 +347,7 @@ float Render::getPovrayRenderCameraDistance(const QString &cdKeys){
             .arg(double(meta.LPub.resolution.value()))
             .arg(double(meta.LPub.page.size.value(0)))
             .arg(double(meta.LPub.page.size.value(1)));
-    emit gui->messageSig(LOG_TRACE, message);
+    emitMessage(LOG_TRACE, message);
 #endif
 
     // calculate LDView camera distance settings
@@ -349,7 +383,8 @@ bool Render::createSnapshotsList(
         QString smLine = ldrNames[i];
         if (QFileInfo(smLine).exists()) {
             out << smLine << endl;
-            emit gui->messageSig(LOG_INFO, QString("Wrote %1 to PLI Snapshots list").arg(smLine));
+            if (Gui::messageEnabled(LOG_INFO))
+                emit gui->messageSig(LOG_INFO, QString("Wrote %1 to PLI Snapshots list").arg(smLine));
         } else {
             emit gui->messageSig(LOG_ERROR, QString("Error %1 not written to Snapshots list - file does not exist").arg(smLine));
         }
@@ -368,17 +403,18 @@ int Render::executeLDViewProcess(QStringList &arguments, Mt module) {
 #ifdef QT_DEBUG_MODE
   qDebug() << qPrintable(message);
 #else
-  emit gui->messageSig(LOG_INFO, message);
+  emitMessage(LOG_INFO, message);
 #endif
 
   QProcess ldview;
   ldview.setEnvironment(QProcess::systemEnvironment());
   ldview.setWorkingDirectory(QDir::currentPath() + "/" + Paths::tmpDir);
-  ldview.setStandardErrorFile(QDir::currentPath() + "/stderr-ldview");
-  ldview.setStandardOutputFile(QDir::currentPath() + "/stdout-ldview");
+  const QString logImage = module == PLI ? arguments.last() : QString();
+  ldview.setStandardErrorFile(rendererLogFile("stderr-ldview", logImage));
+  ldview.setStandardOutputFile(rendererLogFile("stdout-ldview", logImage));
 
   ldview.start(Preferences::ldviewExe,arguments);
-  if ( ! ldview.waitForFinished(rendererTimeout())) {
+  if ( ! waitForRenderer(ldview, rendererTimeout())) {
       if (ldview.exitCode() != 0 || 1) {
           QByteArray status = ldview.readAll();
           QString str;
@@ -441,6 +477,7 @@ int POVRay::renderCsi(
     Meta              &meta,
     int                nType)
 {
+  LPUB_TRACE_SPAN("POVRay::renderCsi");
   Q_UNUSED(csiKeys)
   Q_UNUSED(nType)
 
@@ -508,8 +545,8 @@ int POVRay::renderCsi(
             }
         }
       if (list.size())
-          emit gui->messageSig(LOG_INFO,QMessageBox::tr("LDView extra POV-Ray CSI renderer parameters: %1")
-                               .arg(list.join(" ")));
+          emitMessage(LOG_INFO,QMessageBox::tr("LDView extra POV-Ray CSI renderer parameters: %1")
+                      .arg(list.join(" ")));
 
       bool hasLDViewIni = Preferences::ldviewPOVIni != "";
       if(hasLDViewIni){
@@ -533,11 +570,11 @@ int POVRay::renderCsi(
 #ifdef QT_DEBUG_MODE
       qDebug() << qPrintable(message);
 #else
-      emit gui->messageSig(LOG_INFO, message);
+      emitMessage(LOG_INFO, message);
 #endif
 
       ldview.start(Preferences::ldviewExe,arguments);
-      if ( ! ldview.waitForFinished(rendererTimeout())) {
+      if ( ! waitForRenderer(ldview, rendererTimeout())) {
           if (ldview.exitCode() != 0 || 1) {
               QByteArray status = ldview.readAll();
               QString str;
@@ -627,8 +664,8 @@ int POVRay::renderCsi(
         }
     }
   if (list.size())
-      emit gui->messageSig(LOG_INFO,QMessageBox::tr("POV-Ray extra CSI renderer parameters: %1")
-                           .arg(list.join(" ")));
+      emitMessage(LOG_INFO,QMessageBox::tr("POV-Ray extra CSI renderer parameters: %1")
+                  .arg(list.join(" ")));
 
 //#ifndef __APPLE__
 //  povArguments << "/EXIT";
@@ -650,11 +687,11 @@ int POVRay::renderCsi(
 #ifdef QT_DEBUG_MODE
   qDebug() << qPrintable(message);
 #else
-  emit gui->messageSig(LOG_INFO, message);
+  emitMessage(LOG_INFO, message);
 #endif
 
   povray.start(Preferences::povrayExe,povArguments);
-  if ( ! povray.waitForFinished(rendererTimeout())) {
+  if ( ! waitForRenderer(povray, rendererTimeout())) {
       if (povray.exitCode() != 0) {
           QByteArray status = povray.readAll();
           QString str;
@@ -677,6 +714,7 @@ int POVRay::renderPli(
     int                pliType,
     int                keySub)
 {
+  LPUB_TRACE_SPAN("POVRay::renderPli");
   // Select meta type
   PliMeta &metaType = pliType == SUBMODEL ? static_cast<PliMeta&>(meta.LPub.subModel) :
                       pliType == BOM ? meta.LPub.bom : meta.LPub.pli;
@@ -709,8 +747,8 @@ int POVRay::renderPli(
   /* determine camera distance */
   int cd = int(cameraDistance(meta,modelScale)*1700/1000);
 
-  int width  = gui->pageSize(meta.LPub.page, 0);
-  int height = gui->pageSize(meta.LPub.page, 1);
+  int width  = renderPageSize(meta, 0);
+  int height = renderPageSize(meta, 1);
 
   if (pliType == SUBMODEL)
       noCA   = Preferences::applyCALocally || noCA;
@@ -754,8 +792,8 @@ int POVRay::renderPli(
             }
         }
       if (list.size())
-          emit gui->messageSig(LOG_INFO,QMessageBox::tr("LDView extra POV-Ray PLI renderer parameters: %1")
-                               .arg(list.join(" ")));
+          emitMessage(LOG_INFO,QMessageBox::tr("LDView extra POV-Ray PLI renderer parameters: %1")
+                      .arg(list.join(" ")));
 
       bool hasLDViewIni = Preferences::ldviewPOVIni != "";
       if(hasLDViewIni){
@@ -772,18 +810,18 @@ int POVRay::renderPli(
       QProcess    ldview;
       ldview.setEnvironment(QProcess::systemEnvironment());
       ldview.setWorkingDirectory(QDir::currentPath());
-      ldview.setStandardErrorFile(QDir::currentPath() + "/stderr-ldviewpov");
-      ldview.setStandardOutputFile(QDir::currentPath() + "/stdout-ldviewpov");
+      ldview.setStandardErrorFile(rendererLogFile("stderr-ldviewpov", pngName));
+      ldview.setStandardOutputFile(rendererLogFile("stdout-ldviewpov", pngName));
 
       message = QString("LDView POV file generate PLI Arguments: %1 %2").arg(Preferences::ldviewExe).arg(arguments.join(" "));
 #ifdef QT_DEBUG_MODE
       qDebug() << qPrintable(message);
 #else
-      emit gui->messageSig(LOG_INFO, message);
+      emitMessage(LOG_INFO, message);
 #endif
 
       ldview.start(Preferences::ldviewExe,arguments);
-      if ( ! ldview.waitForFinished()) {
+      if ( ! waitForRenderer(ldview)) {
           if (ldview.exitCode() != 0) {
               QByteArray status = ldview.readAll();
               QString str;
@@ -873,8 +911,8 @@ int POVRay::renderPli(
         }
     }
   if (list.size())
-      emit gui->messageSig(LOG_INFO,QMessageBox::tr("POV-Ray extra PLI renderer parameters: %1")
-                           .arg(list.join(" ")));
+      emitMessage(LOG_INFO,QMessageBox::tr("POV-Ray extra PLI renderer parameters: %1")
+                  .arg(list.join(" ")));
 
 //#ifndef __APPLE__
 //  povArguments << "/EXIT";
@@ -890,18 +928,18 @@ int POVRay::renderPli(
   QString workingDirectory = pliType == SUBMODEL ? Paths::submodelDir : Paths::partsDir;
   povray.setEnvironment(povEnv);
   povray.setWorkingDirectory(QDir::currentPath()+ "/" + workingDirectory); // pov win console app will not write to dir different from cwd or source file dir
-  povray.setStandardErrorFile(QDir::currentPath() + "/stderr-povray");
-  povray.setStandardOutputFile(QDir::currentPath() + "/stdout-povray");
+  povray.setStandardErrorFile(rendererLogFile("stderr-povray", pngName));
+  povray.setStandardOutputFile(rendererLogFile("stdout-povray", pngName));
 
   message = QString("POVRay PLI Arguments: %1 %2").arg(Preferences::povrayExe).arg(povArguments.join(" "));
 #ifdef QT_DEBUG_MODE
   qDebug() << qPrintable(message);
 #else
-  emit gui->messageSig(LOG_INFO, message);
+  emitMessage(LOG_INFO, message);
 #endif
 
   povray.start(Preferences::povrayExe, povArguments);
-  if ( ! povray.waitForFinished(rendererTimeout())) {
+  if ( ! waitForRenderer(povray, rendererTimeout())) {
       if (povray.exitCode() != 0) {
           QByteArray status = povray.readAll();
           QString str;
@@ -939,6 +977,7 @@ int LDGLite::renderCsi(
         Meta        &meta,
   int                nType)
 {
+  LPUB_TRACE_SPAN("LDGLite::renderCsi");
   Q_UNUSED(csiKeys)
   Q_UNUSED(nType)
 
@@ -999,7 +1038,7 @@ int LDGLite::renderCsi(
       }
   }
   if (list.size())
-      emit gui->messageSig(LOG_INFO,QMessageBox::tr("LDGlite extra CSI renderer parameters: %1") .arg(list.join(" ")));
+      emitMessage(LOG_INFO,QMessageBox::tr("LDGlite extra CSI renderer parameters: %1") .arg(list.join(" ")));
 
   // Add ini parms if not already added from meta
   for (int i = 0; i < Preferences::ldgliteParms.size(); i++) {
@@ -1043,11 +1082,11 @@ int LDGLite::renderCsi(
 #ifdef QT_DEBUG_MODE
   qDebug() << qPrintable(message);
 #else
-  emit gui->messageSig(LOG_INFO, message);
+  emitMessage(LOG_INFO, message);
 #endif
 
   ldglite.start(Preferences::ldgliteExe,arguments);
-  if ( ! ldglite.waitForFinished(rendererTimeout())) {
+  if ( ! waitForRenderer(ldglite, rendererTimeout())) {
     if (ldglite.exitCode() != 0) {
       QByteArray status = ldglite.readAll();
       QString str;
@@ -1075,6 +1114,7 @@ int LDGLite::renderPli(
   int                pliType,
   int                keySub)
 {
+  LPUB_TRACE_SPAN("LDGLite::renderPli");
   // Select meta type
   PliMeta &metaType = pliType == SUBMODEL ? static_cast<PliMeta&>(meta.LPub.subModel) :
                       pliType == BOM ? meta.LPub.bom : meta.LPub.pli;
@@ -1103,8 +1143,8 @@ int LDGLite::renderPli(
   /* determine camera distance */
   int cd = int(cameraDistance(meta,modelScale));
 
-  int width  = gui->pageSize(meta.LPub.page, 0);
-  int height = gui->pageSize(meta.LPub.page, 1);
+  int width  = renderPageSize(meta, 0);
+  int height = renderPageSize(meta, 1);
 
   int lineThickness = int(double(resolution())/72.0+0.5);
 
@@ -1140,7 +1180,7 @@ int LDGLite::renderPli(
       }
   }
   if (list.size())
-      emit gui->messageSig(LOG_INFO,QMessageBox::tr("LDGlite extra PLI renderer parameters %1") .arg(list.join(" ")));
+      emitMessage(LOG_INFO,QMessageBox::tr("LDGlite extra PLI renderer parameters %1") .arg(list.join(" ")));
 
   // Add ini parms if not already added from meta
   for (int i = 0; i < Preferences::ldgliteParms.size(); i++) {
@@ -1175,18 +1215,18 @@ int LDGLite::renderPli(
 
   ldglite.setEnvironment(env);
   ldglite.setWorkingDirectory(QDir::currentPath());
-  ldglite.setStandardErrorFile(QDir::currentPath() + "/stderr-ldglite");
-  ldglite.setStandardOutputFile(QDir::currentPath() + "/stdout-ldglite");
+  ldglite.setStandardErrorFile(rendererLogFile("stderr-ldglite", pngName));
+  ldglite.setStandardOutputFile(rendererLogFile("stdout-ldglite", pngName));
 
   QString message = QString("LDGLite PLI Arguments: %1 %2").arg(Preferences::ldgliteExe).arg(arguments.join(" "));
 #ifdef QT_DEBUG_MODE
   qDebug() << qPrintable(message);
 #else
-  emit gui->messageSig(LOG_INFO, message);
+  emitMessage(LOG_INFO, message);
 #endif
 
   ldglite.start(Preferences::ldgliteExe,arguments);
-  if (! ldglite.waitForFinished(rendererTimeout())) {
+  if (! waitForRenderer(ldglite, rendererTimeout())) {
     if (ldglite.exitCode()) {
       QByteArray status = ldglite.readAll();
       QString str;
@@ -1251,6 +1291,7 @@ int LDView::renderCsi(
         Meta              &meta,
         int                nType)
 {
+    LPUB_TRACE_SPAN("LDView::renderCsi");
     Q_UNUSED(nType)
 
     /* determine camera distance */
@@ -1310,7 +1351,8 @@ int LDView::renderCsi(
             for (int i = 0; i < ldrNames.size(); i++) {
                 QString smLine = ldrNames[i];
                 out << smLine << endl;                          // ldrNames that ARE NOT IM
-                emit gui->messageSig(LOG_INFO, QString("Wrote %1 to CSI Snapshots list").arg(smLine));
+                if (Gui::messageEnabled(LOG_INFO))
+                    emit gui->messageSig(LOG_INFO, QString("Wrote %1 to CSI Snapshots list").arg(smLine));
             }
             SnapshotsListFile.close();
 
@@ -1378,8 +1420,8 @@ int LDView::renderCsi(
     }
   }
   if (ldviewParmslist.size())
-      emit gui->messageSig(LOG_INFO,QMessageBox::tr("LDView extra CSI renderer parameters: %1")
-                           .arg(ldviewParmslist.join(" ")));
+      emitMessage(LOG_INFO,QMessageBox::tr("LDView extra CSI renderer parameters: %1")
+                  .arg(ldviewParmslist.join(" ")));
 
   bool hasLDViewIni = Preferences::ldviewIni != "";
   QString ini;
@@ -1494,6 +1536,7 @@ int LDView::renderPli(
   int                pliType,
   int                keySub)
 {
+  LPUB_TRACE_SPAN("LDView::renderPli");
   // Select meta type
   PliMeta &metaType = pliType == SUBMODEL ? static_cast<PliMeta&>(meta.LPub.subModel) :
                       pliType == BOM ? meta.LPub.bom : meta.LPub.pli;
@@ -1631,8 +1674,8 @@ int LDView::renderPli(
   }
 
   /* page size */
-  int width  = gui->pageSize(meta.LPub.page, 0);
-  int height = gui->pageSize(meta.LPub.page, 1);
+  int width  = renderPageSize(meta, 0);
+  int height = renderPageSize(meta, 1);
 
   QString w  = QString("-SaveWidth=%1")  .arg(width);
   QString h  = QString("-SaveHeight=%1") .arg(height);
@@ -1660,8 +1703,8 @@ int LDView::renderPli(
     }
   }
   if (ldviewParmslist.size())
-      emit gui->messageSig(LOG_INFO,QMessageBox::tr("LDView extra PLI renderer parameters: %1")
-                           .arg(ldviewParmslist.join(" ")));
+      emitMessage(LOG_INFO,QMessageBox::tr("LDView extra PLI renderer parameters: %1")
+                  .arg(ldviewParmslist.join(" ")));
 
   if(Preferences::ldviewIni != ""){
       arguments << QString("-IniFile=%1") .arg(Preferences::ldviewIni);;
@@ -1732,6 +1775,7 @@ int Native::renderCsi(
         Meta        &meta,
   int                nType)
 {
+  LPUB_TRACE_SPAN("Native::renderCsi");
   QString ldrName     = QDir::currentPath() + "/" + Paths::tmpDir + "/csi.ldr";
   float lineThickness = (float(resolution()/Preferences::highlightStepLineWidth));
 
@@ -1815,6 +1859,11 @@ int Native::renderCsi(
               Options.ExportFileName = QDir::toNativeSeparators(outPath+"/"+baseName+".obj");
               ldvExport = false;
               break;
+          case EXPORT_GLTF:
+              Options.ExportMode = int(EXPORT_GLTF);
+              Options.ExportFileName = QDir::toNativeSeparators(outPath+"/"+baseName+".glb");
+              ldvExport = false;
+              break;
           default:
               emit gui->messageSig(LOG_ERROR,QMessageBox::tr("Invalid CSI Object export option."));
               delete CsiImageProject;
@@ -1897,6 +1946,7 @@ int Native::renderPli(
   int               pliType,
   int               keySub)
 {
+  LPUB_TRACE_SPAN("Native::renderPli");
   // Select meta type
   PliMeta &metaType = pliType == SUBMODEL ? static_cast<PliMeta&>(meta.LPub.subModel) :
                       pliType == BOM ? meta.LPub.bom : meta.LPub.pli; 
@@ -1955,6 +2005,39 @@ int Native::renderPli(
   return 0;
 }
 
+/*
+ * While a native image queue is open, RenderNativeImage hands each rendered
+ * image to a writer on the global thread pool and returns, so the next image
+ * is drawn while the previous one is cropped and encoded. Close the queue
+ * with endNativeImageQueue(), which waits for the writes and returns the
+ * files that could not be written, before reading any of the images.
+ */
+void Render::beginNativeImageQueue()
+{
+    if (!nativeImageWriter)
+        nativeImageWriter = new lcImageWriter();
+}
+
+QStringList Render::endNativeImageQueue()
+{
+    QStringList failedFiles;
+
+    if (!nativeImageWriter)
+        return failedFiles;
+
+    for (const lcImageWriteError &error : nativeImageWriter->Finish()) {
+        emit gui->messageSig(LOG_ERROR,QString("Could not write to Native image file:<br>[%1].<br>Reason: %2.")
+                                               .arg(error.FileName)
+                                               .arg(error.Error));
+        failedFiles << error.FileName;
+    }
+
+    delete nativeImageWriter;
+    nativeImageWriter = nullptr;
+
+    return failedFiles;
+}
+
 bool Render::RenderNativeImage(const NativeOptions &Options)
 {
     // Load model
@@ -2008,31 +2091,26 @@ bool Render::RenderNativeImage(const NativeOptions &Options)
 
         View.OnDraw();
 
-        struct NativeImage
-        {
-            QImage RenderedImage;
-            QRect Bounds;
-        };
+        const QImage RenderedImage = View.GetRenderImage();
 
-        NativeImage Image;
-        Image.RenderedImage = View.GetRenderImage();
-
-        auto CalculateImageBounds = [](NativeImage& Image)
+        // Crop to the drawn pixels, runs on the writer thread when queued
+        auto CropImage = [](const QImage& Image)
         {
-            QImage& RenderedImage = Image.RenderedImage;
-            int Width = RenderedImage.width();
-            int Height = RenderedImage.height();
+            int Width = Image.width();
+            int Height = Image.height();
 
             int MinX = Width;
             int MinY = Height;
             int MaxX = 0;
             int MaxY = 0;
 
-            for (int x = 0; x < Width; x++)
+            for (int y = 0; y < Height; y++)
             {
-                for (int y = 0; y < Height; y++)
+                const QRgb* Line = reinterpret_cast<const QRgb*>(Image.constScanLine(y));
+
+                for (int x = 0; x < Width; x++)
                 {
-                    if (qAlpha(RenderedImage.pixel(x, y)))
+                    if (qAlpha(Line[x]))
                     {
                         MinX = qMin(x, MinX);
                         MinY = qMin(y, MinY);
@@ -2042,29 +2120,35 @@ bool Render::RenderNativeImage(const NativeOptions &Options)
                 }
             }
 
-            Image.Bounds = QRect(QPoint(MinX, MinY), QPoint(MaxX, MaxY));
+            return Image.copy(QRect(QPoint(MinX, MinY), QPoint(MaxX, MaxY)));
         };
 
-        CalculateImageBounds(Image);
+        // A queue that already has a failed write is reported when it is
+        // closed, so this image is written here instead
+        const bool queued = nativeImageWriter &&
+                            nativeImageWriter->Write(Options.OutputFileName, RenderedImage, "PNG", CropImage);
 
-        QImageWriter Writer(Options.OutputFileName);
+        if (!queued)
+        {
+            QImageWriter Writer(Options.OutputFileName);
 
-        if (Writer.format().isEmpty())
-            Writer.setFormat("PNG");
+            if (Writer.format().isEmpty())
+                Writer.setFormat("PNG");
 
-        if (!Writer.write(QImage(Image.RenderedImage.copy(Image.Bounds))))
-        {
-            emit gui->messageSig(LOG_ERROR,QString("Could not write to Native %1 %2 file:<br>[%3].<br>Reason: %4.<br>"
-                                                   "Ensure Field of View (default is 30) and Camera Distance Factor <br>"
-                                                   "are configured for the Native Renderer")
-                                                   .arg(ImageType)
-                                                   .arg(Options.ExportMode == EXPORT_NONE ?
-                                                        QString("image") :
-                                                        QString("%1 object")
-                                                                .arg(nativeExportNames[gui->exportMode]))
-                                                   .arg(Options.OutputFileName)
-                                                   .arg(Writer.errorString()));
-            rc = false;
+            if (!Writer.write(CropImage(RenderedImage)))
+            {
+                emit gui->messageSig(LOG_ERROR,QString("Could not write to Native %1 %2 file:<br>[%3].<br>Reason: %4.<br>"
+                                                       "Ensure Field of View (default is 30) and Camera Distance Factor <br>"
+                                                       "are configured for the Native Renderer")
+                                                       .arg(ImageType)
+                                                       .arg(Options.ExportMode == EXPORT_NONE ?
+                                                            QString("image") :
+                                                            QString("%1 object")
+                                                                    .arg(nativeExportNames[gui->exportMode]))
+                                                       .arg(Options.OutputFileName)
+                                                       .arg(Writer.errorString()));
+                rc = false;
+            }
         }
 
         View.EndRenderToImage();
@@ -2077,7 +2161,7 @@ bool Render::RenderNativeImage(const NativeOptions &Options)
     if (!ActiveModel->mActive)
         ActiveModel->CalculateStep(LC_STEP_MAX);
 
-    if (rc)
+    if (rc && Gui::messageEnabled(LOG_INFO))
         emit gui->messageSig(LOG_INFO,QMessageBox::tr("Native %1 image file rendered '%2'")
                           .arg(ImageType).arg(Options.OutputFileName));
 
@@ -2275,6 +2359,7 @@ bool Render::NativeExport(const NativeOptions &Options) {
 
     if (Options.ExportMode == EXPORT_WAVEFRONT ||
         Options.ExportMode == EXPORT_COLLADA   ||
+        Options.ExportMode == EXPORT_GLTF      ||
         Options.ExportMode == EXPORT_CSV       ||
         Options.ExportMode == EXPORT_BRICKLINK /*||
         Options.ExportMode == EXPORT_3DS_MAX*/) {
@@ -2313,6 +2398,11 @@ bool Render::NativeExport(const NativeOptions &Options) {
     {
         lcGetActiveProject()->ExportCOLLADA(Options.ExportFileName);
     }
+    else
+    if (Options.ExportMode == EXPORT_GLTF)
+    {
+        return lcGetActiveProject()->ExportGLTF(Options.ExportFileName);
+    }
 
 /*
     // These are executed through the LDV Native renderer
@@ -2389,9 +2479,9 @@ bool Render::doLDVCommand(const QStringList &args, int exportMode, int iniFlag){
     }
 
     QString workingDirectory = QDir::currentPath();
-    emit gui->messageSig(LOG_TRACE, QString("Native CSI %1 Export for command: %2")
-                                             .arg(exportModeName)
-                                             .arg(arguments.join(" ")));
+    emitMessage(LOG_TRACE, QString("Native CSI %1 Export for command: %2")
+                                    .arg(exportModeName)
+                                    .arg(arguments.join(" ")));
     ldvWidget = new LDVWidget(nullptr,IniFlag(iniFlag),true);
     if (exportHTML)
         gui->connect(ldvWidget, SIGNAL(loadBLCodesSig()), gui, SLOT(loadBLCodes()));
@@ -2472,7 +2562,7 @@ int Render::createNativeModelFile(
   QStringList csiSubModelParts;
   QStringList csiParts = csiRotatedParts;
 
-  QStringList argv;
+  LDrawTokens argv;
   int         rc;
 
   if (csiRotatedParts.size() > 0) {
@@ -2480,11 +2570,11 @@ int Render::createNativeModelFile(
       for (int index = 0; index < csiRotatedParts.size(); index++) {
 
           QString csiLine = csiRotatedParts[index];
-          split(csiLine, argv);
+          argv.tokenize(csiLine);
           if (argv.size() == 15 && argv[0] == "1") {
 
               /* process subfiles in csiRotatedParts */
-              QString type = argv[argv.size()-1];
+              QString type = argv.toString(argv.size()-1);
 
               bool isCustomSubModel = false;
               bool isCustomPart = false;
@@ -2546,6 +2636,27 @@ int Render::createNativeModelFile(
   return 0;
 }
 
+/*
+ * Normalized content and referenced types of a temp directory submodel,
+ * kept for the session and parsed again only when the file content hash
+ * changes. Whether a type is a submodel or an unofficial part depends on
+ * the loaded model, so that is decided each time the entry is used.
+ */
+struct NativeSubModel
+{
+  QByteArray  contentHash;
+  QStringList lines;
+  QStringList types;
+};
+
+static QHash<QString, NativeSubModel> nativeSubModels;
+
+/* drop the session's submodels when the temp files are removed or the model closes */
+void Render::clearNativeSubModels()
+{
+  nativeSubModels.clear();
+}
+
 int Render::mergeNativeCSISubModels(QStringList &subModels,
                                   QStringList &subModelParts,
                                   bool doFadeStep,
@@ -2553,99 +2664,109 @@ int Render::mergeNativeCSISubModels(QStringList &subModels,
 {
   QStringList csiSubModels        = subModels;
   QStringList csiSubModelParts    = subModelParts;
-  QStringList newSubModels;
+  QSet<QString> merged;
 
   QStringList argv;
-  int         rc;
 
-  if (csiSubModels.size() > 0) {
-
-      /* read in all detected sub model file content */
-      for (int index = 0; index < csiSubModels.size(); index++) {
-          QString ldrName(QDir::currentPath() + "/" +
-                          Paths::tmpDir + "/" +
-                          csiSubModels[index]);
-
-          /* initialize the working submodel file - define header. */
-          QString modelName = QFileInfo(csiSubModels[index]).completeBaseName().toLower();
-          modelName = modelName.replace(
-                      modelName.indexOf(modelName.at(0)),1,modelName.at(0).toUpper());
-          csiSubModelParts << QString("0 FILE %1").arg(csiSubModels[index]);
-          csiSubModelParts << QString("0 %1").arg(modelName);
-          csiSubModelParts << QString("0 Name: %1").arg(csiSubModels[index]);
-          csiSubModelParts << QString("0 !LEOCAD MODEL NAME %1").arg(modelName);
-
-          /* read the actual submodel file */
-          QFile ldrfile(ldrName);
-          if ( ! ldrfile.open(QFile::ReadOnly | QFile::Text)) {
-              emit gui->messageSig(LOG_ERROR,QString("Could not read CSI submodel file %1: %2")
-                                   .arg(ldrName)
-                                   .arg(ldrfile.errorString()));
-              return -1;
-            }
+  /* each submodel is merged once however deep or often it is referenced */
+  for (int index = 0; index < csiSubModels.size(); index++) {
+      if (merged.contains(csiSubModels[index].toLower()))
+          continue;
+      merged.insert(csiSubModels[index].toLower());
+
+      QString ldrName(QDir::currentPath() + "/" +
+                      Paths::tmpDir + "/" +
+                      csiSubModels[index]);
+
+      /* initialize the working submodel file - define header. */
+      QString modelName = QFileInfo(csiSubModels[index]).completeBaseName().toLower();
+      modelName = modelName.replace(
+                  modelName.indexOf(modelName.at(0)),1,modelName.at(0).toUpper());
+      csiSubModelParts << QString("0 FILE %1").arg(csiSubModels[index]);
+      csiSubModelParts << QString("0 %1").arg(modelName);
+      csiSubModelParts << QString("0 Name: %1").arg(csiSubModels[index]);
+      csiSubModelParts << QString("0 !LEOCAD MODEL NAME %1").arg(modelName);
+
+      /* read the actual submodel file */
+      QFile ldrfile(ldrName);
+      if ( ! ldrfile.open(QFile::ReadOnly | QFile::Text)) {
+          emit gui->messageSig(LOG_ERROR,QString("Could not read CSI submodel file %1: %2")
+                               .arg(ldrName)
+                               .arg(ldrfile.errorString()));
+          return -1;
+        }
+      const QByteArray content = ldrfile.readAll();
+      const QByteArray contentHash = QCryptographicHash::hash(content, QCryptographicHash::Md5);
+      ldrfile.close();
+
+      QHash<QString, NativeSubModel>::iterator cached = nativeSubModels.find(ldrName);
+      if (cached == nativeSubModels.end() || cached.value().contentHash != contentHash) {
+
+          NativeSubModel subModel;
+          subModel.contentHash = contentHash;
+
           /* populate file contents into working submodel csi parts */
-          QTextStream in(&ldrfile);
+          QTextStream in(content);
           while ( ! in.atEnd()) {
               QString csiLine = in.readLine(0);
               split(csiLine, argv);
 
               if (argv.size() == 15 && argv[0] == "1") {
-                  /* check and process any subfiles in csiRotatedParts */
                   QString type = argv[argv.size()-1];
-
-                  bool isCustomSubModel = false;
-                  bool isCustomPart = false;
-                  QString customType;
-
-                  // Custom part types
-                  if (doFadeStep) {
-                      QString fadeSfx = QString("%1.").arg(FADE_SFX);
-                      bool isFadedItem = type.contains(fadeSfx);
-                      // Fade file
-                      if (isFadedItem) {
-                          customType = type;
-                          customType = customType.replace(fadeSfx,".");
-                          isCustomSubModel = gui->isSubmodel(customType);
-                          isCustomPart = gui->isUnofficialPart(customType);
-                        }
-                    }
-
-                  if (doHighlightStep) {
-                      QString highlightSfx = QString("%1.").arg(HIGHLIGHT_SFX);
-                      bool isHighlightItem = type.contains(highlightSfx);
-                      // Highlight file
-                      if (isHighlightItem) {
-                          customType = type;
-                          customType = customType.replace(highlightSfx,".");
-                          isCustomSubModel = gui->isSubmodel(customType);
-                          isCustomPart = gui->isUnofficialPart(customType);
-                        }
-                    }
-
-                  if (gui->isSubmodel(type) || gui->isUnofficialPart(type) || isCustomSubModel || isCustomPart) {
-                      /* capture all subfiles (full string) to be processed when finished */
-                      if (!newSubModels.contains(type.toLower()))
-                              newSubModels << type.toLower();
-                    }
+                  if (!subModel.types.contains(type))
+                      subModel.types << type;
                 }
               if (isGhost(csiLine))
                   argv.prepend(GHOST_META);
               csiLine = argv.join(" ");
-              csiSubModelParts << csiLine;
+              subModel.lines << csiLine;
             }
-          csiSubModelParts << "0 NOFILE";
+
+          cached = nativeSubModels.insert(ldrName, subModel);
         }
 
-      /* recurse and process any identified submodel files */
-      if (newSubModels.size() > 0){
-          if (newSubModels.size() > 2)
-              newSubModels.removeDuplicates();
-          if ((rc = mergeNativeCSISubModels(newSubModels, csiSubModelParts, doFadeStep, doHighlightStep)) != 0){
-              emit gui->messageSig(LOG_ERROR,QString("Failed to recurse viewer CSI submodels"));
-              return rc;
+      csiSubModelParts << cached.value().lines;
+      csiSubModelParts << "0 NOFILE";
+
+      /* check and process any subfiles in csiRotatedParts */
+      for (const QString &type : cached.value().types) {
+
+          bool isCustomSubModel = false;
+          bool isCustomPart = false;
+          QString customType;
+
+          // Custom part types
+          if (doFadeStep) {
+              QString fadeSfx = QString("%1.").arg(FADE_SFX);
+              bool isFadedItem = type.contains(fadeSfx);
+              // Fade file
+              if (isFadedItem) {
+                  customType = type;
+                  customType = customType.replace(fadeSfx,".");
+                  isCustomSubModel = gui->isSubmodel(customType);
+                  isCustomPart = gui->isUnofficialPart(customType);
+                }
+            }
+
+          if (doHighlightStep) {
+              QString highlightSfx = QString("%1.").arg(HIGHLIGHT_SFX);
+              bool isHighlightItem = type.contains(highlightSfx);
+              // Highlight file
+              if (isHighlightItem) {
+                  customType = type;
+                  customType = customType.replace(highlightSfx,".");
+                  isCustomSubModel = gui->isSubmodel(customType);
+                  isCustomPart = gui->isUnofficialPart(customType);
+                }
+            }
+
+          if (gui->isSubmodel(type) || gui->isUnofficialPart(type) || isCustomSubModel || isCustomPart) {
+              /* queue all subfiles (full string) to be processed when finished */
+              csiSubModels << type.toLower();
             }
         }
-      subModelParts = csiSubModelParts;
     }
+
+  subModelParts = csiSubModelParts;
   return 0;
 }
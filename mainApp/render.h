@@ -34,6 +34,7 @@
 
 class QString;
 class QStringList;
+class QSize;
 class Meta;
 class AssemMeta;
 class LPubMeta;
@@ -66,6 +67,9 @@ public:
   static void            showLdvExportSettings(int mode);
   static void            showLdvLDrawPreferences(int mode);
   static bool            RenderNativeImage(const NativeOptions &);
+  static void            beginNativeImageQueue();
+  static QStringList     endNativeImageQueue();
+  static void            setJobPageSize(const QSize &);
   static bool            NativeExport(const NativeOptions &);
   static bool            LoadViewer(const ViewerOptions &);
   static bool            createSnapshotsList(const QStringList &,
@@ -82,6 +86,7 @@ public:
                                      QStringList &subModelParts,
                                      bool doFadeStep,
                                      bool doHighlightStep);
+  static void            clearNativeSubModels();
   static int             rotateParts(const QString &addLine,
                                      RotStepMeta &rotStep,
                                      const QStringList &parts,
@@ -24,6 +24,7 @@
 #include <QTextStream>
 #include <QRegExp>
 #include <math.h>
+#include <cmath>
 
 #include "paths.h"
 #include "render.h"
@@ -151,6 +152,131 @@ void rotateMatrix(
   }
 }
 
+/*
+ * Append value the way QString::number(value) writes it. Whole
+ * numbers below 1e6, which are most matrix entries and many
+ * positions, are written directly; 'g' formatting with six
+ * significant digits prints those as plain integers. Everything
+ * else, including negative zero, goes through QString::number().
+ */
+static void appendNumber(QString &line, double value)
+{
+  if (value > -1e6 && value < 1e6 && value == double(int(value)) &&
+      ! (value == 0.0 && std::signbit(value))) {
+    char buffer[8];
+    char *end = buffer + sizeof(buffer);
+    char *p = end;
+    int n = int(value);
+    const bool negative = n < 0;
+    if (negative) {
+      n = -n;
+    }
+    do {
+      *--p = char('0' + n % 10);
+      n /= 10;
+    } while (n);
+    if (negative) {
+      *--p = '-';
+    }
+    line += QLatin1String(p, int(end - p));
+  } else {
+    line += QString::number(value);
+  }
+}
+
+/*
+ * A part, line, triangle, quad or optional line parsed once
+ * from its LDraw text so it can be rotated and centered in
+ * binary form. Text is produced again only by format(), which
+ * yields the same numbers the QString::arg() formatting did.
+ */
+struct RotatedPart
+{
+  int     type;
+  int     points;
+  QString color;
+  QString name;
+  double  v[4][3];
+  double  pm[3][3];
+
+  RotatedPart() : type(0), points(0) {}
+
+  bool parse(const QString &line)
+  {
+    LDrawTokens tokens(line);
+
+    if (tokens.size() < 2 || tokens[0].size() != 1) {
+      return false;
+    }
+
+    const int lineType = tokens[0].at(0).toLatin1() - '0';
+    const int linePoints[] = { 0, 1, 2, 3, 4, 4 };
+    const int lineTokens[] = { 0, 15, 8, 11, 14, 14 };
+
+    if (lineType < 1 || lineType > 5 || tokens.size() < lineTokens[lineType]) {
+      return false;
+    }
+
+    type   = lineType;
+    points = linePoints[lineType];
+    color  = tokens.toString(1);
+
+    int c = 2;
+    if (type == 1) {
+      // part positions are read at float precision
+      v[0][0] = tokens[c].toFloat();
+      v[0][1] = tokens[c+1].toFloat();
+      v[0][2] = tokens[c+2].toFloat();
+      c += 3;
+      for (int y = 0; y < 3; y++) {
+        for (int x = 0; x < 3; x++) {
+          pm[y][x] = tokens[c++].toDouble();
+        }
+      }
+      name = tokens.toString(tokens.size()-1);
+    } else {
+      for (int n = 0; n < points; n++) {
+        for (int d = 0; d < 3; d++) {
+          v[n][d] = tokens[c++].toDouble();
+        }
+      }
+    }
+    return true;
+  }
+
+  QString format() const
+  {
+    QString line;
+    line.reserve(type == 1 ? 128 + name.size() : 160);
+    line += QChar('0' + type);
+    line += ' ';
+    line += color;
+
+    for (int n = 0; n < points; n++) {
+      // triangle vertices are separated by two spaces
+      if (type == 3 && n > 0) {
+        line += ' ';
+      }
+      for (int d = 0; d < 3; d++) {
+        line += ' ';
+        appendNumber(line, v[n][d]);
+      }
+    }
+
+    if (type == 1) {
+      for (int y = 0; y < 3; y++) {
+        for (int x = 0; x < 3; x++) {
+          line += ' ';
+          appendNumber(line, pm[y][x]);
+        }
+      }
+      line += ' ';
+      line += name;
+    }
+    return line;
+  }
+};
+
 int Render::rotateParts(const QStringList &parts, QString &ldrName, const QString &rs, QString &ca)
 {
     bool ldvExport = true, good = false, ok = false;
@@ -312,9 +438,7 @@ int Render::rotateParts(
     }
   }
 
-  QStringList tokens;
-
-  split(addLine,tokens);
+  LDrawTokens tokens(addLine);
 
   if (addLine.size() && tokens.size() == 15 && tokens[0] == "1") {
     if (LDrawFile::mirrored(tokens) || ! defaultRot) {
@@ -329,106 +453,27 @@ int Render::rotateParts(
     }
   }
 
-  // rotate all the parts
+  // parse and rotate all the parts once
 
-  for (int i = 0; i < parts.size(); i++) {
+  QVector<RotatedPart> rotated(parts.size());
 
-    QString line = parts[i];
-    QStringList tokens;
+  for (int i = 0; i < parts.size(); i++) {
 
-    split(line,tokens);
+    RotatedPart &part = rotated[i];
 
-    if (tokens.size() < 2) {
+    if ( ! part.parse(parts[i])) {
       continue;
     }
 
-    double v[4][3];
-
-    if (tokens[0] == "1") {
-      v[0][0] = tokens[2].toFloat();
-      v[0][1] = tokens[3].toFloat();
-      v[0][2] = tokens[4].toFloat();
-
-      rotatePoint(v[0],rm);
+    for (int n = 0; n < part.points; n++) {
+      rotatePoint(part.v[n],rm);
 
       for (int d = 0; d < 3; d++) {
-        if (v[0][d] < min[d]) {
-          min[d] = v[0][d];
+        if (part.v[n][d] < min[d]) {
+          min[d] = part.v[n][d];
         }
-        if (v[0][d] > max[d]) {
-          max[d] = v[0][d];
-        }
-      }
-    } else if (tokens[0] == "2") {
-      int c = 2;
-      for (int j = 0; j < 2; j++) {
-        v[j][0] = tokens[c].toDouble();
-        v[j][1] = tokens[c+1].toDouble();
-        v[j][2] = tokens[c+2].toDouble();
-        c += 3;
-        rotatePoint(v[j],rm);
-
-        for (int d = 0; d < 3; d++) {
-          if (v[j][d] < min[d]) {
-            min[d] = v[j][d];
-          }
-          if (v[j][d] > max[d]) {
-            max[d] = v[j][d];
-          }
-        }
-      }
-    } else if (tokens[0] == "3") {
-      int c = 2;
-      for (int j = 0; j < 3; j++) {
-        v[j][0] = tokens[c].toDouble();
-        v[j][1] = tokens[c+1].toDouble();
-        v[j][2] = tokens[c+2].toDouble();
-        c += 3;
-        rotatePoint(v[j],rm);
-
-        for (int d = 0; d < 3; d++) {
-          if (v[j][d] < min[d]) {
-            min[d] = v[j][d];
-          }
-          if (v[j][d] > max[d]) {
-            max[d] = v[j][d];
-          }
-        }
-      }
-    } else if (tokens[0] == "4") {
-      int c = 2;
-      for (int j = 0; j < 4; j++) {
-        v[j][0] = tokens[c].toDouble();
-        v[j][1] = tokens[c+1].toDouble();
-        v[j][2] = tokens[c+2].toDouble();
-        c += 3;
-        rotatePoint(v[j],rm);
-
-        for (int d = 0; d < 3; d++) {
-          if (v[j][d] < min[d]) {
-            min[d] = v[j][d];
-          }
-          if (v[j][d] > max[d]) {
-            max[d] = v[j][d];
-          }
-        }
-      }
-    } else if (tokens[0] == "5") {
-      int c = 2;
-      for (int j = 0; j < 4; j++) {
-        v[j][0] = tokens[c].toDouble();
-        v[j][1] = tokens[c+1].toDouble();
-        v[j][2] = tokens[c+2].toDouble();
-        c += 3;
-        rotatePoint(v[j],rm);
-
-        for (int d = 0; d < 3; d++) {
-          if (v[j][d] < min[d]) {
-            min[d] = v[j][d];
-          }
-          if (v[j][d] > max[d]) {
-            max[d] = v[j][d];
-          }
+        if (part.v[n][d] > max[d]) {
+          max[d] = part.v[n][d];
         }
       }
     }
@@ -442,142 +487,24 @@ int Render::rotateParts(
   }
 
   for (int i = 0; i < parts.size(); i++) {
-    QString line = parts[i];
-    QStringList tokens;
 
-    split(line,tokens);
+    RotatedPart &part = rotated[i];
 
-    if (tokens.size() < 2) {
+    if (part.type == 0) {
       continue;
     }
 
-    double v[4][3];
-    double pm[3][3];
-    QString t1;
-
-    if (tokens[0] == "1") {
-      int c = 2;
-      v[0][0] = tokens[c].toFloat();
-      v[0][1] = tokens[c+1].toFloat();
-      v[0][2] = tokens[c+2].toFloat();
-      c += 3;
-      for (int y = 0; y < 3; y++) {
-        for (int x = 0; x < 3; x++) {
-          pm[y][x] = tokens[c++].toDouble();
-        }
-      }
-      rotatePoint(v[0],rm);
-      v[0][0] -= center[0];
-      v[0][1] -= center[1];
-      v[0][2] -= center[2];
-      rotateMatrix(pm,rm);
-
-      t1 = QString("1 %1 "
-                   "%2 %3 %4 "
-                   "%5 %6 %7 "
-                   "%8 %9 %10 "
-                   "%11 %12 %13 "
-                   "%14")
-
-                   .arg(tokens[1])
-                   .arg( v[0][0]) .arg( v[0][1]) .arg( v[0][2])
-                   .arg(pm[0][0]) .arg(pm[0][1]) .arg(pm[0][2])
-                   .arg(pm[1][0]) .arg(pm[1][1]) .arg(pm[1][2])
-                   .arg(pm[2][0]) .arg(pm[2][1]) .arg(pm[2][2])
-                   .arg(tokens[tokens.size()-1]);
-
-      parts[i] = t1;
-    } else if (tokens[0] == "2") {
-
-      int c = 2;
-      for (int n = 0; n < 2; n++) {
-        for (int d = 0; d < 3; d++) {
-          v[n][d] = tokens[c++].toDouble();
-        }
-        rotatePoint(v[n],rm);
-        for (int d = 0; d < 3; d++) {
-          v[n][d] -= center[d];
-        }
-      }
-
-      t1 = QString("2 %1 "
-                   "%2 %3 %4 "
-                   "%5 %6 %7")
-                   .arg(tokens[1])
-                   .arg( v[0][0]) .arg( v[0][1]) .arg( v[0][2])
-                   .arg( v[1][0]) .arg( v[1][1]) .arg( v[1][2]);
-      parts[i] = t1;
-    } else if (tokens[0] == "3") {
-
-      int c = 2;
-      for (int n = 0; n < 3; n++) {
-        for (int d = 0; d < 3; d++) {
-          v[n][d] = tokens[c++].toDouble();
-        }
-        rotatePoint(v[n],rm);
-        for (int d = 0; d < 3; d++) {
-          v[n][d] -= center[d];
-        }
-      }
-
-      t1 = QString("3 %1 "
-                   "%2 %3 %4  "
-                   "%5 %6 %7  "
-                   "%8 %9 %10")
-                     .arg(tokens[1])
-                     .arg( v[0][0]) .arg( v[0][1]) .arg( v[0][2])
-                     .arg( v[1][0]) .arg( v[1][1]) .arg( v[1][2])
-                     .arg( v[2][0]) .arg( v[2][1]) .arg( v[2][2]);
-      parts[i] = t1;
-    } else if (tokens[0] == "4") {
-
-      int c = 2;
-      for (int n = 0; n < 4; n++) {
-        for (int d = 0; d < 3; d++) {
-          v[n][d] = tokens[c++].toDouble();
-        }
-        rotatePoint(v[n],rm);
-        for (int d = 0; d < 3; d++) {
-          v[n][d] -= center[d];
-        }
-      }
-
-      t1 = QString("4 %1 "
-                   "%2 %3 %4 "
-                   "%5 %6 %7 "
-                   "%8 %9 %10 "
-                   "%11 %12 %13")
-                     .arg(tokens[1])
-                     .arg( v[0][0]) .arg( v[0][1]) .arg( v[0][2])
-                     .arg( v[1][0]) .arg( v[1][1]) .arg( v[1][2])
-                     .arg( v[2][0]) .arg( v[2][1]) .arg( v[2][2])
-                     .arg( v[3][0]) .arg( v[3][1]) .arg( v[3][2]);
-      parts[i] = t1;
-    } else if (tokens[0] == "5") {
-
-      int c = 2;
-      for (int n = 0; n < 4; n++) {
-        for (int d = 0; d < 3; d++) {
-          v[n][d] = tokens[c++].toDouble();
-        }
-        rotatePoint(v[n],rm);
-        for (int d = 0; d < 3; d++) {
-          v[n][d] -= center[d];
-        }
+    for (int n = 0; n < part.points; n++) {
+      for (int d = 0; d < 3; d++) {
+        part.v[n][d] -= center[d];
       }
+    }
 
-      t1 = QString("5 %1 "
-                   "%2 %3 %4 "
-                   "%5 %6 %7 "
-                   "%8 %9 %10 "
-                   "%11 %12 %13")
-                     .arg(tokens[1])
-                     .arg( v[0][0]) .arg( v[0][1]) .arg( v[0][2])
-                     .arg( v[1][0]) .arg( v[1][1]) .arg( v[1][2])
-                     .arg( v[2][0]) .arg( v[2][1]) .arg( v[2][2])
-                     .arg( v[3][0]) .arg( v[3][1]) .arg( v[3][2]);
-      parts[i] = t1;
+    if (part.type == 1) {
+      rotateMatrix(part.pm,rm);
     }
+
+    parts[i] = part.format();
   }
   return 0;
 }
@@ -633,10 +560,15 @@ int Render::splitIMParts(const QStringList &rotatedParts,
    for (int i = 0; i < rotatedParts.size(); i++) {
      QString line = rotatedParts[i];
 
-     isFadeMeta = line.contains(reFadeMeta);
-     isColComment = line.contains(reColComment);
-     isCustColour = line.contains(reCustColour);
-     isHeaderMeta = isHeader(line);
+     // all of these metas start with 0, skip the patterns for part and geometry lines
+     if (line.startsWith(QLatin1Char('0'))) {
+         isFadeMeta = line.contains(reFadeMeta);
+         isColComment = line.contains(reColComment);
+         isCustColour = line.contains(reCustColour);
+         isHeaderMeta = isHeader(line);
+     } else {
+         isFadeMeta = isColComment = isCustColour = isHeaderMeta = false;
+     }
 
      // Headers
      if (isHeaderMeta || (!isPrevSteps && !isCurrStep && !isFadeMeta && !isColComment)) {
@@ -34,53 +34,7 @@
 
 #include "rx.h"
 
-#include <QString>
-
 #include <QStringList>
 
 
-//  30/11/2014 Generating "multiple definition of split" compile error:
-inline void split(const QString &line, QStringList &argv)
-
-{
-
-  QString     chopped = line;
-
-
-
-  while (chopped[0] == ' ') {
-
-    chopped.remove(0,1);
-
-  }
-
-  argv << chopped.split(" ",QString::SkipEmptyParts);
-
-
-
-  if (argv.size() >= 2 && argv[0] == "0" && argv[1] == "GHOST") {
-
-    chopped.remove(0,2);
-
-    while (chopped[0] == ' ') {
-
-      chopped.remove(0,1);
-
-    }
-
-    argv.removeFirst();
-
-    chopped.remove(0,6);
-
-    while (chopped[0] == ' ') {
-
-      chopped.remove(0,1);
-
-    }
-
-    argv.removeFirst();
-
-  }
-
-}
 
@@ -38,16 +38,10 @@
 
 
 
-class QString;
-
 class QStringList;
 
 
 
-void split(const QString &line,QStringList &argv);
-
-
-
 extern QStringList LDrawHeaderRx;
 
 
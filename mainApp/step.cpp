@@ -35,6 +35,7 @@
 #include "range.h"
 #include "ranges.h"
 #include "render.h"
+#include "imagecache.h"
 #include "calloutbackgrounditem.h"
 #include "csiannotation.h"
 #include "pointer.h"
@@ -44,6 +45,7 @@
 #include "dependencies.h"
 #include "paths.h"
 #include "ldrawfiles.h"
+#include "tracer.h"
 #include <LDVQt/LDVImageMatte.h>
 
 /*********************************************************************
@@ -222,6 +224,7 @@ int Step::createCsi(
     Meta              &meta,
     bool               bfxLoad)   // Bfx load special case (no parts added)
 {
+  LPUB_TRACE_SPAN("Step::createCsi");
   bool csiExist       = false;
   bool nativeRenderer = Preferences::usingNativeRenderer;
   int  nType          = NTypeDefault;
@@ -407,6 +410,8 @@ int Step::createCsi(
                                                     .arg(pngName));
              pngName = QString(":/resources/missingimage.png");
              rc = -1;
+         } else {
+             ImageCache::remove(pngName);
          }
      }
 
@@ -433,12 +438,19 @@ int Step::createCsi(
 
   // If not using LDView SCall, populate pixmap
   if (! renderer->useLDViewSCall()) {
-      pixmap->load(pngName);
-      csiPlacement.size[0] = pixmap->width();
-      csiPlacement.size[1] = pixmap->height();
-      if (! gui->exportingObjects()) {
-         viewerOptions.ImageWidth  = pixmap->width();
-         viewerOptions.ImageHeight = pixmap->height();
+      if (gui->exportingObjects()) {
+          // exported pages are only laid out and never painted, so take the
+          // size from the image header and leave the pixmap unallocated
+          const QSize size = ImageCache::size(pngName);
+          *pixmap = QPixmap();
+          csiPlacement.size[0] = size.width();
+          csiPlacement.size[1] = size.height();
+      } else {
+          ImageCache::load(pngName, *pixmap);
+          csiPlacement.size[0] = pixmap->width();
+          csiPlacement.size[1] = pixmap->height();
+          viewerOptions.ImageWidth  = pixmap->width();
+          viewerOptions.ImageHeight = pixmap->height();
       }
   }
 
@@ -30,6 +30,7 @@
 #include "callout.h"
 #include "resolution.h"
 #include "render.h"
+#include "imagecache.h"
 #include "paths.h"
 #include "ldrawfiles.h"
 #include "placementdialog.h"
@@ -345,6 +346,8 @@ int SubModel::createSubModelImage(
                                                  .arg(gui->stepPageNum));
           imageName = QString(":/resources/missingimage.png");
           rc = -1;
+      } else {
+          ImageCache::remove(imageName);
       }
 
       if (!rc) {
@@ -361,7 +364,7 @@ int SubModel::createSubModelImage(
       }
   }
 
-  pixmap->load(imageName);
+  ImageCache::load(imageName, *pixmap);
 
   if (! gui->exportingObjects()) {
       viewerOptions.ImageWidth = pixmap->width();
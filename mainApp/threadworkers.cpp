@@ -69,7 +69,7 @@ void PartWorker::ldsearchDirPreferences(){
   if (!_resetSearchDirSettings && !Preferences::lpub3dLoaded) {
       emit Application::instance()->splashMsgSig("50% - Search directory preferences loading...");
     } else {
-      emit gui->messageSig(LOG_INFO,"Reset search directories...");
+      emitMessage(LOG_INFO,"Reset search directories...");
     }
 
   QSettings Settings;
@@ -100,7 +100,7 @@ void PartWorker::ldsearchDirPreferences(){
           //qDebug() << QString(tr("  -Failed to get LDraw.ini, valid file (from Preferences) does not exist."));
         }
     } else {
-      emit gui->messageSig(LOG_INFO, QString("Unable to initialize LDrawINI. Using default search directories."));
+      emitMessage(LOG_INFO, QString("Unable to initialize LDrawINI. Using default search directories."));
     }
 
   if (!doFadeStep() && !doHighlightStep()) {
@@ -110,13 +110,13 @@ void PartWorker::ldsearchDirPreferences(){
       Paths::mkCustomDirs();
   }
 
-  emit gui->messageSig(LOG_INFO,(doFadeStep() ? QString("Fade Previous Steps is ON.") : QString("Fade Previous Steps is OFF.")));
-  emit gui->messageSig(LOG_INFO,(doHighlightStep() ? QString("Highlight Current Step is ON.") : QString("Highlight Current Step is OFF.")));
+  emitMessage(LOG_INFO,(doFadeStep() ? QString("Fade Previous Steps is ON.") : QString("Fade Previous Steps is OFF.")));
+  emitMessage(LOG_INFO,(doHighlightStep() ? QString("Highlight Current Step is ON.") : QString("Highlight Current Step is OFF.")));
 
   // LDrawINI not found and not reset so load registry key
   if (!Preferences::ldrawiniFound && !_resetSearchDirSettings &&
       Settings.contains(QString("%1/%2").arg(SETTINGS,_ldSearchDirsKey))) {
-      emit gui->messageSig(LOG_INFO, QString("LDrawINI not found, loading LDSearch directories from registry key..."));
+      emitMessage(LOG_INFO, QString("LDrawINI not found, loading LDSearch directories from registry key..."));
       QStringList searchDirs = Settings.value(QString("%1/%2").arg(SETTINGS,_ldSearchDirsKey)).toStringList();
       bool customDirsIncluded = false;
       foreach (QString searchDir, searchDirs) {
@@ -132,9 +132,9 @@ void PartWorker::ldsearchDirPreferences(){
                                         customDir.toLower() == _customPrimDir.toLower());
                 }
               Preferences::ldSearchDirs << searchDir;
-              emit gui->messageSig(LOG_INFO, QString("Add search directory: %1").arg(searchDir));
+              emitMessage(LOG_INFO, QString("Add search directory: %1").arg(searchDir));
           } else {
-              emit gui->messageSig(LOG_INFO, QString("Search directory is empty and will be ignored: %1").arg(searchDir));
+              emitMessage(LOG_INFO, QString("Search directory is empty and will be ignored: %1").arg(searchDir));
           }
       }
       // If fade step enabled but custom directories not defined in ldSearchDirs, add custom directories
@@ -142,24 +142,24 @@ void PartWorker::ldsearchDirPreferences(){
           // We must force the custom directories for LDView as they are needed by ldview ini files
           if (Preferences::preferredRenderer == RENDERER_LDVIEW) {
               Preferences::ldSearchDirs << _customPartDir;
-              emit gui->messageSig(LOG_INFO, QString("Add custom part directory: %1").arg(_customPartDir));
+              emitMessage(LOG_INFO, QString("Add custom part directory: %1").arg(_customPartDir));
               Preferences::ldSearchDirs << _customPrimDir;
-              emit gui->messageSig(LOG_INFO, QString("Add custom primitive directory %1").arg(_customPrimDir));
+              emitMessage(LOG_INFO, QString("Add custom primitive directory %1").arg(_customPrimDir));
               customDirsIncluded = true;
           } else {
               if (QDir(_customPartDir).entryInfoList(QDir::Files|QDir::NoSymLinks).count() > 0) {
                 Preferences::ldSearchDirs << _customPartDir;
                 customDirsIncluded = true;
-                emit gui->messageSig(LOG_INFO, QString("Add custom part directory: %1").arg(_customPartDir));
+                emitMessage(LOG_INFO, QString("Add custom part directory: %1").arg(_customPartDir));
               } else {
-                emit gui->messageSig(LOG_INFO, QString("Custom part directory is empty and will be ignored: %1").arg(_customPartDir));
+                emitMessage(LOG_INFO, QString("Custom part directory is empty and will be ignored: %1").arg(_customPartDir));
               }
               if (QDir(_customPrimDir).entryInfoList(QDir::Files|QDir::NoSymLinks).count() > 0) {
                 Preferences::ldSearchDirs << _customPrimDir;
                 customDirsIncluded = true;
-                emit gui->messageSig(LOG_INFO, QString("Add custom primitive directory: %1").arg(_customPrimDir));
+                emitMessage(LOG_INFO, QString("Add custom primitive directory: %1").arg(_customPrimDir));
               } else {
-                emit gui->messageSig(LOG_INFO, QString("Custom primitive directory is empty and will be ignored: %1").arg(_customPrimDir));
+                emitMessage(LOG_INFO, QString("Custom primitive directory is empty and will be ignored: %1").arg(_customPrimDir));
               }
           }
           // update the registry if custom directory included
@@ -169,7 +169,7 @@ void PartWorker::ldsearchDirPreferences(){
        }
     } else if (loadLDrawSearchDirs()){                                        //ldraw.ini found or reset so load local paths
       Settings.setValue(QString("%1/%2").arg(SETTINGS,_ldSearchDirsKey), Preferences::ldSearchDirs);
-      emit gui->messageSig(LOG_INFO, QString("Loading LDraw parts search directories..."));
+      emitMessage(LOG_INFO, QString("Loading LDraw parts search directories..."));
     } else {
       Settings.remove(QString("%1/%2").arg(SETTINGS,_ldSearchDirsKey));
       emit gui->messageSig(LOG_ERROR, QString("Unable to load search directories."));
@@ -205,7 +205,7 @@ bool PartWorker::loadLDrawSearchDirs(){
   if (!_resetSearchDirSettings) {
       emit Application::instance()->splashMsgSig("60% - Search directories loading...");
     } else {
-      emit gui->messageSig(LOG_INFO,"Reset - search directories loading...");
+      emitMessage(LOG_INFO,"Reset - search directories loading...");
     }
 
   setDoFadeStep(gui->page.meta.LPub.fadeStep.fadeStep.value());
@@ -240,7 +240,7 @@ bool PartWorker::loadLDrawSearchDirs(){
               // check if empty
               if (QDir(ldrawSearchDir).entryInfoList(QDir::Files|QDir::NoSymLinks).count() > 0) {
                   Preferences::ldSearchDirs << ldrawSearchDir;
-                  emit gui->messageSig(LOG_INFO, QString("Add search directory: %1").arg(ldrawSearchDir));
+                  emitMessage(LOG_INFO, QString("Add search directory: %1").arg(ldrawSearchDir));
                 }
             }
           // Check if custom directories included
@@ -253,15 +253,15 @@ bool PartWorker::loadLDrawSearchDirs(){
       if ((doFadeStep() || doHighlightStep()) && !customDirsIncluded) {
           if (QDir(_customPartDir).entryInfoList(QDir::Files|QDir::NoSymLinks).count() > 0) {
               Preferences::ldSearchDirs << _customPartDir;
-              emit gui->messageSig(LOG_INFO, QString("Add custom part directory: %1").arg(_customPartDir));
+              emitMessage(LOG_INFO, QString("Add custom part directory: %1").arg(_customPartDir));
             } else {
-              emit gui->messageSig(LOG_INFO, QString("Custom part directory is empty and will be ignored: %1").arg(_customPartDir));
+              emitMessage(LOG_INFO, QString("Custom part directory is empty and will be ignored: %1").arg(_customPartDir));
             }
           if (QDir(_customPrimDir).entryInfoList(QDir::Files|QDir::NoSymLinks).count() > 0) {
               Preferences::ldSearchDirs << _customPrimDir;
-              emit gui->messageSig(LOG_INFO, QString("Add custom primitive directory: %1").arg(_customPrimDir));
+              emitMessage(LOG_INFO, QString("Add custom primitive directory: %1").arg(_customPrimDir));
             } else {
-              emit gui->messageSig(LOG_INFO, QString("Custom primitive directory is empty and will be ignored: %1").arg(_customPrimDir));
+              emitMessage(LOG_INFO, QString("Custom primitive directory is empty and will be ignored: %1").arg(_customPrimDir));
             }
         }
       // Add subdirectories from Unofficial root directory
@@ -288,7 +288,7 @@ bool PartWorker::loadLDrawSearchDirs(){
                       // check if empty
                       if (QDir(unofficialSubDir).entryInfoList(QDir::Files|QDir::NoSymLinks).count() > 0) {
                           Preferences::ldSearchDirs << unofficialSubDir;
-                          emit gui->messageSig(LOG_INFO, QString("Add search directory: %1").arg(unofficialSubDir));
+                          emitMessage(LOG_INFO, QString("Add search directory: %1").arg(unofficialSubDir));
                         } else if (QDir(unofficialSubDir).entryInfoList(QDir::Dirs|QDir::NoSymLinks).count() > 0) {
                           QDir subSubDir(unofficialSubDir);
                           QStringList subSubDirs = subSubDir.entryList(QDir::NoDotAndDotDot | QDir::Dirs, QDir::SortByMask);
@@ -296,13 +296,13 @@ bool PartWorker::loadLDrawSearchDirs(){
                               QString unofficialSubSubDir = QDir::toNativeSeparators(QString("%1/%2").arg(unofficialSubDir).arg(subSubDirName));
                               if (QDir(unofficialSubSubDir).entryInfoList(QDir::Files|QDir::NoSymLinks).count() > 0) {
                                   Preferences::ldSearchDirs << unofficialSubSubDir;
-                                  emit gui->messageSig(LOG_INFO, QString("Add search directory: %1").arg(unofficialSubSubDir));
+                                  emitMessage(LOG_INFO, QString("Add search directory: %1").arg(unofficialSubSubDir));
                                 } else {
-                                  emit gui->messageSig(LOG_INFO, QString("Search directory is empty and will be ignored: %1").arg( unofficialSubSubDir));
+                                  emitMessage(LOG_INFO, QString("Search directory is empty and will be ignored: %1").arg( unofficialSubSubDir));
                                 }
                             }
                         } else {
-                          emit gui->messageSig(LOG_INFO, QString("Search directory is empty and will be ignored: %1").arg( unofficialSubDir));
+                          emitMessage(LOG_INFO, QString("Search directory is empty and will be ignored: %1").arg( unofficialSubDir));
                         }
                     }
                 }
@@ -332,7 +332,7 @@ void PartWorker::populateLdgLiteSearchDirs() {
 #ifdef QT_DEBUG_MODE
         //logDebug() << "SEARCH DIRECTORIES TO PROCESS" << Preferences::ldSearchDirs ;
 #endif
-        emit gui->messageSig(LOG_INFO, QString("LDGlite Search Directories..."));
+        emitMessage(LOG_INFO, QString("LDGlite Search Directories..."));
 
         // Define excluded directories
         QStringList ldgliteExcludedDirs = _excludedSearchDirs;
@@ -360,9 +360,9 @@ void PartWorker::populateLdgLiteSearchDirs() {
                     count++;
                     count > 1 ? Preferences::ldgliteSearchDirs.append(QString("|%1").arg(ldgliteSearchDir)):
                                 Preferences::ldgliteSearchDirs.append(ldgliteSearchDir);
-                    emit gui->messageSig(LOG_INFO, QString("Add ldglite search directory: %1").arg(ldgliteSearchDir));
+                    emitMessage(LOG_INFO, QString("Add ldglite search directory: %1").arg(ldgliteSearchDir));
                 }else {
-                    emit gui->messageSig(LOG_INFO, QString("Ldglite search directory is empty and will be ignored: %1").arg(ldgliteSearchDir));
+                    emitMessage(LOG_INFO, QString("Ldglite search directory is empty and will be ignored: %1").arg(ldgliteSearchDir));
                 }
             }
         }
@@ -503,7 +503,8 @@ void PartWorker::processCustomColourParts(PartType partType, bool overwriteCusto
       QString subFileString = ldrawFile._subFileOrder[i].toLower();
       contents = ldrawFile.contents(subFileString);
       //emit progressSetValueSig(i);
-      emit gui->messageSig(LOG_INFO,QString("00 PROCESSING SUBFILE CUSTOM COLOR PARTS: %1").arg(subFileString));
+      if (Gui::messageEnabled(LOG_INFO))
+          emit gui->messageSig(LOG_INFO,QString("00 PROCESSING SUBFILE CUSTOM COLOR PARTS: %1").arg(subFileString));
       for (int i = 0; i < contents.size() && endThreadNotRequested(); i++) {
           QString line = contents[i];
           QStringList tokens;
@@ -661,7 +662,7 @@ void PartWorker::processCustomColourParts(PartType partType, bool overwriteCusto
 
   //emit progressStatusRemoveSig();
   emit customColourFinishedSig();
-  emit gui->messageSig(LOG_INFO,fileStatus);
+  emitMessage(LOG_INFO,fileStatus);
 }
 
 bool PartWorker::processColourParts(const QStringList &colourPartList, const PartType partType) {
@@ -846,7 +847,7 @@ bool PartWorker::processColourParts(const QStringList &colourPartList, const Par
     QString message = QString("%1 Color %2 content processed.")
         .arg(partsProcessed)
         .arg(partsProcessed > 1 ? "parts" : "part");
-    emit gui->messageSig(LOG_INFO,message);
+    emitMessage(LOG_INFO,message);
 
     return true;
 }
@@ -1174,7 +1175,7 @@ bool PartWorker::processPartsArchive(const QStringList &ldPartsDirs, const QStri
   }
   QString returnMessage = QString("Archiving %1 parts to : %2.").arg(comment,archiveFile);
   int returnMessageSeverity = 1; // 1=Error, 2=Notice
-  emit gui->messageSig(LOG_INFO,QString("Archiving %1 parts to %2.").arg(comment,archiveFile));
+  emitMessage(LOG_INFO,QString("Archiving %1 parts to %2.").arg(comment,archiveFile));
 
   if (okToEmitToProgressBar()) {
       //emit progressResetSig();
@@ -1211,7 +1212,7 @@ bool PartWorker::processPartsArchive(const QStringList &ldPartsDirs, const QStri
          if (returnMessageSeverity == 1)
              emit gui->messageSig(LOG_ERROR,returnMessage);
          else
-             emit gui->messageSig(LOG_NOTICE,returnMessage);
+             emitMessage(LOG_NOTICE,returnMessage);
          continue;
       }
       bool ok;
@@ -1224,9 +1225,9 @@ bool PartWorker::processPartsArchive(const QStringList &ldPartsDirs, const QStri
                                           tr("[Total %1] parts").arg(totalPartCount);
 
       }
-      emit gui->messageSig(LOG_INFO,tr("Archived %1 %2 from %3. %4")
-                                       .arg(partCount).arg(summary).arg(partDir.absolutePath())
-                                       .arg(gui->elapsedTime(t.elapsed())));
+      emitMessage(LOG_INFO,tr("Archived %1 %2 from %3. %4")
+                              .arg(partCount).arg(summary).arg(partDir.absolutePath())
+                              .arg(gui->elapsedTime(t.elapsed())));
   }
 
   // Archive parts
@@ -1256,7 +1257,7 @@ bool PartWorker::processPartsArchive(const QStringList &ldPartsDirs, const QStri
                          .arg(Preferences::validLDrawLibrary).arg(comment);
       _partsArchived = false;
   }
-  emit gui->messageSig(LOG_INFO,returnMessage);
+  emitMessage(LOG_INFO,returnMessage);
 
   if (!okToEmitToProgressBar()) {
       emit Application::instance()->splashMsgSig(tr("70% - Finished archiving %1 parts.").arg(comment));
@@ -0,0 +1,163 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Trevor SANDY. All rights reserved.
+**
+** This file may be used under the terms of the
+** GNU General Public License (GPL) version 3.0
+** which accompanies this distribution, and is
+** available at http://www.gnu.org/licenses/gpl.html
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include "tracer.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QTextStream>
+#include <QThread>
+
+#include <atomic>
+#include <vector>
+
+// Spans kept per thread; older spans are overwritten once a thread wraps
+#define TRACE_RING_SIZE 65536
+
+namespace {
+
+struct TraceEvent
+{
+  const char *name;
+  qint64      start;
+  qint64      end;
+};
+
+struct TraceBuffer
+{
+  TraceBuffer(int id, const QString &threadName)
+    : id(id), threadName(threadName), count(0), events(TRACE_RING_SIZE)
+  {
+  }
+
+  int                     id;
+  QString                 threadName;
+  std::atomic<quint64>    count;
+  std::vector<TraceEvent> events;
+};
+
+QElapsedTimer              traceClock;
+QMutex                     traceMutex;
+std::vector<TraceBuffer *> traceBuffers;
+
+TraceBuffer *threadBuffer()
+{
+  static thread_local TraceBuffer *buffer = nullptr;
+
+  if (!buffer) {
+    QMutexLocker locker(&traceMutex);
+    QThread *thread = QThread::currentThread();
+    QString threadName = thread ? thread->objectName() : QString();
+    if (threadName.isEmpty())
+      threadName = thread && QCoreApplication::instance() &&
+                   thread == QCoreApplication::instance()->thread() ?
+                     QString("Main") : QString("Worker %1").arg(traceBuffers.size());
+    buffer = new TraceBuffer(int(traceBuffers.size()) + 1, threadName);
+    traceBuffers.push_back(buffer);
+  }
+
+  return buffer;
+}
+
+QString jsonEscape(const QString &value)
+{
+  QString escaped;
+  escaped.reserve(value.size());
+  for (QChar c : value) {
+    if (c == '"' || c == '\\')
+      escaped += '\\';
+    if (c.unicode() < 0x20)
+      escaped += QString("\\u%1").arg(int(c.unicode()), 4, 16, QChar('0'));
+    else
+      escaped += c;
+  }
+  return escaped;
+}
+
+} // namespace
+
+std::atomic<bool> Tracer::_enabled(false);
+QString           Tracer::_fileName;
+
+void Tracer::start(const QString &fileName)
+{
+  _fileName = fileName;
+  traceClock.start();
+  // publish the started clock to the threads that see tracing enabled
+  _enabled.store(true, std::memory_order_release);
+}
+
+qint64 Tracer::now()
+{
+  return traceClock.nsecsElapsed();
+}
+
+void Tracer::record(const char *name, qint64 start, qint64 end)
+{
+  TraceBuffer *buffer = threadBuffer();
+  const quint64 index = buffer->count.load(std::memory_order_relaxed);
+  TraceEvent &event = buffer->events[index % TRACE_RING_SIZE];
+  event.name  = name;
+  event.start = start;
+  event.end   = end;
+  buffer->count.store(index + 1, std::memory_order_release);
+}
+
+/*
+ * Write the collected spans as Chrome trace-event JSON.
+ * Spans are emitted as complete ("X") events in microseconds; nesting is
+ * reconstructed by the viewer from the start and duration on each thread.
+ */
+bool Tracer::finish()
+{
+  if (!_enabled.exchange(false, std::memory_order_acq_rel))
+    return false;
+
+  QFile file(_fileName);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    return false;
+
+  QTextStream out(&file);
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+  const qint64 pid = QCoreApplication::applicationPid();
+  bool first = true;
+
+  QMutexLocker locker(&traceMutex);
+  for (const TraceBuffer *buffer : traceBuffers) {
+    out << (first ? "" : ",")
+        << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+        << ",\"tid\":" << buffer->id
+        << ",\"args\":{\"name\":\"" << jsonEscape(buffer->threadName) << "\"}}";
+    first = false;
+
+    const quint64 count = buffer->count.load(std::memory_order_acquire);
+    const quint64 begin = count > TRACE_RING_SIZE ? count - TRACE_RING_SIZE : 0;
+    for (quint64 i = begin; i < count; i++) {
+      const TraceEvent &event = buffer->events[i % TRACE_RING_SIZE];
+      out << ",\n{\"name\":\"" << event.name
+          << "\",\"cat\":\"lpub\",\"ph\":\"X\",\"pid\":" << pid
+          << ",\"tid\":" << buffer->id
+          << ",\"ts\":" << QString::number(double(event.start) / 1000.0, 'f', 3)
+          << ",\"dur\":" << QString::number(double(event.end - event.start) / 1000.0, 'f', 3)
+          << "}";
+    }
+  }
+
+  out << "\n]}\n";
+  return out.status() == QTextStream::Ok;
+}
@@ -0,0 +1,87 @@
+/****************************************************************************
+**
+** Copyright (C) 2026 Trevor SANDY. All rights reserved.
+**
+** This file may be used under the terms of the
+** GNU General Public License (GPL) version 3.0
+** which accompanies this distribution, and is
+** available at http://www.gnu.org/licenses/gpl.html
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+/****************************************************************************
+ *
+ * Scoped span tracer for the page build pipeline.
+ *
+ * Each thread records completed spans into its own fixed size ring buffer so
+ * recording never takes a lock. Tracing is off until Tracer::start() is
+ * called (see the --trace-file command line option) and the collected spans
+ * are written as Chrome trace-event JSON by Tracer::finish(), which can be
+ * loaded in chrome://tracing or Perfetto.
+ *
+ * Build with CONFIG+=notrace to compile every LPUB_TRACE_SPAN out.
+ *
+ ***************************************************************************/
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <QString>
+#include <QtGlobal>
+
+#include <atomic>
+
+class Tracer
+{
+public:
+  static void start(const QString &fileName);
+  static bool finish();
+
+  static bool enabled()
+  {
+    return _enabled.load(std::memory_order_acquire);
+  }
+
+  static qint64 now();
+  static void record(const char *name, qint64 start, qint64 end);
+
+private:
+  static std::atomic<bool> _enabled;
+  static QString           _fileName;
+};
+
+class TraceSpan
+{
+public:
+  explicit TraceSpan(const char *name)
+    : _name(name),
+      _start(Tracer::enabled() ? Tracer::now() : -1)
+  {
+  }
+  ~TraceSpan()
+  {
+    if (_start >= 0)
+      Tracer::record(_name, _start, Tracer::now());
+  }
+
+private:
+  TraceSpan(const TraceSpan &);
+  TraceSpan &operator=(const TraceSpan &);
+
+  const char *_name;
+  qint64      _start;
+};
+
+#define LPUB_TRACE_CONCAT_(a, b) a##b
+#define LPUB_TRACE_CONCAT(a, b)  LPUB_TRACE_CONCAT_(a, b)
+
+#ifdef LPUB_NO_TRACE
+#define LPUB_TRACE_SPAN(name) do { } while (0)
+#else
+#define LPUB_TRACE_SPAN(name) TraceSpan LPUB_TRACE_CONCAT(traceSpan, __LINE__)(name)
+#endif
+
+#endif // TRACER_H
@@ -37,6 +37,7 @@
 #include <QString>
 #include <QFileInfo>
 #include "lpub_preferences.h"
+#include "tracer.h"
 #include "ranges.h"
 #include "callout.h"
 #include "pointer.h"
@@ -182,13 +183,10 @@ static void remove_parttype(
 
   for (int i = 0; i < in.size(); i++) {
       QString line = in.at(i);
-      QStringList tokens;
-
-      split(line,tokens);
+      LDrawTokens tokens(line);
 
       if (tokens.size() == 15 && tokens[0] == "1") {
-          QString type = tokens[14].toLower();
-          if (type != model) {
+          if (tokens[14].compare(model, Qt::CaseInsensitive) != 0) {
               out << line;
             }
         } else {
@@ -214,18 +212,15 @@ static void remove_partname(
 
   for (int i = 0; i < in.size(); i++) {
       QString line = in.at(i);
-      QStringList tokens;
-
-      split(line,tokens);
+      LDrawTokens tokens(line);
 
       if (tokens.size() == 4 && tokens[0] == "0" &&
           tokens[1] == "LPUB" &&
           tokens[2] == "NAME") {
-          QString type = tokens[3].toLower();
-          if (type == name) {
+          if (tokens[3].compare(name, Qt::CaseInsensitive) == 0) {
               for ( ; i < in.size(); i++) {
                   line = in.at(i);
-                  split(line,tokens);
+                  tokens.tokenize(line);
                   if (tokens.size() == 15 && tokens[0] == "1") {
                       break;
                     } else {
@@ -403,13 +398,14 @@ int Gui::drawPage(
     bool            assembledCallout,
     bool            calledOut)
 {
+  LPUB_TRACE_SPAN("Gui::drawPage");
   QStringList saveCsiParts;
   bool     global = true;
   QString  line, csiName;
   Callout *callout         = nullptr;
   Range   *range           = nullptr;
   Step    *step            = nullptr;
-  int      numLines        = ldrawFile.size(current.modelName);
+  int      numLines        = ldrawFile.size(current);
   bool     pliIgnore       = false;
   bool     partIgnore      = false;
   bool     synthBegin      = false;
@@ -484,7 +480,8 @@ int Gui::drawPage(
       steps->meta.LPub.page.pageFooter.size.setValue(0,pW);
     }
 
-  emit messageSig(LOG_INFO, "Processing draw page for " + current.modelName + "...");
+  if (messageEnabled(LOG_INFO))
+    emit messageSig(LOG_INFO, "Processing draw page for " + current.modelName + "...");
 
   /*
    * do until end of page
@@ -510,7 +507,7 @@ int Gui::drawPage(
 
           // read the line from the ldrawFile db
 
-          line = ldrawFile.readLine(current.modelName,current.lineNumber);
+          line = ldrawFile.readLine(current);
           split(line,tokens);
         }
 
@@ -643,7 +640,7 @@ int Gui::drawPage(
                   Where walk = current;
                   for (++walk; walk < numLines; ++walk) {
                       QStringList tokens;
-                      QString scanLine = ldrawFile.readLine(walk.modelName,walk.lineNumber);
+                      QString scanLine = ldrawFile.readLine(walk);
                       split(scanLine,tokens);
                       if (tokens.size() > 0 && tokens[0] == "0") {
                           Rc rc = tmpMeta.parse(scanLine,walk,false);
@@ -1432,7 +1429,8 @@ int Gui::drawPage(
                       range->append(step);
                     }
 
-                  emit messageSig(LOG_INFO, "Processing CSI bfx load special case for " + topOfStep.modelName + "...");
+                  if (messageEnabled(LOG_INFO))
+                    emit messageSig(LOG_INFO, "Processing CSI bfx load special case for " + topOfStep.modelName + "...");
                   csiName = step->csiName();
                   (void) step->createCsi(
                         isMirrored ? addLine : "1 color 0 0 0 1 0 0 0 1 0 0 0 1 foo.ldr",
@@ -1506,13 +1504,15 @@ int Gui::drawPage(
                           pliParts.clear();
                           pliPartGroups.clear();
 
-                          emit messageSig(LOG_INFO, "Add step PLI for " + topOfStep.modelName + "...");
+                          if (messageEnabled(LOG_INFO))
+                            emit messageSig(LOG_INFO, "Add step PLI for " + topOfStep.modelName + "...");
 
                           step->pli.sizePli(&steps->meta,relativeType,pliPerStep);
                       }
 
                       if (step->placeSubModel){
-                          emit messageSig(LOG_INFO, "Set first step submodel display for " + topOfStep.modelName + "...");
+                          if (messageEnabled(LOG_INFO))
+                            emit messageSig(LOG_INFO, "Set first step submodel display for " + topOfStep.modelName + "...");
 
                           // get the number of submodel instances in the model file
                           int countInstanceOverride = steps->meta.LPub.page.countInstanceOverride.value();
@@ -1667,13 +1667,15 @@ int Gui::drawPage(
                               pliParts.clear();
                               pliPartGroups.clear();
 
-                              emit messageSig(LOG_INFO, "Add PLI images for single-step page...");
+                              if (messageEnabled(LOG_INFO))
+                                emit messageSig(LOG_INFO, "Add PLI images for single-step page...");
 
                               step->pli.sizePli(&steps->meta,relativeType,pliPerStep);
                           }
                       }
 
-                      emit messageSig(LOG_INFO, "Add CSI image for single-step page...");
+                      if (messageEnabled(LOG_INFO))
+                        emit messageSig(LOG_INFO, "Add CSI image for single-step page...");
 
                       if (renderer->useLDViewSCall() && ldrStepFiles.size() > 0){
 
@@ -1782,7 +1784,7 @@ int Gui::drawPage(
       }
       /* if part is on excludedPart.lst, unset pliIgnore if still set */
       if (pliIgnore && tokens[0] == "1" &&
-          ExcludedParts::hasExcludedPart(tokens[tokens.size()-1])) {
+          ExcludedParts::lineHasExcludedPart(tokens)) {
           pliIgnore = false;
       }
     } // for every line
@@ -1805,6 +1807,7 @@ int Gui::findPage(
     int             renderStepNumber,
     QString         renderParentModel)
 {
+  LPUB_TRACE_SPAN("Gui::findPage");
   bool stepGroup  = false;
   bool partIgnore = false;
   bool coverPage  = false;
@@ -1846,7 +1849,7 @@ int Gui::findPage(
   QHash<QString, QStringList> saveBfx;
   QList<PliPartGroupMeta> emptyPartGroups;
 
-  int numLines = ldrawFile.size(current.modelName);
+  int numLines = ldrawFile.size(current);
 
   int  countInstances = meta.LPub.countInstance.value();
 
@@ -1865,24 +1868,26 @@ int Gui::findPage(
       // scan through the rest of the model counting pages
       // if we've already hit the display page, then do as little as possible
 
-      QString line = ldrawFile.readLine(current.modelName,current.lineNumber).trimmed();
+      QString line = ldrawFile.readLine(current).trimmed();
 
       if (line.startsWith("0 GHOST ")) {
           line = line.mid(8).trimmed();
       }
 
-      QStringList tokens, addTokens;
+      LDrawTokens token;
 
       switch (line.toLatin1()[0]) {
       case '1':
-          split(line,tokens);
+          token.tokenize(line);
 
-          if (tokens.size() > 2 && tokens[1] == "16") {
-              split(addLine,addTokens);
+          if (token.size() > 2 && token[1] == "16") {
+              QStringList tokens = token.toStringList();
+              LDrawTokens addTokens(addLine);
               if (addTokens.size() == 15) {
-                  tokens[1] = addTokens[1];
+                  tokens[1] = addTokens.toString(1);
               }
               line = tokens.join(" ");
+              token.tokenize(line);
           }
 
           if (! partIgnore) {
@@ -1894,13 +1899,9 @@ int Gui::findPage(
               }
               lastStepPageNum = pageNum;
 
-              QStringList token;
-
-              split(line,token);
-
               if (token.size() == 15) {
 
-                  QString    type = token[token.size()-1];
+                  QString    type = token.toString(token.size()-1);
 
                   bool contains   = ldrawFile.isSubmodel(type);
                   CalloutBeginMeta::CalloutMode calloutMode = meta.LPub.callout.begin.value();
@@ -1912,7 +1913,7 @@ int Gui::findPage(
                       bool rendered = ldrawFile.rendered(type,ldrawFile.mirrored(token),current.modelName,stepNumber,countInstances);
 
                       // if the submodel was not rendered, and (is not in the buffer exchange call setRendered for the submodel.
-                      if (! rendered && (! bfxStore2 || ! bfxParts.contains(token[1]+type))) {
+                      if (! rendered && (! bfxStore2 || ! bfxParts.contains(token.toString(1)+type))) {
 
                           isMirrored = ldrawFile.mirrored(token);
 
@@ -1980,13 +1981,13 @@ int Gui::findPage(
                       }
                   }
                  if (bfxStore1) {
-                     bfxParts << token[1]+type;
+                     bfxParts << token.toString(1)+type;
                  }
               }
           } else if (partIgnore){
 
-              if (tokens.size() == 15){
-                  QString lineItem = tokens[tokens.size()-1];
+              if (token.size() == 15){
+                  QString lineItem = token.toString(token.size()-1);
 
                   if (ldrawFile.isSubmodel(lineItem)){
                       Where model(lineItem,0);
@@ -2451,11 +2452,37 @@ int Gui::findPage(
   return 0;
 }
 
+/*
+ * The BOM parts of a submodel depend only on the submodel and
+ * the colour of the line referencing it, so each submodel is
+ * traversed once per BOM and its parts are replayed for every
+ * further instance.
+ */
+struct BOMSubModelParts
+{
+  QStringList             parts;
+  QList<PliPartGroupMeta> partGroups;
+};
+
 int Gui::getBOMParts(
     Where        current,
     QString     &addLine,
     QStringList &pliParts,
     QList<PliPartGroupMeta> &bomPartGroups)
+{
+  QHash<QString, BOMSubModelParts> subModelParts;
+  bool cacheable = true;
+
+  return getBOMParts(current,addLine,pliParts,bomPartGroups,subModelParts,cacheable);
+}
+
+int Gui::getBOMParts(
+    Where        current,
+    QString     &addLine,
+    QStringList &pliParts,
+    QList<PliPartGroupMeta> &bomPartGroups,
+    QHash<QString, BOMSubModelParts> &subModelParts,
+    bool        &cacheable)
 {
   bool partIgnore = false;
   bool pliIgnore = false;
@@ -2466,6 +2493,7 @@ int Gui::getBOMParts(
   bool partsAdded = false;
   bool excludedPart = false;
   QStringList bfxParts;
+  QStringList token;
 
   Meta meta;
 
@@ -2473,7 +2501,7 @@ int Gui::getBOMParts(
 
   QHash<QString, QStringList> bfx;
 
-  int numLines = ldrawFile.size(current.modelName);
+  int numLines = ldrawFile.size(current);
 
   Rc rc;
 
@@ -2484,7 +2512,7 @@ int Gui::getBOMParts(
       // scan through the rest of the model counting pages
       // if we've already hit the display page, then do as little as possible
 
-      QString line = ldrawFile.readLine(current.modelName,current.lineNumber).trimmed();
+      QString line = ldrawFile.readLine(current).trimmed();
 
       if (line.startsWith("0 GHOST ")) {
           line = line.mid(8).trimmed();
@@ -2492,14 +2520,14 @@ int Gui::getBOMParts(
 
       switch (line.toLatin1()[0]) {
         case '1':
+          split(line,token);
+
           /* check if part is in excludedPart.lst*/
-          excludedPart = ExcludedParts::lineHasExcludedPart(line);
+          excludedPart = ExcludedParts::lineHasExcludedPart(token);
 
           if ( !excludedPart && ! partIgnore && ! pliIgnore && ! synthBegin) {
 
-              QStringList token,addToken;
-
-              split(line,token);
+              QStringList addToken;
 
               QString    type = token[token.size()-1];
 
@@ -2532,9 +2560,31 @@ int Gui::getBOMParts(
 
                   if (ldrawFile.isSubmodel(type)) {
 
-                      Where current2(type,0);
+                      QString subModelKey = QString("%1 %2").arg(type.toLower())
+                                                            .arg(token.size() == 15 ? token[1] : QString());
 
-                      getBOMParts(current2,line,pliParts,bomPartGroups);
+                      QHash<QString, BOMSubModelParts>::const_iterator it = subModelParts.constFind(subModelKey);
+                      if (it != subModelParts.constEnd()) {
+                          pliParts      << it.value().parts;
+                          bomPartGroups << it.value().partGroups;
+                        } else {
+                          int partsStart  = pliParts.size();
+                          int groupsStart = bomPartGroups.size();
+                          bool subModelCacheable = true;
+
+                          Where current2(type,0);
+
+                          getBOMParts(current2,line,pliParts,bomPartGroups,subModelParts,subModelCacheable);
+
+                          // remove metas rewrite parts collected before the submodel so those results are not replayed
+                          if (subModelCacheable) {
+                              BOMSubModelParts &entry = subModelParts[subModelKey];
+                              entry.parts      = pliParts.mid(partsStart);
+                              entry.partGroups = bomPartGroups.mid(groupsStart);
+                            } else {
+                              cacheable = false;
+                            }
+                        }
 
                     } else {
 
@@ -2655,6 +2705,7 @@ int Gui::getBOMParts(
             case RemovePartRc:
             case RemoveNameRc:
               {
+                cacheable = false;
                 QStringList newCSIParts;
                 if (rc == RemoveGroupRc) {
                     remove_group(pliParts,meta.LPub.remove.group.value(),newCSIParts);
@@ -2698,7 +2749,7 @@ int Gui::getBOMOccurrence(Where	current) {		// start at top of ldrawFile
 
   skipHeader(current);
 
-  int numLines        = ldrawFile.size(current.modelName);
+  int numLines        = ldrawFile.size(current);
   int occurrenceNum   = 0;
   boms                = 0;
   bomOccurrence       = 0;
@@ -2707,13 +2758,12 @@ int Gui::getBOMOccurrence(Where	current) {		// start at top of ldrawFile
   for ( ; current.lineNumber < numLines;
         current.lineNumber++) {
 
-      QString line = ldrawFile.readLine(current.modelName,current.lineNumber).trimmed();
+      QString line = ldrawFile.readLine(current).trimmed();
       switch (line.toLatin1()[0]) {
         case '1':
           {
-            QStringList token;
-            split(line,token);
-            QString type = token[token.size()-1];
+            LDrawTokens token(line);
+            QString type = token.toString(token.size()-1);
 
             if (ldrawFile.isSubmodel(type)) {
                 Where current2(type,0);
@@ -2747,7 +2797,7 @@ int Gui::getBOMOccurrence(Where	current) {		// start at top of ldrawFile
   if (occurrenceNum > 1) {
       // now set the bom occurrance based on our current position
       Where here = gui->topOfPages[gui->displayPageNum-1];
-      for (++here; here.lineNumber < ldrawFile.size(here.modelName); here++) {
+      for (++here; here.lineNumber < ldrawFile.size(here); here++) {
           QString line = gui->readLine(here);
           Meta meta;
           Rc rc;
@@ -2823,9 +2873,8 @@ void Gui::attitudeAdjustment()
            current.lineNumber < numLines;
            current.lineNumber++) {
 
-          QString line = ldrawFile.readLine(current.modelName,current.lineNumber);
-          QStringList argv;
-          split(line,argv);
+          QString line = ldrawFile.readLine(current);
+          LDrawTokens argv(line);
 
           if (argv.size() >= 4 &&
               argv[0] == "0" &&
@@ -2862,6 +2911,7 @@ void Gui::attitudeAdjustment()
 
 void Gui::countPages()
 {
+  LPUB_TRACE_SPAN("Gui::countPages");
   if (maxPages < 1) {
       writeToTmp();
       statusBarMsg("Counting");
@@ -2896,6 +2946,7 @@ void Gui::drawPage(
     LGraphicsScene *scene,
     bool            printing)
 {
+  LPUB_TRACE_SPAN("Gui::drawPage (page)");
   QApplication::setOverrideCursor(Qt::WaitCursor);
 
   ldrawFile.unrendered();
@@ -2937,12 +2988,15 @@ void Gui::drawPage(
   if (! exporting())
     setPageLineEdit->setText(string);
 
+  // write the page's console messages
+  flushStdOut();
+
   QApplication::restoreOverrideCursor();
 }
 
 void Gui::skipHeader(Where &current)
 {
-  int numLines = ldrawFile.size(current.modelName);
+  int numLines = ldrawFile.size(current);
   for ( ; current.lineNumber < numLines; current.lineNumber++) {
       QString line = gui->readLine(current);
       int p;
@@ -3041,6 +3095,7 @@ Where &Gui::bottomOfPage()
 void Gui::writeToTmp(const QString &fileName,
                      const QStringList &contents)
 {
+  LPUB_TRACE_SPAN("Gui::writeToTmp (file)");
   QString fname = QDir::toNativeSeparators(QDir::currentPath()) + QDir::separator() + Paths::tmpDir + QDir::separator() + fileName;
   QFileInfo fileInfo(fname);
   if(!fileInfo.dir().exists()) {
@@ -3057,9 +3112,8 @@ void Gui::writeToTmp(const QString &fileName,
 
       for (int i = 0; i < contents.size(); i++) {
           QString line = contents[i];
-          QStringList tokens;
+          LDrawTokens tokens(line);
 
-          split(line,tokens);
           if (tokens.size()) {
               if (tokens[0] != "0") {
                  csiParts << line;
@@ -3130,6 +3184,7 @@ void Gui::writeToTmp(const QString &fileName,
 
 void Gui::writeToTmp()
 {
+  LPUB_TRACE_SPAN("Gui::writeToTmp");
   if (Preferences::modeGUI && ! exporting()) {
       emit progressBarPermInitSig();
       emit progressPermRangeSig(1, ldrawFile._subFileOrder.size());
@@ -3161,7 +3216,8 @@ void Gui::writeToTmp()
       if (ldrawFile.changedSinceLastWrite(fileName)) {
           // write normal submodels...
           upToDate = false;
-          emit messageSig(LOG_INFO, "Writing submodel to temp directory: " + fileName + "...");
+          if (messageEnabled(LOG_INFO))
+            emit messageSig(LOG_INFO, "Writing submodel to temp directory: " + fileName + "...");
           writeToTmp(fileName,content);
 
           // capture file name extensions
@@ -3178,7 +3234,8 @@ void Gui::writeToTmp()
              }
 
             /* Faded version of submodels */
-            emit messageSig(LOG_INFO, "Writing fade submodels to temp directory: " + fileNameStr);
+            if (messageEnabled(LOG_INFO))
+              emit messageSig(LOG_INFO, "Writing fade submodels to temp directory: " + fileNameStr);
             configuredContent = configureModelSubFile(content, fadeColor, FADE_PART);
             writeToTmp(fileNameStr,configuredContent);
           }
@@ -3191,7 +3248,8 @@ void Gui::writeToTmp()
               fileNameStr = fileNameStr.replace("."+extension, QString("%1.%2").arg(HIGHLIGHT_SFX).arg(extension));
             }
             /* Highlighted version of submodels */
-            emit messageSig(LOG_INFO, "Writing highlight submodel to temp directory: " + fileNameStr);
+            if (messageEnabled(LOG_INFO))
+              emit messageSig(LOG_INFO, "Writing highlight submodel to temp directory: " + fileNameStr);
             configuredContent = configureModelSubFile(content, fadeColor, HIGHLIGHT_PART);
             writeToTmp(fileNameStr,configuredContent);
           }
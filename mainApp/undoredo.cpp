@@ -39,7 +39,7 @@ void Gui::appendLine(const Where &here, const QString &line, QUndoCommand *paren
 void Gui::replaceLine(const Where &here, const QString &line, QUndoCommand *parent)
 {
   if (ldrawFile.contains(here.modelName) && 
-      here.lineNumber < ldrawFile.size(here.modelName)) {
+      here.lineNumber < ldrawFile.size(here)) {
 
     undoStack->push(new ReplaceLineCommand(&ldrawFile,here,line,parent));
   }
@@ -48,14 +48,14 @@ void Gui::replaceLine(const Where &here, const QString &line, QUndoCommand *pare
 void Gui::deleteLine(const Where &here, QUndoCommand *parent)
 {
   if (ldrawFile.contains(here.modelName) && 
-      here.lineNumber < ldrawFile.size(here.modelName)) {
+      here.lineNumber < ldrawFile.size(here)) {
     undoStack->push(new DeleteLineCommand(&ldrawFile,here,parent));
   }
 }
 
 QString Gui::readLine(const Where &here)
 {
-  return ldrawFile.readLine(here.modelName,here.lineNumber);
+  return ldrawFile.readLine(here);
 }
 
 void Gui::beginMacro(QString name)
@@ -68,6 +68,33 @@ void Gui::endMacro()
 {
   undoStack->endMacro();
   --macroNesting;
+  requestDisplayPage();
+}
+
+/*
+ * Edits, macros, undo and redo share one debounced re-layout
+ * of the displayed page, so a macro or a burst of commands
+ * triggers a single drawPage. The whole page is redrawn:
+ * an edit can move steps across pages, so there is no
+ * narrower rebuild to fall back on.
+ */
+void Gui::requestDisplayPage()
+{
+  if (macroNesting > 0)
+    return;
+
+  if (Preferences::modeGUI && ! exporting()) {
+    displayPageTimer->start();
+  } else {
+    displayPage();
+  }
+}
+
+void Gui::deferredDisplayPage()
+{
+  if (macroNesting > 0 || exporting())
+    return;
+
   displayPage();
 }
 
@@ -83,9 +110,7 @@ void Gui::contentsChange(
 
   if (_charsRemoved && ldrawFile.contains(fileName)) {
 
-    QString contents = ldrawFile.contents(fileName).join("\n");
-
-    charsRemoved = contents.mid(position,_charsRemoved);
+    charsRemoved = ldrawFile.readContents(fileName,position,_charsRemoved);
   }
   
   undoStack->push(new ContentsChangeCommand(&ldrawFile,
@@ -100,7 +125,7 @@ void Gui::undo()
   macroNesting++;
   undoStack->undo();
   macroNesting--;
-  displayPage();
+  requestDisplayPage();
 }
 
 void Gui::redo()
@@ -108,7 +133,7 @@ void Gui::redo()
   macroNesting++;
   undoStack->redo();
   macroNesting--;
-  displayPage();
+  requestDisplayPage();
 }
 
 void Gui::canRedoChanged(bool enabled)
@@ -129,7 +154,7 @@ void Gui::normalizeHeader(const Where &here)
 {
   Where current = here;
 
-  int numLines = ldrawFile.size(current.modelName);
+  int numLines = ldrawFile.size(current);
   for ( ; current.lineNumber < numLines; current.lineNumber++) {
       QString line = gui->readLine(current);
       int p;
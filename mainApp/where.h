@@ -68,17 +68,23 @@ class Where
   public:
     QString modelName;
     int     lineNumber;
+    mutable int modelIndex; // LDrawFile model id hint, -1 if unresolved
+    mutable int modelStamp; // LDrawFile model id stamp the hint belongs to
 
     Where()
     {
       modelName     = "undefined";
       lineNumber    = 0;
+      modelIndex    = -1;
+      modelStamp    = 0;
     }
 
     Where(const Where &rhs)
     {
       modelName = rhs.modelName;
       lineNumber  = rhs.lineNumber;
+      modelIndex  = rhs.modelIndex;
+      modelStamp  = rhs.modelStamp;
     }
 
     Where operator=(const Where &rhs)
@@ -86,6 +92,8 @@ class Where
       if (this != &rhs) {
         modelName = rhs.modelName;
         lineNumber = rhs.lineNumber;
+        modelIndex = rhs.modelIndex;
+        modelStamp = rhs.modelStamp;
       }
       return *this;
     }
@@ -96,11 +104,15 @@ class Where
     {
       modelName     = _modelName;
       lineNumber    = _lineNumber;
+      modelIndex    = -1;
+      modelStamp    = 0;
     }
 
     Where(int _lineNumber)
     {
       lineNumber = _lineNumber;
+      modelIndex = -1;
+      modelStamp = 0;
     }
 
     const Where operator+(const int &where) const
@@ -25,10 +25,10 @@
 
 #include "QsLog.h"
 #include "QsLogDest.h"
-#ifdef QS_LOG_SEPARATE_THREAD
-#include <QThreadPool>
-#include <QRunnable>
-#endif
+#include <QAtomicInt>
+#include <QAtomicPointer>
+#include <QSemaphore>
+#include <QThread>
 #include <QMutex>
 #include <QVector>
 #include <QDateTime>
@@ -107,27 +107,37 @@ namespace QsLogging
       }
   }
 
-#ifdef QS_LOG_SEPARATE_THREAD
-  class LogWriterRunnable : public QRunnable
+  //! a formatted message waiting for the writer thread
+  struct LogEntry
+  {
+    QString colourMessage;
+    QString plainMessage;
+    Level level;
+    QAtomicPointer<LogEntry> next;
+  };
+
+  //! writes queued messages to the destinations
+  class LogWriterThread : public QThread
   {
   public:
-    LogWriterRunnable(QString message, Level level);
+    explicit LogWriterThread(LoggerImpl* impl) : mImpl(impl) {}
+
+  protected:
     virtual void run();
 
   private:
-    QString mMessage;
-    Level mLevel;
+    LoggerImpl* mImpl;
   };
-#endif
 
   class LoggerImpl
   {
   public:
     LoggerImpl();
 
-#ifdef QS_LOG_SEPARATE_THREAD
-    QThreadPool threadPool;
-#endif
+    void push(LogEntry* entry);
+    LogEntry* pop();
+    int writeQueue();
+
     QMutex logMutex;
     Level level;
     DestinationList destList;
@@ -149,21 +159,91 @@ namespace QsLogging
     bool statusLevel;
     bool errorLevel;
     bool fatalLevel;
+
+    // logMessage() options
+    QAtomicInt messageLevel;
+    bool messageIncludeLogLevel;
+
+    // Messages are queued on an intrusive multiple producer, single consumer
+    // list. Producers swap themselves in at queueHead without locking; only
+    // the writer thread follows queueTail. queuePending counts messages
+    // pushed and not yet written and wakes the writer when it leaves zero.
+    LogEntry queueStub;
+    QAtomicPointer<LogEntry> queueHead;
+    LogEntry* queueTail;
+    QAtomicInt queuePending;
+    QSemaphore queueSignal;
+    QAtomicInt writerStop;
+    QAtomicInt asynchronous;
+    LogWriterThread* writer;
+    QMutex writerMutex;
   };
 
-#ifdef QS_LOG_SEPARATE_THREAD
-  LogWriterRunnable::LogWriterRunnable(QString message, Level level)
-    : QRunnable()
-    , mMessage(message)
-    , mLevel(level)
+  void LoggerImpl::push(LogEntry* entry)
   {
+    entry->next.store(0);
+    LogEntry* previous = queueHead.fetchAndStoreOrdered(entry);
+    previous->next.storeRelease(entry);
   }
 
-  void LogWriterRunnable::run()
+  //! returns the oldest queued entry, or 0 if the queue is empty or the
+  //! next entry is still being pushed. Called from one thread at a time.
+  LogEntry* LoggerImpl::pop()
   {
-    Logger::instance().write(mMessage, mLevel);
+    LogEntry* tail = queueTail;
+    LogEntry* next = tail->next.loadAcquire();
+    if (tail == &queueStub) {
+        if (!next)
+          return 0;
+        queueTail = next;
+        tail = next;
+        next = next->next.loadAcquire();
+      }
+    if (next) {
+        queueTail = next;
+        return tail;
+      }
+    if (tail != queueHead.loadAcquire())
+      return 0;
+    push(&queueStub);
+    next = tail->next.loadAcquire();
+    if (next) {
+        queueTail = next;
+        return tail;
+      }
+    return 0;
+  }
+
+  //! writes and frees every entry that can be popped, returns the count
+  int LoggerImpl::writeQueue()
+  {
+    int written = 0;
+    while (LogEntry* entry = pop()) {
+        Logger::instance().write(entry->colourMessage, entry->plainMessage, entry->level);
+        delete entry;
+        written++;
+      }
+    return written;
+  }
+
+  void LogWriterThread::run()
+  {
+    forever {
+        mImpl->queueSignal.acquire();
+        // a pushed entry can be counted before its link is visible, so keep
+        // going until every counted message has been written
+        int written;
+        while (true) {
+            written = mImpl->writeQueue();
+            if (mImpl->queuePending.fetchAndAddOrdered(-written) == written)
+              break;
+            if (!written)
+              QThread::yieldCurrentThread();
+          }
+        if (mImpl->writerStop.loadAcquire())
+          break;
+      }
   }
-#endif
 
 
   LoggerImpl::LoggerImpl()
@@ -185,19 +265,25 @@ namespace QsLogging
     , statusLevel(         false)
     , errorLevel(          false)
     , fatalLevel(          false)
+
+    , messageLevel(        OffLevel)
+    , messageIncludeLogLevel(true)
+
+    , queueHead(           &queueStub)
+    , queueTail(           &queueStub)
+    , writer(              0)
   {
     // assume at least file + console
     destList.reserve(2);
-#ifdef QS_LOG_SEPARATE_THREAD
-    threadPool.setMaxThreadCount(1);
-    threadPool.setExpiryTimeout(-1);
-#endif
   }
 
 
   Logger::Logger()
     : d(new LoggerImpl)
   {
+#ifdef QS_LOG_SEPARATE_THREAD
+    setAsynchronous(true);
+#endif
   }
 
   Logger& Logger::instance()
@@ -268,9 +354,7 @@ namespace QsLogging
 
   Logger::~Logger()
   {
-#ifdef QS_LOG_SEPARATE_THREAD
-    d->threadPool.waitForDone();
-#endif
+    setAsynchronous(false);
     delete d;
     d = 0;
   }
@@ -451,6 +535,57 @@ namespace QsLogging
     d->fatalLevel = l;
   }
 
+  void Logger::setMessageLevel(Level newLevel)
+  {
+    d->messageLevel.storeRelease(newLevel);
+  }
+
+  bool Logger::messageLevel(Level thisLevel) const
+  {
+    return d->messageLevel.loadAcquire() <= thisLevel;
+  }
+
+  void Logger::setMessageIncludeLogLevel(bool l)
+  {
+    d->messageIncludeLogLevel = l;
+  }
+
+  bool Logger::messageIncludeLogLevel() const
+  {
+    return d->messageIncludeLogLevel;
+  }
+
+  //! Starting or stopping the writer is not synchronised with logging
+  //! calls, so do it while no other thread is logging.
+  void Logger::setAsynchronous(bool a)
+  {
+    QMutexLocker lock(&d->writerMutex);
+    if (a == (d->writer != 0))
+      return;
+
+    if (a) {
+        d->writerStop.storeRelease(0);
+        d->writer = new LogWriterThread(d);
+        d->writer->start(QThread::LowPriority);
+        d->asynchronous.storeRelease(1);
+      } else {
+        d->asynchronous.storeRelease(0);
+        d->writerStop.storeRelease(1);
+        d->queueSignal.release();
+        d->writer->wait();
+        delete d->writer;
+        d->writer = 0;
+        // write what was queued after the writer stopped
+        d->queuePending.fetchAndAddOrdered(-d->writeQueue());
+        d->queueSignal.tryAcquire(d->queueSignal.available());
+      }
+  }
+
+  bool Logger::asynchronous() const
+  {
+    return d->asynchronous.loadAcquire() != 0;
+  }
+
   //! creates the complete log message and passes it to the logger
   void Logger::Helper::writeToLog()
   {
@@ -493,13 +628,20 @@ namespace QsLogging
 //                                       logger.loggingLevel() == OffLevel    ? "OffLevel"    :
 //                                                                            "No Valid Level");
 
-    if (logger.includeLogLevel()) {
+    // logMessage() writes the log level and timestamp only
+    const bool includeLogLevel     = message ? logger.messageIncludeLogLevel() : logger.includeLogLevel();
+    const bool includeFileName     = message ? false : logger.includeFileName();
+    const bool includeFunctionInfo = message ? false : logger.includeFunctionInfo();
+    const bool includeLineNumber   = message ? false : logger.includeLineNumber();
+    const bool includeTimestamp    = message ? true  : logger.includeTimestamp();
+
+    if (includeLogLevel) {
         completePlainMessage.
             append(levelName).
             append(' ');
       }
 
-    if (logger.includeFileName()) {
+    if (includeFileName) {
         completePlainMessage.
             append(fileName).
             append(' ');
@@ -507,7 +649,7 @@ namespace QsLogging
 
     completeColorizedMessage.append(logger.colorizeOutput() ?  ColorizeLogOutput(level,completePlainMessage) : completePlainMessage);
 
-    if (logger.includeFunctionInfo()) {
+    if (includeFunctionInfo) {
         completePlainMessage.
             append(functionInfo).
             append(' ');
@@ -522,7 +664,7 @@ namespace QsLogging
           }
       }
 
-    if (logger.includeLineNumber()) {
+    if (includeLineNumber) {
         lineNumber.prepend("@ln ");
         completePlainMessage.
             append(lineNumber).
@@ -532,7 +674,7 @@ namespace QsLogging
             append(' ');
       }
 
-    if (logger.includeTimestamp()) {
+    if (includeTimestamp) {
         completeColorizedMessage.
             append(QDateTime::currentDateTime().toString(fmtDateTime)).
             append(' ');
@@ -564,12 +706,17 @@ namespace QsLogging
   //! directs the message to the task queue or writes it directly
   void Logger::enqueueWrite(const QString& colourMessage, const QString& plainMessage, Level level)
   {
-#ifdef QS_LOG_SEPARATE_THREAD
-    LogWriterRunnable *r = new LogWriterRunnable(message, level);
-    d->threadPool.start(r);
-#else
+    if (d->asynchronous.loadAcquire()) {
+        LogEntry* entry = new LogEntry;
+        entry->colourMessage = colourMessage;
+        entry->plainMessage  = plainMessage;
+        entry->level         = level;
+        d->push(entry);
+        if (d->queuePending.fetchAndAddOrdered(1) == 0)
+          d->queueSignal.release();
+        return;
+      }
     write(colourMessage, plainMessage, level);
-#endif
   }
 
   //! Sends the message to all the destinations. The level for this message is passed in case
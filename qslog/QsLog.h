@@ -123,14 +123,27 @@ public:
   void setErrorLevel(bool l);
   //! Set to true to enable Fatal log level
   void setFatalLevel(bool l);
+  //! logMessage() at a level < 'newLevel' will be ignored. The default level is OFF
+  void setMessageLevel(Level newLevel);
+  //! Returns true if logMessage() is enabled at this level
+  bool messageLevel(Level thisLevel) const;
+  //! Set to false to disable log level inclusion in logMessage() messages
+  void setMessageIncludeLogLevel(bool l);
+  //! Default value is true.
+  bool messageIncludeLogLevel() const;
+  //! Set to true to queue messages and write them from a background thread
+  void setAsynchronous(bool a);
+  //! Default value is false.
+  bool asynchronous() const;
 
   //! The helper forwards the streaming to QDebug and builds the final
   //! log message.
   class QSLOG_SHARED_OBJECT Helper
   {
   public:
-    explicit Helper(Level logLevel) :
+    explicit Helper(Level logLevel, bool messageFormat = false) :
       level(logLevel),
+      message(messageFormat),
       qtDebug(&buffer) {}
     ~Helper();
     QDebug& stream(){ return qtDebug; }
@@ -140,6 +153,7 @@ public:
     void writeToLog();
 
     Level level;
+    bool message;
     QString buffer;
     QDebug qtDebug;
   };
@@ -154,7 +168,8 @@ private:
 
   LoggerImpl* d;
 
-  friend class LogWriterRunnable;
+  friend class LoggerImpl;
+  friend class LogWriterThread;
 };
 
 } // end namespace
@@ -189,6 +204,12 @@ private:
    if( QsLogging::Logger::instance().loggingLevel(QsLogging::FatalLevel) ) \
      QsLogging::Logger::Helper(QsLogging::FatalLevel).stream() \
      << __FILE__ << '|' << Q_FUNC_INFO << '|' << __LINE__ << QS_LOG_SPLIT
+//! logMessage() is gated by the message level and writes the log level and
+//! timestamp only, whatever the options set for the other macros.
+#define logMessage(level) \
+   if( QsLogging::Logger::instance().messageLevel(level) ) \
+     QsLogging::Logger::Helper(level, true).stream() \
+     << __FILE__ << '|' << Q_FUNC_INFO << '|' << __LINE__ << QS_LOG_SPLIT
 
 /*
 #define logTrace() \
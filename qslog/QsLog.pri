@@ -1,7 +1,7 @@
 INCLUDEPATH += $$PWD
 
 #Log output options
-#DEFINES += QS_LOG_SEPARATE_THREAD # messages are queued and written from a separate thread
+#DEFINES += QS_LOG_SEPARATE_THREAD # messages are queued and written from a separate thread, see Logger::setAsynchronous()
 #DEFINES += QS_LOG_DISABLE         # logging code is replaced with a no-op
 
 SOURCES += \
@@ -12,6 +12,7 @@
 #undef logStatus
 #undef logError
 #undef logFatal
+#undef logMessage
 
 #define logTrace() if (1) {} else qDebug()
 #define logNotice() if (1) {} else qDebug()
@@ -20,5 +21,6 @@
 #define logStatus()  if (1) {} else qDebug()
 #define logError() if (1) {} else qDebug()
 #define logFatal() if (1) {} else qDebug()
+#define logMessage(level) if (1) {} else qDebug()
 
 #endif // QSLOGDISABLEFORTHISFILE_H